@@ -0,0 +1,335 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2019-2024 Heal Research
+
+// Benchmarks of the vstat entry points over a range of input sizes, from L1-resident to DRAM-resident data.
+//
+// usage: vstat_bench [--min-size N] [--max-size N] [--filter TEXT] [--json FILE] [--csv FILE] [--file PATH] [--file-size N]
+//
+// The sizes are powers of four (number of elements per input sequence) between --min-size and --max-size. The
+// benchmarks whose name does not contain the --filter text are skipped. A summary with the throughput in
+// elements/s and GB/s is written to stdout and the raw nanobench results can be saved as JSON and CSV, e.g.
+// to track regressions. The benchmark names have the form "entry point;value type;size".
+//
+// The "file:" benchmarks compare reading a flat binary file of --file-size doubles into a vector before the
+// accumulation with accumulating its memory mapping directly. The file is generated at --file (by default in the
+// temporary directory) and removed afterwards. It is in the page cache after being written, so unless the cache
+// is dropped in between, the benchmarks measure the cost of copying or mapping the cached pages, not of the disk.
+// --file-size 0 skips them.
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "nanobench.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "vstat/mapped.hpp"
+#include "vstat/vstat.hpp"
+
+namespace nb = ankerl::nanobench;
+
+namespace uv = vstat::univariate;
+namespace bv = vstat::bivariate;
+namespace gr = vstat::grouped;
+namespace mt = vstat::metrics;
+
+namespace {
+struct options {
+    std::size_t min_size{ 1UL << 10U };
+    std::size_t max_size{ 1UL << 22U };
+    std::string filter;
+    std::string json;
+    std::string csv;
+    std::string file;
+    std::size_t file_size{ 1UL << 24U };
+};
+
+auto parse(int argc, char** argv) -> options
+{
+    options opt;
+    auto usage = [&]() {
+        std::cerr << "usage: " << argv[0] << " [--min-size N] [--max-size N] [--filter TEXT] [--json FILE] [--csv FILE] [--file PATH] [--file-size N]\n";
+        std::exit(EXIT_FAILURE); // NOLINT
+    };
+    for (auto i = 1; i < argc; ++i) {
+        std::string_view const arg{ argv[i] }; // NOLINT
+        if (i + 1 == argc) {
+            usage();
+        }
+        std::string const value{ argv[++i] }; // NOLINT
+        if (arg == "--min-size") {
+            opt.min_size = std::stoul(value);
+        } else if (arg == "--max-size") {
+            opt.max_size = std::stoul(value);
+        } else if (arg == "--filter") {
+            opt.filter = value;
+        } else if (arg == "--json") {
+            opt.json = value;
+        } else if (arg == "--csv") {
+            opt.csv = value;
+        } else if (arg == "--file") {
+            opt.file = value;
+        } else if (arg == "--file-size") {
+            opt.file_size = std::stoul(value);
+        } else {
+            usage();
+        }
+    }
+    if (opt.min_size == 0 || opt.min_size > opt.max_size) {
+        usage();
+    }
+    return opt;
+}
+
+template<std::floating_point T>
+auto generate(auto& rng, std::size_t count, T min = T{0}, T max = T{1})
+{
+    std::vector<T> vec(count);
+    std::uniform_real_distribution<T> dist(min, max);
+    std::generate(vec.begin(), vec.end(), [&]() { return dist(rng); });
+    return vec;
+}
+
+// the input data (generated once for the largest size, the smaller sizes use a prefix)
+template<std::floating_point T>
+struct dataset {
+    std::vector<T> x;
+    std::vector<T> y;
+    std::vector<T> w;
+    std::vector<std::int64_t> keys;
+
+    dataset(auto& rng, std::size_t n)
+        : x{ generate<T>(rng, n, T{1}, T{2}) } // positive values, as required by some metrics
+        , y{ generate<T>(rng, n, T{1}, T{2}) }
+        , w{ generate<T>(rng, n) }
+        , keys(n)
+    {
+        std::uniform_int_distribution<std::int64_t> dist(0, groups - 1);
+        std::generate(keys.begin(), keys.end(), [&]() { return dist(rng); });
+    }
+
+    static auto constexpr groups{ 1000 };
+};
+
+class runner {
+public:
+    explicit runner(options opt) : opt_{std::move(opt)}
+    {
+        bench_.unit("element").warmup(1).relative(false);
+    }
+
+    // runs a benchmark processing `n` elements per iteration, each element reading `bytes` bytes of input
+    template<typename F>
+    void operator()(std::string const& name, std::size_t n, std::size_t bytes, F&& func)
+    {
+        if (!opt_.filter.empty() && name.find(opt_.filter) == std::string::npos) {
+            return;
+        }
+        // limit the number of iterations for the large sizes
+        bench_.minEpochIterations(std::max<std::uint64_t>(1, (1U << 20U) / n));
+        bench_.batch(n).run(name + ";" + std::to_string(n), std::forward<F>(func));
+        // the median time of one iteration (over the whole batch of n elements)
+        auto const seconds = bench_.results().back().median(nb::Result::Measure::elapsed);
+        auto const elements = static_cast<double>(n) / seconds;
+        summary_.push_back({ name, n, elements, elements * static_cast<double>(bytes) / 1e9 });
+    }
+
+    void report()
+    {
+        std::cout << "\n" << std::left << std::setw(56) << "benchmark" << std::right << std::setw(12) << "size"
+                  << std::setw(16) << "elements/s" << std::setw(12) << "GB/s" << "\n";
+        for (auto const& [name, size, elements, gigabytes] : summary_) {
+            std::cout << std::left << std::setw(56) << name << std::right << std::setw(12) << size
+                      << std::setw(16) << std::setprecision(4) << std::scientific << elements
+                      << std::setw(12) << std::fixed << std::setprecision(2) << gigabytes << "\n";
+        }
+        if (!opt_.json.empty()) {
+            std::ofstream out(opt_.json);
+            bench_.render(nb::templates::json(), out);
+        }
+        if (!opt_.csv.empty()) {
+            std::ofstream out(opt_.csv);
+            bench_.render(nb::templates::csv(), out);
+        }
+    }
+
+private:
+    struct entry {
+        std::string name;
+        std::size_t size;
+        double elements_per_second;
+        double gigabytes_per_second;
+    };
+
+    options opt_;
+    nb::Bench bench_;
+    std::vector<entry> summary_;
+};
+
+template<std::floating_point T>
+void run_all(runner& run, dataset<T> const& data, std::size_t n, std::string const& type, double& sink)
+{
+    auto const* x = data.x.data();
+    auto const* y = data.y.data();
+    auto const* w = data.w.data();
+    auto const* k = data.keys.data();
+    auto constexpr s{ sizeof(T) };
+    auto name = [&](std::string const& entry) { return entry + ";" + type; };
+
+    // univariate
+    run(name("univariate::accumulate"), n, s, [&]() { sink += uv::accumulate<T>(x, x + n).variance; });
+    run(name("univariate::accumulate (weighted)"), n, 2 * s, [&]() { sink += uv::accumulate<T>(x, x + n, w).variance; });
+    run(name("univariate::accumulate_blocked"), n, s, [&]() { sink += uv::accumulate_blocked<T>(x, x + n).variance; });
+    run(name("univariate::accumulate (parallel)"), n, s, [&]() { sink += uv::accumulate<T>(vstat::parallel_policy{}, x, x + n).variance; });
+    run(name("univariate::accumulate (skip_nan)"), n, s, [&]() { sink += uv::accumulate<T>(vstat::skip_nan, x, x + n).variance; });
+    run(name("univariate::accumulate (with_extrema)"), n, s, [&]() { sink += uv::accumulate<T>(vstat::with_extrema, x, x + n).max; });
+    run(name("univariate::accumulate_moments"), n, s, [&]() { sink += uv::accumulate_moments<T>(x, x + n).kurtosis; });
+    run(name("univariate::update (compensated)"), n, s, [&]() {
+        vstat::univariate_accumulator<eve::wide<T>, vstat::compensated_summation> acc;
+        uv::update(acc, x, x + n); // the remainder of n / lanes values is left out
+        sink += std::get<2>(acc.stats());
+    });
+    run(name("univariate::accumulate (histogram)"), n, s, [&]() {
+        vstat::histogram_accumulator<T> hist(vstat::histogram_bins::uniform(1, 2, 64)); // NOLINT
+        sink += uv::accumulate<T>(hist, x, x + n).variance;
+    });
+    run(name("univariate::accumulate (quantile sketch)"), n, s, [&]() {
+        vstat::quantile_sketch<T> sketch;
+        sink += uv::accumulate<T>(sketch, x, x + n).variance + sketch.quantile(0.5); // NOLINT
+    });
+    run(name("univariate::update (ewma)"), n, s, [&]() {
+        vstat::ewma_accumulator<T> acc(0.05); // NOLINT
+        uv::update(acc, x, x + n);
+        sink += acc.variance();
+    });
+    run(name("grouped::accumulate"), n, s + sizeof(std::int64_t), [&]() {
+        sink += gr::accumulate<T>(x, x + n, k, dataset<T>::groups).sum_xx.front();
+    });
+
+    // bivariate
+    run(name("bivariate::accumulate"), n, 2 * s, [&]() { sink += bv::accumulate<T>(x, x + n, y).covariance; });
+    run(name("bivariate::accumulate (weighted)"), n, 3 * s, [&]() { sink += bv::accumulate<T>(x, x + n, y, w).covariance; });
+    run(name("bivariate::accumulate_blocked"), n, 2 * s, [&]() { sink += bv::accumulate_blocked<T>(x, x + n, y).covariance; });
+    run(name("bivariate::accumulate (parallel)"), n, 2 * s, [&]() { sink += bv::accumulate<T>(vstat::parallel_policy{}, x, x + n, y).covariance; });
+
+    // multivariate (x viewed as a row-major matrix with `cols` columns)
+    auto constexpr cols{ 8UL };
+    auto const rows{ n / cols };
+    auto const row_stride{ static_cast<std::ptrdiff_t>(cols) };
+    if (rows > 0) {
+        run(name("multivariate::accumulate"), rows * cols, s, [&]() {
+            sink += vstat::multivariate::accumulate<T>(x, rows, cols, row_stride).covariance.front();
+        });
+        run(name("multivariate::accumulate (weighted)"), rows * cols, s * (cols + 1) / cols, [&]() {
+            sink += vstat::multivariate::accumulate<T>(x, w, rows, cols, row_stride).covariance.front();
+        });
+    }
+
+    // rolling windows
+    auto constexpr window{ 64UL };
+    std::vector<double> out1(n);
+    std::vector<double> out2(n);
+    run(name("univariate::rolling"), n, s, [&]() {
+        uv::rolling<T>(x, x + n, window, out1.begin(), out2.begin());
+        sink += out2.back();
+    });
+    run(name("bivariate::rolling"), n, 2 * s, [&]() {
+        bv::rolling<T>(x, x + n, y, window, out1.begin(), out2.begin());
+        sink += out2.back();
+    });
+
+    // metrics
+    run(name("metrics::r2_score"), n, 2 * s, [&]() { sink += mt::r2_score<T>(x, x + n, y); });
+    run(name("metrics::mean_squared_error"), n, 2 * s, [&]() { sink += mt::mean_squared_error<T>(x, x + n, y); });
+    run(name("metrics::mean_squared_log_error"), n, 2 * s, [&]() { sink += mt::mean_squared_log_error<T>(x, x + n, y); });
+    run(name("metrics::mean_absolute_error"), n, 2 * s, [&]() { sink += mt::mean_absolute_error<T>(x, x + n, y); });
+    run(name("metrics::mean_absolute_percentage_error"), n, 2 * s, [&]() { sink += mt::mean_absolute_percentage_error<T>(x, x + n, y); });
+    run(name("metrics::poisson_neg_likelihood_loss"), n, 2 * s, [&]() { sink += mt::poisson_neg_likelihood_loss<T>(x, x + n, y); });
+    run(name("metrics::evaluate (r2, mse, mae, mape, poisson)"), n, 2 * s, [&]() {
+        sink += mt::evaluate<T, mt::r2, mt::mse, mt::mae, mt::mape, mt::poisson>(x, x + n, y).front();
+    });
+
+    // weighted metrics
+    run(name("metrics::r2_score (weighted)"), n, 3 * s, [&]() { sink += mt::r2_score<T>(x, x + n, y, w); });
+    run(name("metrics::mean_squared_error (weighted)"), n, 3 * s, [&]() { sink += mt::mean_squared_error<T>(x, x + n, y, w); });
+    run(name("metrics::mean_squared_log_error (weighted)"), n, 3 * s, [&]() { sink += mt::mean_squared_log_error<T>(x, x + n, y, w); });
+    run(name("metrics::mean_absolute_error (weighted)"), n, 3 * s, [&]() { sink += mt::mean_absolute_error<T>(x, x + n, y, w); });
+    run(name("metrics::mean_absolute_percentage_error (weighted)"), n, 3 * s, [&]() { sink += mt::mean_absolute_percentage_error<T>(x, x + n, y, w); });
+    run(name("metrics::poisson_neg_likelihood_loss (weighted)"), n, 3 * s, [&]() { sink += mt::poisson_neg_likelihood_loss<T>(x, x + n, y, w); });
+    run(name("metrics::evaluate (r2, mse, mae, mape, poisson) (weighted)"), n, 3 * s, [&]() {
+        sink += mt::evaluate<T, mt::r2, mt::mse, mt::mae, mt::mape, mt::poisson>(x, x + n, y, w).front();
+    });
+}
+
+// writes `n` doubles to `path` in blocks, so the file may be larger than the memory
+void write_file(auto& rng, std::filesystem::path const& path, std::size_t n)
+{
+    std::ofstream out(path, std::ios::binary);
+    for (auto i = std::size_t{0}; i < n;) {
+        auto const block = generate<double>(rng, std::min(n - i, std::size_t{1} << 20U));
+        out.write(reinterpret_cast<char const*>(block.data()), static_cast<std::streamsize>(block.size() * sizeof(double))); // NOLINT
+        i += block.size();
+    }
+}
+
+void run_file(runner& run, std::filesystem::path const& path, std::size_t n, double& sink)
+{
+    auto constexpr s{ sizeof(double) };
+    std::vector<double> buffer(n);
+    run("file: read + univariate::accumulate;double", n, s, [&]() {
+        std::ifstream in(path, std::ios::binary);
+        in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(n * s)); // NOLINT
+        sink += uv::accumulate<double>(buffer.begin(), buffer.end()).variance;
+    });
+    run("file: read + univariate::accumulate (parallel);double", n, s, [&]() {
+        std::ifstream in(path, std::ios::binary);
+        in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(n * s)); // NOLINT
+        sink += uv::accumulate<double>(vstat::parallel_policy{}, buffer.begin(), buffer.end()).variance;
+    });
+    run("file: mapped univariate::accumulate;double", n, s, [&]() {
+        vstat::mapped_file const file(path);
+        auto const x = file.values<double>();
+        sink += uv::accumulate<double>(x.begin(), x.end()).variance;
+    });
+    run("file: mapped univariate::accumulate (parallel);double", n, s, [&]() {
+        vstat::mapped_file const file(path);
+        auto const x = file.values<double>();
+        sink += uv::accumulate<double>(vstat::parallel_policy{}, x.begin(), x.end()).variance;
+    });
+}
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    auto const opt = parse(argc, argv);
+    std::default_random_engine rng{1234}; // NOLINT
+
+    dataset<double> const dd(rng, opt.max_size);
+    dataset<float> const df(rng, opt.max_size);
+
+    runner run(opt);
+    double sink{0};
+    for (auto n = opt.min_size; n <= opt.max_size; n *= 4) {
+        run_all(run, dd, n, "double", sink);
+        run_all(run, df, n, "float", sink);
+    }
+    if (opt.file_size > 0) {
+        auto const path = opt.file.empty() ? std::filesystem::temp_directory_path() / "vstat_bench.f64" : std::filesystem::path(opt.file);
+        write_file(rng, path, opt.file_size);
+        run_file(run, path, opt.file_size, sink);
+        std::filesystem::remove(path);
+    }
+    nb::doNotOptimizeAway(sink);
+    run.report();
+    return EXIT_SUCCESS;
+}
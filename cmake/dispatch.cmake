@@ -0,0 +1,59 @@
+# ---- Runtime instruction set dispatch ----
+
+# The dispatcher (vstat::dispatch) contains the kernels compiled for the
+# baseline of the build. On x86-64 the kernels are also compiled for the
+# micro-architecture levels below, each into a module of its own (the width of
+# the EVE SIMD types differs between them, so they cannot share a binary). The
+# best module supported by the CPU is loaded at runtime.
+include(GNUInstallDirs)
+
+set(VSTAT_KERNELS_DIR "${PROJECT_BINARY_DIR}/kernels")
+
+add_library(vstat_dispatch STATIC
+    src/dispatch/dispatch.cpp
+    src/dispatch/kernels.cpp
+)
+add_library(vstat::dispatch ALIAS vstat_dispatch)
+set_property(TARGET vstat_dispatch PROPERTY EXPORT_NAME dispatch)
+set_property(TARGET vstat_dispatch PROPERTY POSITION_INDEPENDENT_CODE ON)
+target_link_libraries(vstat_dispatch PUBLIC vstat::vstat PRIVATE ${CMAKE_DL_LIBS})
+target_compile_features(vstat_dispatch PUBLIC cxx_std_20)
+target_compile_definitions(vstat_dispatch PRIVATE
+    VSTAT_KERNELS_BUILD_DIR="${VSTAT_KERNELS_DIR}"
+    VSTAT_KERNELS_INSTALL_DIR="${CMAKE_INSTALL_FULL_LIBDIR}/vstat"
+    VSTAT_KERNELS_MODULE_SUFFIX="${CMAKE_SHARED_MODULE_SUFFIX}"
+)
+
+set(VSTAT_KERNEL_MODULES "")
+if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64)$")
+    if(MSVC)
+        set(VSTAT_KERNELS_FLAGS_sse4_2 "")
+        set(VSTAT_KERNELS_FLAGS_avx2 "/arch:AVX2")
+        set(VSTAT_KERNELS_FLAGS_avx512 "/arch:AVX512")
+    else()
+        set(VSTAT_KERNELS_FLAGS_sse4_2 "-march=x86-64-v2")
+        set(VSTAT_KERNELS_FLAGS_avx2 "-march=x86-64-v3")
+        set(VSTAT_KERNELS_FLAGS_avx512 "-march=x86-64-v4")
+    endif()
+
+    foreach(isa IN ITEMS sse4_2 avx2 avx512)
+        set(module vstat_kernels_${isa})
+        add_library(${module} MODULE src/dispatch/kernels.cpp)
+        target_link_libraries(${module} PRIVATE vstat::vstat)
+        target_compile_features(${module} PRIVATE cxx_std_20)
+        target_compile_definitions(${module} PRIVATE VSTAT_KERNELS_MODULE)
+        target_compile_options(${module} PRIVATE ${VSTAT_KERNELS_FLAGS_${isa}})
+        if(NOT MSVC)
+            target_compile_options(${module} PRIVATE "$<$<CONFIG:Release>:-fno-math-errno>")
+        endif()
+        # only the kernel table is exported, the inline functions of each module stay private to it
+        set_target_properties(${module} PROPERTIES
+            PREFIX ""
+            CXX_VISIBILITY_PRESET hidden
+            VISIBILITY_INLINES_HIDDEN ON
+            LIBRARY_OUTPUT_DIRECTORY "${VSTAT_KERNELS_DIR}"
+        )
+        add_dependencies(vstat_dispatch ${module})
+        list(APPEND VSTAT_KERNEL_MODULES ${module})
+    endforeach()
+endif()
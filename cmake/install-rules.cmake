@@ -23,6 +23,33 @@ install(
     INCLUDES DESTINATION "${CMAKE_INSTALL_INCLUDEDIR}"
 )
 
+if(vstat_BUILD_KERNELS)
+    install(
+        TARGETS vstat_kernels
+        EXPORT vstatTargets
+        ARCHIVE DESTINATION "${CMAKE_INSTALL_LIBDIR}"
+    )
+endif()
+
+if(vstat_BUILD_DISPATCH)
+    install(
+        TARGETS vstat_dispatch
+        EXPORT vstatTargets
+        ARCHIVE DESTINATION "${CMAKE_INSTALL_LIBDIR}"
+    )
+    install(
+        TARGETS ${VSTAT_KERNEL_MODULES}
+        LIBRARY DESTINATION "${CMAKE_INSTALL_LIBDIR}/vstat"
+    )
+endif()
+
+if(vstat_BUILD_TOOLS)
+    install(
+        TARGETS vstat_csv
+        RUNTIME DESTINATION "${CMAKE_INSTALL_BINDIR}"
+    )
+endif()
+
 if (vstat_BUILD_PYTHON AND Python_FOUND AND nanobind_FOUND)
     execute_process(
         COMMAND "${Python_EXECUTABLE}" -c "import sysconfig as sc; print(sc.get_path('platlib', 'posix_user', {'userbase': ''})[1:])"
@@ -32,6 +59,13 @@ if (vstat_BUILD_PYTHON AND Python_FOUND AND nanobind_FOUND)
         EXPORT vstatTargets
         LIBRARY DESTINATION "${VSTAT_PYTHON_SITELIB}/${package}"
     )
+    # the dispatcher looks for the kernel modules next to the python module
+    if(vstat_BUILD_DISPATCH)
+        install(
+            TARGETS ${VSTAT_KERNEL_MODULES}
+            LIBRARY DESTINATION "${VSTAT_PYTHON_SITELIB}/${package}"
+        )
+    endif()
 endif()
 
 write_basic_package_version_file(
@@ -5,18 +5,23 @@
 #define VSTAT_BIVARIATE_HPP
 
 #include "combine.hpp"
+#include "statistics.hpp"
+#include "summation.hpp"
 
 namespace VSTAT_NAMESPACE {
 /*!
     \brief Bivariate accumulator object
+
+    \tparam T The value type (a scalar type or an `eve::wide` SIMD type)
+    \tparam S The summation policy (`plain_summation` or `compensated_summation`)
 */
-template <typename T>
+template <typename T, typename S = plain_summation>
 struct bivariate_accumulator {
-    static auto load_state(T sx, T sy, T sw, T sxx, T syy, T sxy) noexcept -> bivariate_accumulator<T> // NOLINT
+    static auto load_state(T sx, T sy, T sw, T sxx, T syy, T sxy) noexcept -> bivariate_accumulator<T, S> // NOLINT
     {
-        bivariate_accumulator<T> acc;
+        bivariate_accumulator<T, S> acc;
         acc.sum_w = sw;
-        acc.sum_w_old = sw;
+        acc.sum_w_old = detail::nonzero_weight(sw);
         acc.sum_x = sx;
         acc.sum_y = sy;
         acc.sum_xx = sxx;
@@ -25,7 +30,7 @@ struct bivariate_accumulator {
         return acc;
     }
 
-    static auto load_state(std::tuple<T, T, T, T, T, T> state) noexcept -> bivariate_accumulator<T>
+    static auto load_state(std::tuple<T, T, T, T, T, T> state) noexcept -> bivariate_accumulator<T, S>
     {
         auto [sx, sy, sw, sxx, syy, sxy] = state;
         return load_state(sx, sy, sw, sxx, syy, sxy);
@@ -36,15 +41,15 @@ struct bivariate_accumulator {
         T dx = x * sum_w - sum_x;
         T dy = y * sum_w - sum_y;
 
-        sum_w += 1;
+        detail::add(sum_w, err_w, T{1});
 
         T f = 1. / (sum_w * sum_w_old);
-        sum_xx += f * dx * dx;
-        sum_yy += f * dy * dy;
-        sum_xy += f * dx * dy;
+        detail::add(sum_xx, err_xx, f * dx * dx);
+        detail::add(sum_yy, err_yy, f * dy * dy);
+        detail::add(sum_xy, err_xy, f * dx * dy);
 
-        sum_x += x;
-        sum_y += y;
+        detail::add(sum_x, err_x, x);
+        detail::add(sum_y, err_y, y);
 
         sum_w_old = sum_w;
     }
@@ -54,18 +59,61 @@ struct bivariate_accumulator {
         T dx = x * sum_w - sum_x;
         T dy = y * sum_w - sum_y;
 
-        sum_x += x * w;
-        sum_y += y * w;
-        sum_w += w;
+        detail::add(sum_x, err_x, x * w);
+        detail::add(sum_y, err_y, y * w);
+        detail::add(sum_w, err_w, w);
 
         T f = w / (sum_w * sum_w_old);
-        sum_xx += f * dx * dx;
-        sum_yy += f * dy * dy;
-        sum_xy += f * dx * dy;
+        detail::add(sum_xx, err_xx, f * dx * dx);
+        detail::add(sum_yy, err_yy, f * dy * dy);
+        detail::add(sum_xy, err_xy, f * dx * dy);
 
         sum_w_old = sum_w;
     }
 
+    // masked updates: only the lanes selected by the mask are accumulated, the other lanes add zero weight
+    inline void operator()(T x, T y, eve::as_logical_t<T> mask) noexcept
+    requires eve::simd_value<T>
+    {
+        x = eve::if_else(mask, x, T{0});
+        y = eve::if_else(mask, y, T{0});
+        T dx = x * sum_w - sum_x;
+        T dy = y * sum_w - sum_y;
+
+        detail::add(sum_w, err_w, eve::if_else(mask, T{1}, T{0}));
+
+        T f = eve::if_else(mask, T{1} / (sum_w * sum_w_old), T{0});
+        detail::add(sum_xx, err_xx, f * dx * dx);
+        detail::add(sum_yy, err_yy, f * dy * dy);
+        detail::add(sum_xy, err_xy, f * dx * dy);
+
+        detail::add(sum_x, err_x, x);
+        detail::add(sum_y, err_y, y);
+
+        sum_w_old = detail::nonzero_weight(sum_w);
+    }
+
+    inline void operator()(T x, T y, T w, eve::as_logical_t<T> mask) noexcept // NOLINT
+    requires eve::simd_value<T>
+    {
+        w = eve::if_else(mask, w, T{0});
+        x = eve::if_else(mask, x, T{0});
+        y = eve::if_else(mask, y, T{0});
+        T dx = x * sum_w - sum_x;
+        T dy = y * sum_w - sum_y;
+
+        detail::add(sum_x, err_x, x * w);
+        detail::add(sum_y, err_y, y * w);
+        detail::add(sum_w, err_w, w);
+
+        T f = eve::if_else(mask, w / (sum_w * sum_w_old), T{0});
+        detail::add(sum_xx, err_xx, f * dx * dx);
+        detail::add(sum_yy, err_yy, f * dy * dy);
+        detail::add(sum_xy, err_xy, f * dx * dy);
+
+        sum_w_old = detail::nonzero_weight(sum_w);
+    }
+
     template <typename U>
     requires eve::simd_value<T> && eve::simd_compatible_ptr<U, T>
     inline void operator()(U const* x, U const* y) noexcept
@@ -80,10 +128,56 @@ struct bivariate_accumulator {
         (*this)(T{x}, T{y}, T{w});
     }
 
+    // merges the state of another accumulator into this one (Schubert et al., eq. 21-26).
+    // for SIMD types the merge is performed lane-wise, without any reduction.
+    inline auto merge(bivariate_accumulator<T, S> const& other) noexcept -> bivariate_accumulator<T, S>&
+    {
+        T const f = detail::combine_factor(sum_w, other.sum_w);
+        T const dx = other.sum_w * sum_x - sum_w * other.sum_x;
+        T const dy = other.sum_w * sum_y - sum_w * other.sum_y;
+
+        detail::add(sum_xx, err_xx, other.sum_xx + f * dx * dx, other.err_xx);
+        detail::add(sum_yy, err_yy, other.sum_yy + f * dy * dy, other.err_yy);
+        detail::add(sum_xy, err_xy, other.sum_xy + f * dx * dy, other.err_xy);
+
+        detail::add(sum_x, err_x, other.sum_x, other.err_x);
+        detail::add(sum_y, err_y, other.sum_y, other.err_y);
+        detail::add(sum_w, err_w, other.sum_w, other.err_w);
+        sum_w_old = detail::nonzero_weight(sum_w);
+        return *this;
+    }
+
+    inline auto operator+=(bivariate_accumulator<T, S> const& other) noexcept -> bivariate_accumulator<T, S>&
+    {
+        return merge(other);
+    }
+
+    // returns the raw (unreduced) state { sum_w, sum_x, sum_y, sum_xx, sum_yy, sum_xy }, with the error terms
+    // folded into the sums
+    [[nodiscard]] auto state() const noexcept -> std::tuple<T, T, T, T, T, T>
+    {
+        using detail::corrected;
+        return { corrected(sum_w, err_w), corrected(sum_x, err_x), corrected(sum_y, err_y),
+                 corrected(sum_xx, err_xx), corrected(sum_yy, err_yy), corrected(sum_xy, err_xy) };
+    }
+
     // performs a reduction on the vector types and returns the sums and the squared residuals sums
     auto stats() const noexcept -> std::tuple<double, double, double, double, double, double>
     {
-        if constexpr (std::is_floating_point_v<T>) {
+        if constexpr (detail::is_compensated<S>) {
+            // fold the error terms in double precision before reducing the lanes
+            auto const sw = detail::corrected_lanes(sum_w, err_w);
+            auto const sx = detail::corrected_lanes(sum_x, err_x);
+            auto const sy = detail::corrected_lanes(sum_y, err_y);
+            auto const sxx = detail::corrected_lanes(sum_xx, err_xx);
+            auto const syy = detail::corrected_lanes(sum_yy, err_yy);
+            auto const sxy = detail::corrected_lanes(sum_xy, err_xy);
+            bivariate_accumulator<double> acc;
+            for (std::size_t i = 0; i < sw.size(); ++i) {
+                acc += bivariate_accumulator<double>::load_state(sx[i], sy[i], sw[i], sxx[i], syy[i], sxy[i]);
+            }
+            return acc.stats();
+        } else if constexpr (std::is_floating_point_v<T>) {
             return { sum_w, sum_x, sum_y, sum_xx, sum_yy, sum_xy };
         } else {
             auto [sxx, syy, sxy] = combine(sum_w, sum_x, sum_y, sum_xx, sum_yy, sum_xy);
@@ -102,75 +196,14 @@ private:
     T sum_xx{0};
     T sum_yy{0};
     T sum_xy{0};
+    // rounding errors (compensated summation only)
+    [[no_unique_address]] detail::sum_error<T, S> err_w;
+    [[no_unique_address]] detail::sum_error<T, S> err_x;
+    [[no_unique_address]] detail::sum_error<T, S> err_y;
+    [[no_unique_address]] detail::sum_error<T, S> err_xx;
+    [[no_unique_address]] detail::sum_error<T, S> err_yy;
+    [[no_unique_address]] detail::sum_error<T, S> err_xy;
 };
-
-/*!
-    \brief Bivariate statistics
-*/
-struct bivariate_statistics {
-    double count;
-    double sum_x;
-    double sum_y;
-    double ssr_x;
-    double ssr_y;
-    double sum_xy;
-    double mean_x;
-    double mean_y;
-    double variance_x;
-    double variance_y;
-    double sample_variance_x;
-    double sample_variance_y;
-    double correlation;
-    double covariance;
-    double sample_covariance;
-
-    template <typename T>
-    explicit bivariate_statistics(T accumulator)
-    {
-        auto [sw, sx, sy, sxx, syy, sxy] = accumulator.stats();
-        count = sw;
-        sum_x = sx;
-        sum_y = sy;
-        ssr_x = sxx;
-        ssr_y = syy;
-        sum_xy = sxy;
-        mean_x = sx / sw;
-        mean_y = sy / sw;
-        variance_x = sxx / sw;
-        variance_y = syy / sw;
-        sample_variance_x = sxx / (sw - 1);
-        sample_variance_y = syy / (sw - 1);
-
-        if (!(sxx > 0 && syy > 0)) {
-            correlation = static_cast<double>(sxx == syy);
-        } else {
-            correlation = sxy / std::sqrt(sxx * syy);
-        }
-
-        covariance = sxy / sw;
-        sample_covariance = sxy / (sw - 1);
-    }
-};
-
-inline auto operator<<(std::ostream& os, bivariate_statistics const& stats) -> std::ostream&
-{
-    os << "count:              \t" << stats.count
-       << "\nsum_x:            \t" << stats.sum_x
-       << "\nssr_x:            \t" << stats.ssr_x
-       << "\nmean_x:           \t" << stats.mean_x
-       << "\nvariance_x:       \t" << stats.variance_x
-       << "\nsample variance_x:\t" << stats.sample_variance_x
-       << "\nsum_y:            \t" << stats.sum_y
-       << "\nssr_y:            \t" << stats.ssr_y
-       << "\nmean_y:           \t" << stats.mean_y
-       << "\nvariance_y:       \t" << stats.variance_y
-       << "\nsample variance_y:\t" << stats.sample_variance_y
-       << "\ncorrelation:      \t" << stats.correlation
-       << "\ncovariance:       \t" << stats.covariance
-       << "\nsample covariance:\t" << stats.sample_covariance
-       << "\n";
-    return os;
-}
 } // namespace VSTAT_NAMESPACE
 
 #endif
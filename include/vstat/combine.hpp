@@ -24,6 +24,29 @@ namespace detail {
             return std::array{ v.get(I) ... };
         }(std::make_index_sequence<T::size()>{});
     }
+
+    // returns 1 / (n0 * n1 * (n0 + n1)) or zero when one of the partitions is empty (eq. 22)
+    template<typename T>
+    inline auto combine_factor(T n0, T n1) noexcept -> T
+    {
+        T const n = n0 * n1 * (n0 + n1);
+        if constexpr (eve::simd_value<T>) {
+            return eve::if_else(n == T{0}, T{0}, T{1} / n);
+        } else {
+            return n == T{0} ? T{0} : T{1} / n;
+        }
+    }
+
+    // the accumulators keep sum_w_old = 1 while empty, so that the first update does not divide by zero
+    template<typename T>
+    inline auto nonzero_weight(T sum_w) noexcept -> T
+    {
+        if constexpr (eve::simd_value<T>) {
+            return eve::if_else(sum_w == T{0}, T{1}, sum_w);
+        } else {
+            return sum_w == T{0} ? T{1} : sum_w;
+        }
+    }
 } // namespace detail
 
 // The code below is based on:
@@ -63,6 +86,33 @@ inline auto combine(T sum_w, T sum_x, T sum_xx) -> double
     }
 }
 
+// merge the scalar states { sum_w, sum_x, sum_xx } of two partitions A,B (eq. 21-22)
+inline auto combine(std::tuple<double, double, double> const& a, std::tuple<double, double, double> const& b) noexcept -> std::tuple<double, double, double>
+{
+    auto [n0, s0, q0] = a;
+    auto [n1, s1, q1] = b;
+
+    double f = 1. / (n0 * n1 * (n0 + n1));
+    if (!std::isfinite(f)) { f = 0; }
+    return { n0 + n1, s0 + s1, q0 + q1 + f * eve::sqr(n1 * s0 - n0 * s1) };
+}
+
+// merge the scalar states { sum_w, sum_x, sum_y, sum_xx, sum_yy, sum_xy } of two partitions A,B (eq. 21-26)
+inline auto combine(std::tuple<double, double, double, double, double, double> const& a, // NOLINT
+                    std::tuple<double, double, double, double, double, double> const& b) noexcept
+    -> std::tuple<double, double, double, double, double, double>
+{
+    auto [n0, sx0, sy0, sxx0, syy0, sxy0] = a;
+    auto [n1, sx1, sy1, sxx1, syy1, sxy1] = b;
+
+    double f = 1. / (n0 * n1 * (n0 + n1));
+    if (!std::isfinite(f)) { f = 0; }
+
+    double sx = n1 * sx0 - n0 * sx1;
+    double sy = n1 * sy0 - n0 * sy1;
+    return { n0 + n1, sx0 + sx1, sy0 + sy1, sxx0 + sxx1 + f * sx * sx, syy0 + syy1 + f * sy * sy, sxy0 + sxy1 + f * sx * sy };
+}
+
 template<typename T>
 requires eve::simd_value<T> && (T::size() >= 2)
 inline auto combine(T sum_w, T sum_x, T sum_y, T sum_xx, T sum_yy, T sum_xy) -> std::tuple<double, double, double> // NOLINT
@@ -0,0 +1,432 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_CSV_HPP
+#define VSTAT_CSV_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "vstat.hpp"
+
+/*!
+    \defgroup CSV Streaming CSV column statistics
+
+    \brief Single-pass statistics of the columns of delimited text
+
+    The `csv::accumulate` methods read a stream of delimiter-separated values in large blocks and compute the
+    univariate statistics of the selected columns and the bivariate statistics of the selected pairs of columns
+    in a single pass. The columns are never materialized: the parsed values are collected in small per-column
+    batches which are fed to the SIMD accumulators.
+
+    The lines are located with `memchr` and the numbers are parsed with `std::from_chars`. The fields of a line
+    are only split up to the last selected column. Fields may be enclosed in double quotes (so they can contain
+    the delimiter, but not line breaks). Leading and trailing blanks are ignored. Empty fields, fields that are
+    not numbers and NaN values count as missing: they are left out and counted in `skipped`. A pair is left out if
+    either of its values is missing.
+*/
+
+namespace VSTAT_NAMESPACE {
+/*!
+    \ingroup CSV
+
+    \brief Format of the delimited text
+*/
+struct csv_options {
+    char delimiter{ ',' };
+    bool header{ true };                            // the first line holds the column names
+    std::size_t block_size{ std::size_t{1} << 22U }; // the number of bytes read from the stream at once
+};
+
+/*!
+    \ingroup CSV
+
+    \brief The result of `csv::accumulate`
+*/
+struct csv_statistics {
+    std::vector<std::string> names;                // the column names from the header (empty without a header)
+    std::size_t rows{ 0 };                         // the number of data rows (empty lines are not counted)
+    std::vector<univariate_statistics> univariate; // one per selected column, in selection order
+    std::vector<bivariate_statistics> bivariate;   // one per selected pair, in selection order
+};
+
+namespace detail::csv {
+    inline constexpr auto npos{ std::numeric_limits<std::size_t>::max() };
+
+    // reads the lines of a stream in large blocks. a line is valid until the next call
+    class line_reader {
+    public:
+        line_reader(std::istream& in, std::size_t block_size)
+            : in_{ in }, buffer_(std::max(block_size, std::size_t{1}))
+        {
+        }
+
+        // returns false at the end of the stream. the line break (LF or CRLF) is not part of the line
+        auto next(std::string_view& line) -> bool
+        {
+            for (;;) {
+                auto const* first = buffer_.data() + begin_;
+                auto const* const last = buffer_.data() + end_;
+                auto const* eol = static_cast<char const*>(std::memchr(first, '\n', last - first));
+                if (eol == nullptr && eof_) {
+                    if (first == last) {
+                        return false;
+                    }
+                    eol = last; // the last line has no line break
+                }
+                if (eol != nullptr) {
+                    begin_ = std::min<std::size_t>(eol - buffer_.data() + 1, end_);
+                    line = { first, static_cast<std::size_t>(eol - first) };
+                    if (!line.empty() && line.back() == '\r') {
+                        line.remove_suffix(1);
+                    }
+                    return true;
+                }
+                fill();
+            }
+        }
+
+    private:
+        // moves the partial line to the front of the buffer (growing it if the line fills the buffer) and reads the next block
+        void fill()
+        {
+            auto const rest = end_ - begin_;
+            std::memmove(buffer_.data(), buffer_.data() + begin_, rest);
+            begin_ = 0;
+            end_ = rest;
+            if (end_ == buffer_.size()) {
+                buffer_.resize(2 * buffer_.size());
+            }
+            in_.read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+            auto const count = static_cast<std::size_t>(in_.gcount());
+            end_ += count;
+            eof_ = count == 0 || !in_;
+        }
+
+        std::istream& in_;
+        std::vector<char> buffer_;
+        std::size_t begin_{ 0 };
+        std::size_t end_{ 0 };
+        bool eof_{ false };
+    };
+
+    // calls `func(index, field)` for the fields of the line, up to the field `last`
+    template<typename F>
+    inline auto split(std::string_view line, char delimiter, std::size_t last, F&& func) -> void
+    {
+        auto const* p = line.data();
+        auto const* const e = p + line.size();
+        for (std::size_t i = 0; i <= last; ++i) {
+            char const* q{ nullptr };
+            if (p < e && *p == '"') {
+                // a quoted field ends at a quote followed by the delimiter or the end of the line ("" escapes a quote)
+                q = p + 1;
+                while (q < e && !(*q == '"' && (q + 1 == e || q[1] == delimiter))) {
+                    ++q;
+                }
+                q = std::min(q + 1, e);
+            } else {
+                q = static_cast<char const*>(std::memchr(p, delimiter, e - p));
+                q = q == nullptr ? e : q;
+            }
+            func(i, std::string_view{ p, static_cast<std::size_t>(q - p) });
+            if (q == e) {
+                return;
+            }
+            p = q + 1;
+        }
+    }
+
+    // removes the surrounding blanks and quotes
+    inline auto trim(std::string_view field) noexcept -> std::string_view
+    {
+        auto const blank = [](char c) { return c == ' ' || c == '\t'; };
+        while (!field.empty() && blank(field.front())) { field.remove_prefix(1); }
+        while (!field.empty() && blank(field.back())) { field.remove_suffix(1); }
+        if (field.size() >= 2 && field.front() == '"' && field.back() == '"') {
+            field = field.substr(1, field.size() - 2);
+        }
+        return field;
+    }
+
+    inline auto name(std::string_view field) -> std::string
+    {
+        std::string s;
+        field = trim(field);
+        for (std::size_t i = 0; i < field.size(); ++i) {
+            s.push_back(field[i]);
+            i += static_cast<std::size_t>(field[i] == '"' && i + 1 < field.size() && field[i + 1] == '"');
+        }
+        return s;
+    }
+
+    // returns NaN if the field is not a number
+    template<std::floating_point T>
+    inline auto parse(std::string_view field) noexcept -> T
+    {
+        field = trim(field);
+        if (!field.empty() && field.front() == '+') {
+            field.remove_prefix(1);
+        }
+        T value{};
+        auto const* const end = field.data() + field.size();
+        auto const [ptr, ec] = std::from_chars(field.data(), end, value);
+        return ec == std::errc{} && ptr == end ? value : std::numeric_limits<T>::quiet_NaN();
+    }
+
+    // collects the values of a column in batches of whole SIMD vectors
+    template<std::floating_point T>
+    class univariate_column {
+        using wide = eve::wide<T>;
+        static auto constexpr batch_size{ 128 * wide::size() };
+
+    public:
+        univariate_column() { batch_.reserve(batch_size); }
+
+        auto operator()(T x) -> void
+        {
+            if (std::isnan(x)) {
+                ++skipped_;
+                return;
+            }
+            batch_.push_back(x);
+            if (batch_.size() == batch_size) {
+                univariate::update(acc_, batch_.data(), batch_.data() + batch_.size());
+                batch_.clear();
+            }
+        }
+
+        auto stats() -> univariate_statistics
+        {
+            auto const* first = univariate::update(acc_, batch_.data(), batch_.data() + batch_.size());
+            auto scalar_acc = univariate_accumulator<double>::load_state(acc_.stats());
+            for (; first < batch_.data() + batch_.size(); ++first) {
+                scalar_acc(*first);
+            }
+            univariate_statistics stats(scalar_acc);
+            stats.skipped = skipped_;
+            return stats;
+        }
+
+    private:
+        univariate_accumulator<wide> acc_;
+        std::vector<T> batch_;
+        std::size_t skipped_{ 0 };
+    };
+
+    // collects the value pairs of two columns in batches of whole SIMD vectors
+    template<std::floating_point T>
+    class bivariate_column {
+        using wide = eve::wide<T>;
+        static auto constexpr batch_size{ 128 * wide::size() };
+
+    public:
+        bivariate_column()
+        {
+            x_.reserve(batch_size);
+            y_.reserve(batch_size);
+        }
+
+        auto operator()(T x, T y) -> void
+        {
+            if (std::isnan(x) || std::isnan(y)) {
+                ++skipped_;
+                return;
+            }
+            x_.push_back(x);
+            y_.push_back(y);
+            if (x_.size() == batch_size) {
+                bivariate::update(acc_, x_.data(), x_.data() + x_.size(), y_.data());
+                x_.clear();
+                y_.clear();
+            }
+        }
+
+        auto stats() -> bivariate_statistics
+        {
+            auto [first1, first2] = bivariate::update(acc_, x_.data(), x_.data() + x_.size(), y_.data());
+            auto [sw, sx, sy, sxx, syy, sxy] = acc_.stats();
+            auto scalar_acc = bivariate_accumulator<double>::load_state(sx, sy, sw, sxx, syy, sxy);
+            for (; first1 < x_.data() + x_.size(); ++first1, ++first2) {
+                scalar_acc(*first1, *first2);
+            }
+            bivariate_statistics stats(scalar_acc);
+            stats.skipped = skipped_;
+            return stats;
+        }
+
+    private:
+        bivariate_accumulator<wide> acc_;
+        std::vector<T> x_;
+        std::vector<T> y_;
+        std::size_t skipped_{ 0 };
+    };
+
+    struct selection {
+        std::vector<std::size_t> columns;
+        std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    };
+
+    // `select(names, fields)` returns the selected columns and pairs, given the header and the number of fields of the first line
+    template<std::floating_point T, typename Select>
+    inline auto accumulate(std::istream& in, csv_options const& options, Select&& select) -> csv_statistics
+    {
+        line_reader reader(in, options.block_size);
+        csv_statistics result;
+
+        std::string_view line;
+        auto pending = reader.next(line); // the first line, holding the header or the first row
+        std::size_t fields{ 0 };
+        if (pending) {
+            split(line, options.delimiter, npos - 1, [&](auto /*unused*/, auto field) {
+                ++fields;
+                if (options.header) {
+                    result.names.push_back(name(field));
+                }
+            });
+            pending = !options.header;
+        }
+        selection const sel = std::forward<Select>(select)(std::as_const(result.names), fields);
+
+        // every selected column is parsed once, into its slot of the row
+        std::vector<std::size_t> slot;
+        std::size_t slots{ 0 };
+        auto const add = [&](std::size_t column) {
+            if (column >= slot.size()) {
+                slot.resize(column + 1, npos);
+            }
+            if (slot[column] == npos) {
+                slot[column] = slots++;
+            }
+        };
+        for (auto c : sel.columns) { add(c); }
+        for (auto [a, b] : sel.pairs) { add(a); add(b); }
+
+        std::vector<univariate_column<T>> univariate(sel.columns.size());
+        std::vector<bivariate_column<T>> bivariate(sel.pairs.size());
+        std::vector<T> row(slots);
+
+        for (; pending || reader.next(line); pending = false) {
+            if (line.empty()) {
+                continue;
+            }
+            ++result.rows;
+            if (slots == 0) {
+                continue;
+            }
+            std::fill(row.begin(), row.end(), std::numeric_limits<T>::quiet_NaN());
+            split(line, options.delimiter, slot.size() - 1, [&](auto i, auto field) {
+                if (slot[i] != npos) {
+                    row[slot[i]] = parse<T>(field);
+                }
+            });
+            for (std::size_t k = 0; k < sel.columns.size(); ++k) {
+                univariate[k](row[slot[sel.columns[k]]]);
+            }
+            for (std::size_t k = 0; k < sel.pairs.size(); ++k) {
+                bivariate[k](row[slot[sel.pairs[k].first]], row[slot[sel.pairs[k].second]]);
+            }
+        }
+
+        for (auto& c : univariate) { result.univariate.push_back(c.stats()); }
+        for (auto& c : bivariate) { result.bivariate.push_back(c.stats()); }
+        return result;
+    }
+
+    inline auto index(std::vector<std::string> const& names, std::string const& name) -> std::size_t
+    {
+        auto const it = std::find(names.begin(), names.end(), name);
+        if (it == names.end()) {
+            throw std::invalid_argument("unknown column " + name);
+        }
+        return static_cast<std::size_t>(it - names.begin());
+    }
+} // namespace detail::csv
+
+namespace csv {
+    /*!
+        \ingroup CSV
+
+        \brief Computes the statistics of the selected columns (and pairs of columns) in a single pass
+
+        \tparam T The value type the fields are parsed to and accumulated in
+
+        \param in      The input stream (open it in binary mode, the line breaks are handled by the parser)
+        \param columns The zero-based indices of the columns
+        \param pairs   The pairs of column indices
+        \param options The delimiter, header and block size
+    */
+    template<std::floating_point T>
+    inline auto accumulate(std::istream& in, std::span<std::size_t const> columns, std::span<std::pair<std::size_t, std::size_t> const> pairs = {}, csv_options const& options = {}) -> csv_statistics
+    {
+        return detail::csv::accumulate<T>(in, options, [&](auto const& /*unused*/, auto /*unused*/) {
+            return detail::csv::selection{ { columns.begin(), columns.end() }, { pairs.begin(), pairs.end() } };
+        });
+    }
+
+    /*!
+        \ingroup CSV
+
+        \brief Computes the statistics of the columns (and pairs of columns) selected by name in a single pass
+
+        \tparam T The value type the fields are parsed to and accumulated in
+
+        \param in      The input stream (open it in binary mode, the line breaks are handled by the parser)
+        \param columns The names of the columns
+        \param pairs   The pairs of column names
+        \param options The delimiter, header and block size
+
+        Throws `std::invalid_argument` if a name is not found in the header.
+    */
+    template<std::floating_point T>
+    inline auto accumulate(std::istream& in, std::span<std::string const> columns, std::span<std::pair<std::string, std::string> const> pairs = {}, csv_options const& options = {}) -> csv_statistics
+    {
+        return detail::csv::accumulate<T>(in, options, [&](auto const& names, auto /*unused*/) {
+            detail::csv::selection sel;
+            for (auto const& c : columns) {
+                sel.columns.push_back(detail::csv::index(names, c));
+            }
+            for (auto const& [a, b] : pairs) {
+                sel.pairs.emplace_back(detail::csv::index(names, a), detail::csv::index(names, b));
+            }
+            return sel;
+        });
+    }
+
+    /*!
+        \ingroup CSV
+
+        \brief Computes the statistics of all the columns (as many as the fields of the first line) in a single pass
+
+        \tparam T The value type the fields are parsed to and accumulated in
+
+        \param in      The input stream (open it in binary mode, the line breaks are handled by the parser)
+        \param options The delimiter, header and block size
+    */
+    template<std::floating_point T>
+    inline auto accumulate(std::istream& in, csv_options const& options = {}) -> csv_statistics
+    {
+        return detail::csv::accumulate<T>(in, options, [](auto const& /*unused*/, auto fields) {
+            detail::csv::selection sel;
+            sel.columns.resize(fields);
+            std::iota(sel.columns.begin(), sel.columns.end(), std::size_t{0});
+            return sel;
+        });
+    }
+} // namespace csv
+} // namespace VSTAT_NAMESPACE
+
+#endif
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_DISPATCH_HPP
+#define VSTAT_DISPATCH_HPP
+
+#include <concepts>
+#include <cstdint>
+
+#include "statistics.hpp"
+#include "tags.hpp"
+
+/*!
+    \defgroup Dispatch Runtime instruction set dispatch
+
+    \brief Kernels compiled for several instruction sets, selected at runtime
+
+    The width of the `eve::wide` SIMD types is fixed when the header-only methods are compiled, so a portable binary
+    cannot use the wider registers of the CPU it runs on. The optional `vstat::dispatch` library (built with
+    `-Dvstat_BUILD_DISPATCH=ON`) compiles the core accumulate and metrics kernels for the x86-64 SSE4.2, AVX2 and
+    AVX-512 levels, each into a module of its own, and loads the best one supported by the CPU (as reported by
+    CPUID) when the library is loaded. The kernels of the baseline the library itself is compiled for are always
+    available. Like `vstat/kernels.hpp`, this header does not include EVE.
+
+    The selection can be overridden with the `VSTAT_ISA` environment variable (`generic`, `sse4_2`, `avx2` or
+    `avx512`) or with `set_isa`. The modules are searched in the `VSTAT_KERNELS_PATH` directory, next to the binary
+    containing the dispatcher, in the installation and in the build directory.
+
+    The kernels operate on contiguous `float` or `double` arrays and return the same results as the corresponding
+    header-only methods compiled for the selected instruction set.
+*/
+
+namespace VSTAT_NAMESPACE::dispatch {
+/*!
+    \ingroup Dispatch
+
+    \brief The instruction set levels the kernels are compiled for
+*/
+enum class isa : std::uint8_t {
+    generic, // the baseline of the dispatch library
+    sse4_2,  // x86-64-v2
+    avx2,    // x86-64-v3 (AVX2, FMA)
+    avx512   // x86-64-v4 (AVX-512 F, BW, CD, DQ, VL)
+};
+
+//! \ingroup Dispatch
+//! \brief The name of the instruction set level (the values accepted by `VSTAT_ISA`)
+auto isa_name(isa level) noexcept -> char const*;
+
+//! \ingroup Dispatch
+//! \brief True if the CPU supports the instruction set level and its kernels could be loaded
+auto available(isa level) noexcept -> bool;
+
+//! \ingroup Dispatch
+//! \brief The instruction set level of the kernels in use
+auto active_isa() noexcept -> isa;
+
+//! \ingroup Dispatch
+//! \brief Selects the kernels of the given instruction set level, returns false (keeping the current kernels) if not available
+auto set_isa(isa level) noexcept -> bool;
+
+namespace univariate {
+    //! \ingroup Dispatch
+    template<std::floating_point T>
+    auto accumulate(T const* first, T const* last) noexcept -> univariate_statistics;
+
+    //! \ingroup Dispatch
+    template<std::floating_point T>
+    auto accumulate(T const* first, T const* last, T const* weights) noexcept -> univariate_statistics;
+
+    //! \ingroup Dispatch
+    template<std::floating_point T>
+    auto accumulate(with_extrema_t /*unused*/, T const* first, T const* last) noexcept -> univariate_statistics;
+} // namespace univariate
+
+namespace bivariate {
+    //! \ingroup Dispatch
+    template<std::floating_point T>
+    auto accumulate(T const* first1, T const* last1, T const* first2) noexcept -> bivariate_statistics;
+
+    //! \ingroup Dispatch
+    template<std::floating_point T>
+    auto accumulate(T const* first1, T const* last1, T const* first2, T const* weights) noexcept -> bivariate_statistics;
+} // namespace bivariate
+
+namespace metrics {
+    //! \ingroup Dispatch
+    template<std::floating_point T>
+    auto r2_score(T const* first1, T const* last1, T const* first2, T const* weights = nullptr) noexcept -> double;
+
+    //! \ingroup Dispatch
+    template<std::floating_point T>
+    auto mean_squared_error(T const* first1, T const* last1, T const* first2, T const* weights = nullptr) noexcept -> double;
+
+    //! \ingroup Dispatch
+    template<std::floating_point T>
+    auto mean_squared_log_error(T const* first1, T const* last1, T const* first2, T const* weights = nullptr) noexcept -> double;
+
+    //! \ingroup Dispatch
+    template<std::floating_point T>
+    auto mean_absolute_error(T const* first1, T const* last1, T const* first2, T const* weights = nullptr) noexcept -> double;
+
+    //! \ingroup Dispatch
+    template<std::floating_point T>
+    auto mean_absolute_percentage_error(T const* first1, T const* last1, T const* first2, T const* weights = nullptr) noexcept -> double;
+
+    //! \ingroup Dispatch
+    template<std::floating_point T>
+    auto poisson_neg_likelihood_loss(T const* first1, T const* last1, T const* first2, T const* weights = nullptr) noexcept -> double;
+} // namespace metrics
+} // namespace VSTAT_NAMESPACE::dispatch
+
+#endif
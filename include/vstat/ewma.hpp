@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_EWMA_HPP
+#define VSTAT_EWMA_HPP
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numbers>
+#include <tuple>
+#include <utility>
+
+#include <eve/wide.hpp>
+#include <eve/module/core.hpp>
+
+#include "util.hpp"
+
+namespace VSTAT_NAMESPACE {
+/*!
+    \brief Exponentially weighted moving mean and variance
+
+    With the smoothing factor \f$\alpha\f$ and \f$\beta = 1 - \alpha\f$, every sample updates the statistics as
+    \f$\mu_t = \beta \mu_{t-1} + \alpha x_t\f$ and \f$\sigma^2_t = \beta (\sigma^2_{t-1} + \alpha (x_t - \mu_{t-1})^2)\f$.
+    The first sample initializes the mean (with zero variance), which matches pandas' `ewm(adjust=False)`.
+
+    The state is kept relative to a reference value \f$c\f$ as the moving averages \f$M\f$ of \f$x - c\f$ and
+    \f$S\f$ of \f$(x - c)^2\f$, which are both linear recurrences (the variance is \f$S - M^2\f$). A SIMD vector of
+    consecutive samples is therefore processed as a prefix scan: the contribution of the vector to each lane is a
+    product with a triangular matrix of decay factors, and the carry from the previous samples is a single
+    multiply-add with the powers of \f$\beta\f$. The reference is moved to the current mean every few vectors to
+    keep the cancellation in \f$S - M^2\f$ small.
+
+    \tparam T The scalar value type, used for the `eve::wide<T>` SIMD type of the batch updates
+*/
+template<std::floating_point T>
+struct ewma_accumulator {
+    using wide = eve::wide<T>;
+
+    explicit ewma_accumulator(double alpha)
+        : alpha_{static_cast<T>(alpha)}
+        , beta_{static_cast<T>(1 - alpha)}
+    {
+        VSTAT_EXPECT(0 < alpha && alpha <= 1);
+        for (std::size_t j = 0; j < lanes; ++j) {
+            // lane i receives the sample of lane j with the weight alpha * beta^(i - j)
+            decay_[j] = wide{ [&](auto i, auto) { return i < static_cast<decltype(i)>(j) ? T{0} : alpha_ * power(beta_, static_cast<std::size_t>(i) - j); } };
+        }
+        carry_ = wide{ [&](auto i, auto) { return power(beta_, static_cast<std::size_t>(i) + 1); } };
+    }
+
+    // the smoothing factor for which the weight of a sample halves after `half_life` samples
+    static auto from_half_life(double half_life) -> ewma_accumulator<T>
+    {
+        VSTAT_EXPECT(half_life > 0);
+        return ewma_accumulator<T>(1 - std::exp(-std::numbers::ln2 / half_life));
+    }
+
+    static auto load_state(double alpha, std::uint64_t count, T mean, T variance) -> ewma_accumulator<T>
+    {
+        ewma_accumulator<T> acc(alpha);
+        acc.count_ = count;
+        acc.ref_ = mean;
+        acc.s_ = variance;
+        return acc;
+    }
+
+    inline void operator()(T x) noexcept
+    {
+        if (count_ == 0) {
+            ref_ = x;
+        }
+        T const d = x - ref_;
+        m_ = beta_ * m_ + alpha_ * d;
+        s_ = beta_ * s_ + alpha_ * d * d;
+        ++count_;
+        if (++pending_ >= recenter_interval) {
+            recenter();
+        }
+    }
+
+    // updates the state with a vector of consecutive samples (the first one in lane 0) and returns the moving
+    // mean and variance after each of them
+    inline auto operator()(wide const& x) noexcept -> std::pair<wide, wide>
+    {
+        if (count_ == 0) {
+            ref_ = x.get(0);
+        }
+        wide const d = x - ref_;
+        std::array<T, lanes> dx;
+        std::array<T, lanes> dx2;
+        eve::store(d, dx.data());
+        eve::store(d * d, dx2.data());
+
+        // the contribution of the vector itself, which does not depend on the carry
+        wide m{0};
+        wide s{0};
+        for (std::size_t j = 0; j < lanes; ++j) {
+            m = eve::fma(decay_[j], wide{dx[j]}, m);
+            s = eve::fma(decay_[j], wide{dx2[j]}, s);
+        }
+        m = eve::fma(carry_, wide{m_}, m);
+        s = eve::fma(carry_, wide{s_}, s);
+        m_ = m.get(lanes - 1);
+        s_ = s.get(lanes - 1);
+        count_ += lanes;
+
+        std::pair<wide, wide> result{ m + ref_, s - m * m };
+        if ((pending_ += lanes) >= recenter_interval) {
+            recenter();
+        }
+        return result;
+    }
+
+    template<typename U>
+    requires eve::simd_compatible_ptr<U, wide>
+    inline auto operator()(U const* x) noexcept -> std::pair<wide, wide>
+    {
+        return (*this)(wide{x});
+    }
+
+    [[nodiscard]] auto alpha() const noexcept -> double { return alpha_; }
+
+    [[nodiscard]] auto count() const noexcept -> std::uint64_t { return count_; }
+
+    // the current moving mean (NaN before the first sample)
+    [[nodiscard]] auto mean() const noexcept -> double
+    {
+        return count_ == 0 ? std::numeric_limits<double>::quiet_NaN() : static_cast<double>(ref_) + static_cast<double>(m_);
+    }
+
+    // the current moving variance (NaN before the first sample)
+    [[nodiscard]] auto variance() const noexcept -> double
+    {
+        return count_ == 0 ? std::numeric_limits<double>::quiet_NaN() : static_cast<double>(s_) - static_cast<double>(m_) * static_cast<double>(m_);
+    }
+
+    // returns { count, mean, variance }
+    [[nodiscard]] auto stats() const noexcept -> std::tuple<std::uint64_t, double, double>
+    {
+        return { count_, mean(), variance() };
+    }
+
+private:
+    static auto constexpr lanes{ static_cast<std::size_t>(wide::size()) };
+    static auto constexpr recenter_interval{ 64UL };
+
+    static auto power(T x, std::size_t n) noexcept -> T
+    {
+        T p{1};
+        for (std::size_t i = 0; i < n; ++i) {
+            p *= x;
+        }
+        return p;
+    }
+
+    // moves the reference to the current mean
+    inline void recenter() noexcept
+    {
+        ref_ += m_;
+        s_ -= m_ * m_;
+        m_ = T{0};
+        pending_ = 0;
+    }
+
+    T alpha_;
+    T beta_;
+    std::uint64_t count_{0};
+    std::size_t pending_{0};
+    T ref_{0};
+    T m_{0};
+    T s_{0};
+    std::array<wide, lanes> decay_;
+    wide carry_;
+};
+} // namespace VSTAT_NAMESPACE
+
+#endif
@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_EXTREMA_HPP
+#define VSTAT_EXTREMA_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+
+#include <eve/wide.hpp>
+#include <eve/module/core.hpp>
+
+#include "util.hpp"
+
+namespace VSTAT_NAMESPACE {
+namespace detail {
+    // the index type matching a value type (an integer wide with the same number of lanes for SIMD types)
+    template<typename T>
+    struct extrema_index {
+        using type = std::int64_t;
+    };
+
+    template<eve::simd_value T>
+    struct extrema_index<T> {
+        using type = eve::wide<std::int64_t, typename T::cardinal_type>;
+    };
+} // namespace detail
+
+/*!
+    \brief Accumulator for the minimum and maximum values and their positions
+
+    The values are expected in sequence order: for SIMD types, the lanes of a vector hold consecutive values.
+    Each lane keeps its own extrema along with their positions, the lanes are reduced in `stats()`. Merging two
+    accumulators concatenates their sequences, i.e. the positions of the other accumulator are shifted by the
+    number of values seen by this one. NaN values are ignored (but counted for the positions) and in case of
+    ties the first position is reported.
+
+    \tparam T The value type (a scalar type or an `eve::wide` SIMD type)
+*/
+template <typename T>
+struct extrema_accumulator {
+    using index_type = typename detail::extrema_index<T>::type;
+
+    static auto load_state(std::int64_t count, T min, T max, index_type argmin, index_type argmax) noexcept -> extrema_accumulator<T> // NOLINT
+    {
+        extrema_accumulator<T> acc;
+        acc.count = count;
+        acc.min = min;
+        acc.max = max;
+        acc.argmin = argmin;
+        acc.argmax = argmax;
+        return acc;
+    }
+
+    static auto load_state(std::tuple<std::int64_t, T, T, index_type, index_type> state) noexcept -> extrema_accumulator<T>
+    {
+        auto [count, min, max, argmin, argmax] = state;
+        return load_state(count, min, max, argmin, argmax);
+    }
+
+    inline void operator()(T x) noexcept
+    {
+        if constexpr (eve::simd_value<T>) {
+            index_type const idx = index_type{count} + lanes();
+            auto const lt = x < min || (empty(argmin) && eve::is_not_nan(x));
+            auto const gt = x > max || (empty(argmax) && eve::is_not_nan(x));
+            min = eve::if_else(lt, x, min);
+            max = eve::if_else(gt, x, max);
+            argmin = eve::if_else(lt, idx, argmin);
+            argmax = eve::if_else(gt, idx, argmax);
+            count += T::size();
+        } else {
+            if (x < min || (argmin < 0 && !std::isnan(x))) { min = x; argmin = count; }
+            if (x > max || (argmax < 0 && !std::isnan(x))) { max = x; argmax = count; }
+            ++count;
+        }
+    }
+
+    template<typename U>
+    requires eve::simd_value<T> && eve::simd_compatible_ptr<U, T>
+    inline void operator()(U const* x) noexcept
+    {
+        (*this)(T{x});
+    }
+
+    // appends the sequence of another accumulator to this one. for SIMD types the merge is performed lane-wise.
+    inline auto merge(extrema_accumulator<T> const& other) noexcept -> extrema_accumulator<T>&
+    {
+        index_type const offset{count};
+        if constexpr (eve::simd_value<T>) {
+            auto const lt = !empty(other.argmin) && (other.min < min || empty(argmin));
+            auto const gt = !empty(other.argmax) && (other.max > max || empty(argmax));
+            min = eve::if_else(lt, other.min, min);
+            max = eve::if_else(gt, other.max, max);
+            argmin = eve::if_else(lt, other.argmin + offset, argmin);
+            argmax = eve::if_else(gt, other.argmax + offset, argmax);
+        } else {
+            if (other.argmin >= 0 && (argmin < 0 || other.min < min)) { min = other.min; argmin = other.argmin + offset; }
+            if (other.argmax >= 0 && (argmax < 0 || other.max > max)) { max = other.max; argmax = other.argmax + offset; }
+        }
+        count += other.count;
+        return *this;
+    }
+
+    inline auto operator+=(extrema_accumulator<T> const& other) noexcept -> extrema_accumulator<T>&
+    {
+        return merge(other);
+    }
+
+    // returns the raw (unreduced) state { count, min, max, argmin, argmax }
+    [[nodiscard]] auto state() const noexcept -> std::tuple<std::int64_t, T, T, index_type, index_type>
+    {
+        return { count, min, max, argmin, argmax };
+    }
+
+    // reduces the lanes (for SIMD types) and returns { count, min, max, argmin, argmax }. the extrema are NaN
+    // and their positions are -1 if no (non-NaN) values were seen.
+    [[nodiscard]] auto stats() const noexcept -> std::tuple<std::int64_t, double, double, std::int64_t, std::int64_t>
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            auto constexpr nan{ std::numeric_limits<double>::quiet_NaN() };
+            return { count,
+                argmin < 0 ? nan : static_cast<double>(min),
+                argmax < 0 ? nan : static_cast<double>(max),
+                argmin, argmax };
+        } else {
+            double lo{std::numeric_limits<double>::infinity()};
+            double hi{-std::numeric_limits<double>::infinity()};
+            std::int64_t arglo{-1};
+            std::int64_t arghi{-1};
+            for (auto i = 0; i < T::size(); ++i) {
+                // equal values in different lanes: keep the first position
+                double const a = min.get(i);
+                double const b = max.get(i);
+                if (argmin.get(i) >= 0 && (arglo < 0 || a < lo || (a == lo && argmin.get(i) < arglo))) { lo = a; arglo = argmin.get(i); }
+                if (argmax.get(i) >= 0 && (arghi < 0 || b > hi || (b == hi && argmax.get(i) < arghi))) { hi = b; arghi = argmax.get(i); }
+            }
+            return extrema_accumulator<double>::load_state(count, lo, hi, arglo, arghi).stats();
+        }
+    }
+
+private:
+    // the offsets of the lanes within a vector
+    static auto lanes() noexcept -> index_type requires eve::simd_value<T>
+    {
+        return index_type{ [](auto i, auto) { return i; } };
+    }
+
+    // the lanes that have not seen a (non-NaN) value yet. an empty state may hold any extrema (e.g. the NaNs
+    // reported by `stats()` when it is reloaded), so the first value is always taken.
+    static auto empty(index_type const& arg) noexcept requires eve::simd_value<T>
+    {
+        return eve::convert(arg, eve::as<eve::element_type_t<T>>{}) < 0;
+    }
+
+    std::int64_t count{0};
+    T min{std::numeric_limits<eve::element_type_t<T>>::infinity()};
+    T max{-std::numeric_limits<eve::element_type_t<T>>::infinity()};
+    index_type argmin{-1};
+    index_type argmax{-1};
+};
+} // namespace VSTAT_NAMESPACE
+
+#endif
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_GROUPED_HPP
+#define VSTAT_GROUPED_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include "combine.hpp"
+
+namespace VSTAT_NAMESPACE {
+/*!
+    \brief Per-group accumulator states, stored as a struct of arrays
+
+    Entry `g` of each array holds the state of the group with key `g`, with the same meaning as the state of
+    `univariate_accumulator` (`sum_xx` is the sum of squared residuals) or `bivariate_accumulator` (`sum_yy`,
+    `sum_xy`). The bivariate arrays are empty for tables of univariate groups. The groups are updated one value at
+    a time or merged with the state of a whole partition, and two tables are merged group by group with `combine`.
+*/
+struct grouped_table {
+    std::vector<double> sum_w;
+    std::vector<double> sum_x;
+    std::vector<double> sum_xx;
+    std::vector<double> sum_y;
+    std::vector<double> sum_yy;
+    std::vector<double> sum_xy;
+    std::size_t skipped{0}; // values whose key is outside the range of the table
+
+    explicit grouped_table(std::size_t groups = 0, bool bivariate = false)
+        : sum_w(groups, 0.0)
+        , sum_x(groups, 0.0)
+        , sum_xx(groups, 0.0)
+        , sum_y(bivariate ? groups : 0, 0.0)
+        , sum_yy(bivariate ? groups : 0, 0.0)
+        , sum_xy(bivariate ? groups : 0, 0.0)
+    {
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return sum_w.size(); }
+
+    [[nodiscard]] auto bivariate() const noexcept -> bool { return !sum_y.empty(); }
+
+    // adds a value to group g (the update of univariate_accumulator)
+    inline void operator()(std::size_t g, double x) noexcept
+    {
+        double const n = sum_w[g];
+        double const dx = n * x - sum_x[g];
+        sum_w[g] = n + 1;
+        sum_x[g] += x;
+        if (n > 0) {
+            sum_xx[g] += dx * dx / (n * (n + 1));
+        }
+    }
+
+    // adds a pair of values to group g (the update of bivariate_accumulator)
+    inline void operator()(std::size_t g, double x, double y) noexcept
+    {
+        double const n = sum_w[g];
+        double const dx = n * x - sum_x[g];
+        double const dy = n * y - sum_y[g];
+        sum_w[g] = n + 1;
+        sum_x[g] += x;
+        sum_y[g] += y;
+        if (n > 0) {
+            double const f = 1 / (n * (n + 1));
+            sum_xx[g] += f * dx * dx;
+            sum_yy[g] += f * dy * dy;
+            sum_xy[g] += f * dx * dy;
+        }
+    }
+
+    // merges the state { sum_w, sum_x, sum_xx } of a partition into group g
+    inline void merge(std::size_t g, std::tuple<double, double, double> const& state) noexcept
+    {
+        std::tie(sum_w[g], sum_x[g], sum_xx[g]) = combine(std::tuple{ sum_w[g], sum_x[g], sum_xx[g] }, state);
+    }
+
+    // merges the state { sum_w, sum_x, sum_y, sum_xx, sum_yy, sum_xy } of a partition into group g
+    inline void merge(std::size_t g, std::tuple<double, double, double, double, double, double> const& state) noexcept
+    {
+        std::tie(sum_w[g], sum_x[g], sum_y[g], sum_xx[g], sum_yy[g], sum_xy[g]) =
+            combine(std::tuple{ sum_w[g], sum_x[g], sum_y[g], sum_xx[g], sum_yy[g], sum_xy[g] }, state);
+    }
+
+    // merges another table with the same number of groups, group by group
+    inline auto merge(grouped_table const& other) noexcept -> grouped_table&
+    {
+        VSTAT_EXPECT(size() == other.size() && bivariate() == other.bivariate());
+        for (std::size_t g = 0; g < size(); ++g) {
+            if (other.sum_w[g] == 0) {
+                continue;
+            }
+            if (bivariate()) {
+                merge(g, std::tuple{ other.sum_w[g], other.sum_x[g], other.sum_y[g], other.sum_xx[g], other.sum_yy[g], other.sum_xy[g] });
+            } else {
+                merge(g, std::tuple{ other.sum_w[g], other.sum_x[g], other.sum_xx[g] });
+            }
+        }
+        skipped += other.skipped;
+        return *this;
+    }
+
+    inline auto operator+=(grouped_table const& other) noexcept -> grouped_table&
+    {
+        return merge(other);
+    }
+
+    // the statistics of group g (NaN for empty groups)
+    [[nodiscard]] auto mean(std::size_t g) const noexcept -> double { return sum_x[g] / sum_w[g]; }
+
+    [[nodiscard]] auto variance(std::size_t g) const noexcept -> double { return sum_xx[g] / sum_w[g]; }
+
+    [[nodiscard]] auto sample_variance(std::size_t g) const noexcept -> double { return sum_xx[g] / (sum_w[g] - 1); }
+
+    [[nodiscard]] auto mean_y(std::size_t g) const noexcept -> double { return sum_y[g] / sum_w[g]; }
+
+    [[nodiscard]] auto covariance(std::size_t g) const noexcept -> double { return sum_xy[g] / sum_w[g]; }
+
+    // the correlation, with the same convention as `bivariate_statistics` for constant groups
+    [[nodiscard]] auto correlation(std::size_t g) const noexcept -> double
+    {
+        if (sum_w[g] == 0) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        if (!(sum_xx[g] > 0 && sum_yy[g] > 0)) {
+            return static_cast<double>(sum_xx[g] == sum_yy[g]);
+        }
+        return sum_xy[g] / std::sqrt(sum_xx[g] * sum_yy[g]);
+    }
+};
+} // namespace VSTAT_NAMESPACE
+
+#endif
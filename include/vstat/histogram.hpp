@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_HISTOGRAM_HPP
+#define VSTAT_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <eve/wide.hpp>
+#include <eve/module/core.hpp>
+#include <eve/module/math.hpp>
+
+#include "util.hpp"
+
+namespace VSTAT_NAMESPACE {
+/*!
+    \brief Bin layout of a histogram
+
+    `count` bins spanning [min, max], either of equal width (uniform) or of equal width on a logarithmic scale
+    (which requires min > 0). The bins are half-open except the last one, which includes max (as in numpy).
+*/
+struct histogram_bins {
+    double min;
+    double max;
+    std::size_t count;
+    bool logarithmic{false};
+
+    static auto uniform(double min, double max, std::size_t count) noexcept -> histogram_bins
+    {
+        VSTAT_EXPECT(min < max && count > 0);
+        return { min, max, count, false };
+    }
+
+    static auto log(double min, double max, std::size_t count) noexcept -> histogram_bins
+    {
+        VSTAT_EXPECT(0 < min && min < max && count > 0);
+        return { min, max, count, true };
+    }
+
+    // the count + 1 bin edges
+    [[nodiscard]] auto edges() const -> std::vector<double>
+    {
+        std::vector<double> e(count + 1);
+        for (std::size_t i = 0; i <= count; ++i) {
+            auto const t = static_cast<double>(i) / static_cast<double>(count);
+            e[i] = logarithmic ? min * std::pow(max / min, t) : min + t * (max - min);
+        }
+        e.back() = max;
+        return e;
+    }
+
+    auto operator==(histogram_bins const&) const -> bool = default;
+};
+
+/*!
+    \brief Histogram accumulator
+
+    The bin indices of a SIMD vector are computed with vector arithmetic (an affine map of the value or of its
+    logarithm, floored and clamped to the underflow and overflow slots). Each lane then increments its own
+    sub-histogram, so the lanes of a vector never conflict even when they fall into the same bin. The counts are
+    stored interleaved (bin by bin, lane by lane) and the sub-histograms are summed when the counts are read.
+
+    Values below the first edge are counted as underflow, values above the last edge as overflow and NaN values
+    separately. Values falling on a bin edge may be assigned to the neighbouring bin due to rounding.
+
+    \tparam T The scalar value type, used for the `eve::wide<T>` SIMD type of the bin computation
+*/
+template<std::floating_point T>
+struct histogram_accumulator {
+    using wide = eve::wide<T>;
+
+    explicit histogram_accumulator(histogram_bins bins)
+        : bins_{bins}
+        , offset_{static_cast<T>(bins.logarithmic ? std::log(bins.min) : bins.min)}
+        , scale_{static_cast<T>(static_cast<double>(bins.count) / (bins.logarithmic ? std::log(bins.max / bins.min) : bins.max - bins.min))}
+        , counts_((bins.count + slots) * lanes, 0)
+    {
+    }
+
+    inline void operator()(T x) noexcept
+    {
+        ++counts_[index(x) * lanes];
+    }
+
+    inline void operator()(wide x) noexcept
+    {
+        std::array<T, lanes> idx;
+        eve::store(index(x), idx.data());
+        for (std::size_t i = 0; i < lanes; ++i) {
+            ++counts_[static_cast<std::size_t>(idx[i]) * lanes + i];
+        }
+    }
+
+    template<typename U>
+    requires eve::simd_compatible_ptr<U, wide>
+    inline void operator()(U const* x) noexcept
+    {
+        (*this)(wide{x});
+    }
+
+    // merges the counts of another histogram with the same bin layout
+    inline auto merge(histogram_accumulator<T> const& other) noexcept -> histogram_accumulator<T>&
+    {
+        VSTAT_EXPECT(bins_ == other.bins_);
+        for (std::size_t i = 0; i < counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        return *this;
+    }
+
+    inline auto operator+=(histogram_accumulator<T> const& other) noexcept -> histogram_accumulator<T>&
+    {
+        return merge(other);
+    }
+
+    [[nodiscard]] auto bins() const noexcept -> histogram_bins const& { return bins_; }
+
+    // the counts of the bins (the sub-histograms of the lanes are summed)
+    [[nodiscard]] auto counts() const -> std::vector<std::uint64_t>
+    {
+        std::vector<std::uint64_t> result(bins_.count);
+        for (std::size_t b = 0; b < bins_.count; ++b) {
+            result[b] = slot(b + 1);
+        }
+        return result;
+    }
+
+    [[nodiscard]] auto underflow() const noexcept -> std::uint64_t { return slot(0); }
+
+    [[nodiscard]] auto overflow() const noexcept -> std::uint64_t { return slot(bins_.count + 1); }
+
+    [[nodiscard]] auto nan_count() const noexcept -> std::uint64_t { return slot(bins_.count + 2); }
+
+    // the total number of values, including the underflow, overflow and NaN values
+    [[nodiscard]] auto total() const noexcept -> std::uint64_t
+    {
+        std::uint64_t sum{0};
+        for (auto c : counts_) {
+            sum += c;
+        }
+        return sum;
+    }
+
+private:
+    static auto constexpr lanes{ static_cast<std::size_t>(wide::size()) };
+    static auto constexpr slots{ 3UL }; // underflow, overflow and NaN
+
+    // the slots of a vector of values: 0 for underflow, 1..count for the bins, count + 1 for overflow and
+    // count + 2 for NaN. the slots are computed as floating point values, which is exact for up to 2^24 bins.
+    inline auto index(wide x) const noexcept -> wide
+    {
+        auto const n = static_cast<T>(bins_.count);
+        // non-positive values map to -inf on the logarithmic scale (underflow)
+        wide const t = bins_.logarithmic ? eve::log(eve::max(x, wide{0})) : x;
+        wide const b = eve::clamp(eve::floor((t - offset_) * scale_) + T{1}, wide{0}, wide{n + 1});
+        // the last bin includes the upper edge
+        wide const v = eve::if_else(x == wide{static_cast<T>(bins_.max)}, wide{n}, b);
+        return eve::if_else(eve::is_nan(x), wide{n + 2}, v);
+    }
+
+    inline auto index(T x) const noexcept -> std::size_t
+    {
+        auto const n = static_cast<T>(bins_.count);
+        if (std::isnan(x)) {
+            return bins_.count + 2;
+        }
+        if (x == static_cast<T>(bins_.max)) {
+            return bins_.count;
+        }
+        T const t = bins_.logarithmic ? std::log(std::max(x, T{0})) : x;
+        return static_cast<std::size_t>(std::clamp(std::floor((t - offset_) * scale_) + T{1}, T{0}, n + 1));
+    }
+
+    [[nodiscard]] auto slot(std::size_t s) const noexcept -> std::uint64_t
+    {
+        std::uint64_t sum{0};
+        for (std::size_t i = 0; i < lanes; ++i) {
+            sum += counts_[s * lanes + i];
+        }
+        return sum;
+    }
+
+    histogram_bins bins_;
+    T offset_;
+    T scale_;
+    std::vector<std::uint64_t> counts_;
+};
+} // namespace VSTAT_NAMESPACE
+
+#endif
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_KERNELS_HPP
+#define VSTAT_KERNELS_HPP
+
+#include <concepts>
+#include <span>
+
+#include "statistics.hpp"
+#include "tags.hpp"
+
+/*!
+    \defgroup Kernels Precompiled kernels
+
+    \brief Declarations of the accumulate and metrics methods compiled into the `vstat::kernels` library
+
+    Including `vstat/vstat.hpp` pulls in the EVE math modules and instantiates the kernels in every translation
+    unit. The `vstat::kernels` library (built with `-Dvstat_BUILD_KERNELS=ON`) contains explicit instantiations of
+    the methods without projections for `float` and `double` values, over pointers and `std::span` iterators. This
+    header only declares them (it does not include EVE), so the translation units using it compile quickly.
+
+    The functions have the same semantics as the header-only methods of the same name (the accumulation is performed
+    in the precision of `T`), with every sequence accessed through the same iterator type:
+    \code{.cpp}
+    #include <vstat/kernels.hpp>
+
+    std::span<float const> x = ...;
+    auto stats = vstat::kernels::univariate::accumulate<float>(x.begin(), x.end());
+    \endcode
+*/
+
+namespace VSTAT_NAMESPACE::kernels {
+/*!
+    \ingroup Kernels
+
+    \brief The iterator types the kernels are instantiated for
+*/
+template<typename I, typename T>
+concept iterator = std::same_as<I, T const*> || std::same_as<I, T*>
+    || std::same_as<I, typename std::span<T const>::iterator> || std::same_as<I, typename std::span<T>::iterator>;
+
+namespace univariate {
+    //! \ingroup Kernels
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(I first, I last) noexcept -> univariate_statistics;
+
+    //! \ingroup Kernels
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(I first, I last, I weights) noexcept -> univariate_statistics;
+
+    //! \ingroup Kernels
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(skip_nan_t /*unused*/, I first, I last) noexcept -> univariate_statistics;
+
+    //! \ingroup Kernels
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(skip_nan_t /*unused*/, I first, I last, I weights) noexcept -> univariate_statistics;
+
+    //! \ingroup Kernels
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(with_extrema_t /*unused*/, I first, I last) noexcept -> univariate_statistics;
+} // namespace univariate
+
+namespace bivariate {
+    //! \ingroup Kernels
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(I first1, I last1, I first2) noexcept -> bivariate_statistics;
+
+    //! \ingroup Kernels
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(I first1, I last1, I first2, I weights) noexcept -> bivariate_statistics;
+
+    //! \ingroup Kernels
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(skip_nan_t /*unused*/, I first1, I last1, I first2) noexcept -> bivariate_statistics;
+
+    //! \ingroup Kernels
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(skip_nan_t /*unused*/, I first1, I last1, I first2, I weights) noexcept -> bivariate_statistics;
+} // namespace bivariate
+
+namespace metrics {
+#define VSTAT_KERNELS_DECLARE_METRIC(name)                                                  \
+    template<std::floating_point T, iterator<T> I>                                         \
+    auto name(I first1, I last1, I first2) noexcept -> double;                             \
+    template<std::floating_point T, iterator<T> I>                                         \
+    auto name(I first1, I last1, I first2, I weights) noexcept -> double;
+
+    //! \ingroup Kernels
+    VSTAT_KERNELS_DECLARE_METRIC(r2_score)
+    //! \ingroup Kernels
+    VSTAT_KERNELS_DECLARE_METRIC(mean_squared_error)
+    //! \ingroup Kernels
+    VSTAT_KERNELS_DECLARE_METRIC(mean_squared_log_error)
+    //! \ingroup Kernels
+    VSTAT_KERNELS_DECLARE_METRIC(mean_absolute_error)
+    //! \ingroup Kernels
+    VSTAT_KERNELS_DECLARE_METRIC(mean_absolute_percentage_error)
+    //! \ingroup Kernels
+    VSTAT_KERNELS_DECLARE_METRIC(poisson_neg_likelihood_loss)
+#undef VSTAT_KERNELS_DECLARE_METRIC
+} // namespace metrics
+
+// the explicit instantiations for the value type T and the iterator type I (`EXTERN` is `extern` for the
+// declarations and empty for the definitions in the library)
+#define VSTAT_KERNELS_METRIC(EXTERN, T, I, name)                                                                   \
+    EXTERN template auto metrics::name<T, I>(I, I, I) noexcept -> double;                                          \
+    EXTERN template auto metrics::name<T, I>(I, I, I, I) noexcept -> double;
+
+#define VSTAT_KERNELS_INSTANTIATE(EXTERN, T, I)                                                                    \
+    EXTERN template auto univariate::accumulate<T, I>(I, I) noexcept -> univariate_statistics;                     \
+    EXTERN template auto univariate::accumulate<T, I>(I, I, I) noexcept -> univariate_statistics;                  \
+    EXTERN template auto univariate::accumulate<T, I>(skip_nan_t, I, I) noexcept -> univariate_statistics;         \
+    EXTERN template auto univariate::accumulate<T, I>(skip_nan_t, I, I, I) noexcept -> univariate_statistics;      \
+    EXTERN template auto univariate::accumulate<T, I>(with_extrema_t, I, I) noexcept -> univariate_statistics;     \
+    EXTERN template auto bivariate::accumulate<T, I>(I, I, I) noexcept -> bivariate_statistics;                    \
+    EXTERN template auto bivariate::accumulate<T, I>(I, I, I, I) noexcept -> bivariate_statistics;                 \
+    EXTERN template auto bivariate::accumulate<T, I>(skip_nan_t, I, I, I) noexcept -> bivariate_statistics;        \
+    EXTERN template auto bivariate::accumulate<T, I>(skip_nan_t, I, I, I, I) noexcept -> bivariate_statistics;     \
+    VSTAT_KERNELS_METRIC(EXTERN, T, I, r2_score)                                                                   \
+    VSTAT_KERNELS_METRIC(EXTERN, T, I, mean_squared_error)                                                         \
+    VSTAT_KERNELS_METRIC(EXTERN, T, I, mean_squared_log_error)                                                     \
+    VSTAT_KERNELS_METRIC(EXTERN, T, I, mean_absolute_error)                                                        \
+    VSTAT_KERNELS_METRIC(EXTERN, T, I, mean_absolute_percentage_error)                                             \
+    VSTAT_KERNELS_METRIC(EXTERN, T, I, poisson_neg_likelihood_loss)
+
+#define VSTAT_KERNELS_INSTANTIATE_ALL(EXTERN)                                                                      \
+    VSTAT_KERNELS_INSTANTIATE(EXTERN, float, float const*)                                                         \
+    VSTAT_KERNELS_INSTANTIATE(EXTERN, float, float*)                                                               \
+    VSTAT_KERNELS_INSTANTIATE(EXTERN, float, std::span<float const>::iterator)                                     \
+    VSTAT_KERNELS_INSTANTIATE(EXTERN, float, std::span<float>::iterator)                                           \
+    VSTAT_KERNELS_INSTANTIATE(EXTERN, double, double const*)                                                       \
+    VSTAT_KERNELS_INSTANTIATE(EXTERN, double, double*)                                                             \
+    VSTAT_KERNELS_INSTANTIATE(EXTERN, double, std::span<double const>::iterator)                                   \
+    VSTAT_KERNELS_INSTANTIATE(EXTERN, double, std::span<double>::iterator)
+
+VSTAT_KERNELS_INSTANTIATE_ALL(extern)
+} // namespace VSTAT_NAMESPACE::kernels
+
+#endif
@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_MAPPED_HPP
+#define VSTAT_MAPPED_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "util.hpp"
+
+/*!
+    \defgroup Mapped Memory-mapped column files
+
+    \brief Zero-copy access to flat binary files of `float` or `double` columns
+
+    A `mapped_file` maps a whole file read-only into memory, so the accumulate methods can consume its values
+    directly through the `std::span` returned by `values` or `column`, without reading the file into a buffer first.
+    The pages are loaded by the operating system on first access, so the file may be larger than the available
+    memory. The single-threaded methods read the mapping front to back, and the `parallel_policy` overloads give
+    each thread a contiguous range of it:
+    \code{.cpp}
+    #include <vstat/mapped.hpp>
+    #include <vstat/vstat.hpp>
+
+    vstat::mapped_file file("data.f64");
+    auto x = file.values<double>();
+    auto stats = vstat::univariate::accumulate<double>(vstat::parallel_policy{}, x.begin(), x.end());
+    \endcode
+
+    The values are read in the byte order of the machine. This header is not included by `vstat/vstat.hpp`.
+*/
+
+namespace VSTAT_NAMESPACE {
+/*!
+    \ingroup Mapped
+
+    \brief Access pattern hints for the mapping (ignored where the platform does not support them)
+*/
+struct mapping_options {
+    bool sequential{ true }; // read ahead aggressively and drop the pages after access (MADV_SEQUENTIAL, FILE_FLAG_SEQUENTIAL_SCAN)
+    bool huge_pages{ true }; // map at a huge page boundary and request transparent huge pages (MADV_HUGEPAGE)
+    bool populate{ false };  // load the whole file when mapping it (MAP_POPULATE)
+};
+
+/*!
+    \ingroup Mapped
+
+    \brief A read-only memory mapping of a whole file
+*/
+class mapped_file {
+public:
+    mapped_file() = default;
+
+    /*!
+        \brief Maps the file at `path`, throws `std::system_error` if it cannot be opened or mapped
+    */
+    explicit mapped_file(std::filesystem::path const& path, mapping_options const& options = {})
+    {
+        map(path, options);
+    }
+
+    mapped_file(mapped_file const&) = delete;
+    auto operator=(mapped_file const&) -> mapped_file& = delete;
+
+    mapped_file(mapped_file&& other) noexcept
+        : data_{ std::exchange(other.data_, nullptr) }, size_{ std::exchange(other.size_, 0) } { }
+
+    auto operator=(mapped_file&& other) noexcept -> mapped_file&
+    {
+        if (this != &other) {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~mapped_file() { unmap(); }
+
+    //! \brief The size of the file in bytes
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+    [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+    [[nodiscard]] auto data() const noexcept -> std::byte const* { return data_; }
+    [[nodiscard]] auto bytes() const noexcept -> std::span<std::byte const> { return { data_, size_ }; }
+
+    /*!
+        \brief The values stored from byte `offset` to the end of the file
+
+        \tparam T The value type (`float` for float32, `double` for float64 files)
+
+        The offset must be a multiple of `sizeof(T)` and the file must hold a whole number of values after it.
+    */
+    template<std::floating_point T>
+    [[nodiscard]] auto values(std::size_t offset = 0) const -> std::span<T const>
+    {
+        VSTAT_EXPECT(offset <= size_ && offset % sizeof(T) == 0 && (size_ - offset) % sizeof(T) == 0);
+        return { as<T>(offset), (size_ - offset) / sizeof(T) };
+    }
+
+    /*!
+        \brief The column `index` of a column-major table of `rows` rows starting at byte `offset`
+
+        \tparam T The value type (`float` for float32, `double` for float64 files)
+
+        The column occupies the bytes `[offset + index * rows * sizeof(T), offset + (index + 1) * rows * sizeof(T))`,
+        which must lie within the file. The offset must be a multiple of `sizeof(T)`.
+    */
+    template<std::floating_point T>
+    [[nodiscard]] auto column(std::size_t index, std::size_t rows, std::size_t offset = 0) const -> std::span<T const>
+    {
+        // check the bounds before forming the byte offset of the column, so that the products cannot wrap around
+        VSTAT_EXPECT(offset % sizeof(T) == 0 && offset <= size_ && rows <= (size_ - offset) / sizeof(T));
+        auto const bytes = rows * sizeof(T);
+        VSTAT_EXPECT(bytes == 0 || index < (size_ - offset) / bytes);
+        return { as<T>(offset + index * bytes), rows };
+    }
+
+private:
+    template<typename T>
+    [[nodiscard]] auto as(std::size_t offset) const noexcept -> T const*
+    {
+        // the mapping is page-aligned, so the values are suitably aligned for any offset that is a multiple of sizeof(T)
+        return data_ == nullptr ? nullptr : reinterpret_cast<T const*>(data_ + offset); // NOLINT
+    }
+
+#if defined(_WIN32)
+    [[noreturn]] static void fail(std::filesystem::path const& path, char const* what)
+    {
+        throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(), std::string(what) + " " + path.string());
+    }
+
+    void map(std::filesystem::path const& path, mapping_options const& options)
+    {
+        DWORD const flags = options.sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL;
+        HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            fail(path, "cannot open");
+        }
+        LARGE_INTEGER size{};
+        if (::GetFileSizeEx(file, &size) == 0) {
+            ::CloseHandle(file);
+            fail(path, "cannot stat");
+        }
+        if (size.QuadPart == 0) { // empty files cannot be mapped
+            ::CloseHandle(file);
+            return;
+        }
+        // the view keeps the mapping alive, so both handles can be closed once it is created
+        HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(file);
+        if (mapping == nullptr) {
+            fail(path, "cannot map");
+        }
+        void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        ::CloseHandle(mapping);
+        if (view == nullptr) {
+            fail(path, "cannot map");
+        }
+        data_ = static_cast<std::byte const*>(view);
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        if (options.populate) {
+            WIN32_MEMORY_RANGE_ENTRY range{ view, size_ };
+            ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+        }
+    }
+
+    void unmap() noexcept
+    {
+        if (data_ != nullptr) {
+            ::UnmapViewOfFile(data_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+#else
+    static auto constexpr huge_page_size{ std::size_t{ 1 } << 21U };
+
+    [[noreturn]] static void fail(std::filesystem::path const& path, char const* what, int error)
+    {
+        throw std::system_error(error, std::generic_category(), std::string(what) + " " + path.string());
+    }
+
+    void map(std::filesystem::path const& path, mapping_options const& options)
+    {
+        int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC); // NOLINT
+        if (fd < 0) {
+            fail(path, "cannot open", errno);
+        }
+        struct ::stat st{};
+        if (::fstat(fd, &st) != 0) {
+            auto const error = errno;
+            ::close(fd);
+            fail(path, "cannot stat", error);
+        }
+        auto const size = static_cast<std::size_t>(st.st_size);
+        if (size == 0) { // empty files cannot be mapped
+            ::close(fd);
+            return;
+        }
+
+        int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+        if (options.populate) {
+            flags |= MAP_POPULATE;
+        }
+#endif
+        // huge pages can only back the parts of the mapping aligned to the huge page size: reserve a larger
+        // address range and map the file at its first aligned address
+        void* hint{ nullptr };
+        void* reserved{ MAP_FAILED };
+        auto const align = options.huge_pages && size >= huge_page_size;
+        if (align) {
+            reserved = ::mmap(nullptr, size + huge_page_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0); // NOLINT
+            if (reserved != MAP_FAILED) {
+                auto const address = reinterpret_cast<std::uintptr_t>(reserved); // NOLINT
+                hint = reinterpret_cast<void*>((address + huge_page_size - 1) & ~(huge_page_size - 1)); // NOLINT
+                flags |= MAP_FIXED;
+            }
+        }
+
+        void* addr = ::mmap(hint, size, PROT_READ, flags, fd, 0);
+        auto const error = errno;
+        ::close(fd); // the mapping keeps the file open
+        if (reserved != MAP_FAILED) {
+            // release the parts of the reservation before and after the file mapping (or all of it on failure)
+            auto* const first = static_cast<std::byte*>(reserved);
+            auto* const last = first + size + huge_page_size;
+            if (addr == MAP_FAILED) {
+                ::munmap(first, last - first);
+            } else {
+                auto const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+                auto* const begin = static_cast<std::byte*>(addr);
+                auto* const end = begin + (size + page - 1) / page * page;
+                if (first < begin) {
+                    ::munmap(first, begin - first);
+                }
+                if (end < last) {
+                    ::munmap(end, last - end);
+                }
+            }
+        }
+        if (addr == MAP_FAILED) {
+            fail(path, "cannot map", error);
+        }
+        data_ = static_cast<std::byte const*>(addr);
+        size_ = size;
+
+        // the advice is only a hint, failures are ignored
+        if (options.sequential) {
+            ::madvise(addr, size_, MADV_SEQUENTIAL);
+        }
+#if defined(MADV_HUGEPAGE)
+        if (align) {
+            ::madvise(addr, size_, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    void unmap() noexcept
+    {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<std::byte*>(data_), size_); // NOLINT
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+#endif
+
+    std::byte const* data_{ nullptr };
+    std::size_t size_{ 0 };
+};
+} // namespace VSTAT_NAMESPACE
+
+#endif
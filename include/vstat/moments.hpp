@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_MOMENTS_HPP
+#define VSTAT_MOMENTS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <tuple>
+
+#include "combine.hpp"
+
+namespace VSTAT_NAMESPACE {
+namespace detail {
+    // returns 1 / n or zero when n is zero
+    template<typename T>
+    inline auto reciprocal(T n) noexcept -> T
+    {
+        if constexpr (eve::simd_value<T>) {
+            return eve::if_else(n == T{0}, T{0}, T{1} / n);
+        } else {
+            return n == T{0} ? T{0} : T{1} / n;
+        }
+    }
+} // namespace detail
+
+/*!
+    \brief Accumulator for the central moments up to the fourth order
+
+    Keeps the weight sum, the mean and the sums of the second, third and fourth powers of the deviations from the
+    mean. The values are added with the online update and two states are merged with the pairwise formulas from
+    Pébay - Formulas for Robust, One-Pass Parallel Computation of Covariances and Arbitrary-Order Statistical
+    Moments (2008), eq. 2.1-2.4. This is a separate type so that the variance-only accumulators keep their cost.
+
+    \tparam T The value type (a scalar type or an `eve::wide` SIMD type, in which case the lanes are merged when
+              the statistics are computed)
+*/
+template <typename T>
+struct moments_accumulator {
+    static auto load_state(T sw, T mean, T m2, T m3, T m4) noexcept -> moments_accumulator<T> // NOLINT
+    {
+        moments_accumulator<T> acc;
+        acc.sum_w = sw;
+        acc.mean = mean;
+        acc.m2 = m2;
+        acc.m3 = m3;
+        acc.m4 = m4;
+        return acc;
+    }
+
+    static auto load_state(std::tuple<T, T, T, T, T> state) noexcept -> moments_accumulator<T>
+    {
+        auto [sw, mean, m2, m3, m4] = state;
+        return load_state(sw, mean, m2, m3, m4);
+    }
+
+    // converts the power sums s_k = sum w (x - c)^k of a partition with weight sum n into its central moments
+    static auto from_power_sums(T n, T c, T s1, T s2, T s3, T s4) noexcept -> moments_accumulator<T>
+    {
+        T const d = s1 * detail::reciprocal(n);
+        T const d2 = d * d;
+        return load_state(n, c + d, s2 - s1 * d,
+            s3 - 3 * d * s2 + 2 * n * d2 * d, // NOLINT
+            s4 - 4 * d * s3 + 6 * d2 * s2 - 3 * n * d2 * d2); // NOLINT
+    }
+
+    inline void operator()(T x) noexcept
+    {
+        T const n1 = sum_w;
+        sum_w += 1;
+        T const delta = x - mean;
+        T const delta_n = delta / sum_w;
+        T const delta_n2 = delta_n * delta_n;
+        T const term = delta * delta_n * n1;
+        mean += delta_n;
+        m4 += term * delta_n2 * (sum_w * sum_w - 3 * sum_w + 3) + 6 * delta_n2 * m2 - 4 * delta_n * m3; // NOLINT
+        m3 += term * delta_n * (sum_w - 2) - 3 * delta_n * m2; // NOLINT
+        m2 += term;
+    }
+
+    // a weighted value is merged as a partition of weight w with zero central moments
+    inline void operator()(T x, T w) noexcept
+    {
+        merge_state(w, x, T{0}, T{0}, T{0});
+    }
+
+    template<typename U>
+    requires eve::simd_value<T> && eve::simd_compatible_ptr<U, T>
+    inline void operator()(U const* x) noexcept
+    {
+        (*this)(T{x});
+    }
+
+    template<typename U>
+    requires eve::simd_value<T> && eve::simd_compatible_ptr<U, T>
+    inline void operator()(U const* x, U const* w) noexcept
+    {
+        (*this)(T{x}, T{w});
+    }
+
+    // merges the state of another accumulator into this one. for SIMD types the merge is performed lane-wise.
+    inline auto merge(moments_accumulator<T> const& other) noexcept -> moments_accumulator<T>&
+    {
+        merge_state(other.sum_w, other.mean, other.m2, other.m3, other.m4);
+        return *this;
+    }
+
+    inline auto operator+=(moments_accumulator<T> const& other) noexcept -> moments_accumulator<T>&
+    {
+        return merge(other);
+    }
+
+    // returns the raw (unreduced) state { sum_w, mean, m2, m3, m4 }
+    [[nodiscard]] auto state() const noexcept -> std::tuple<T, T, T, T, T>
+    {
+        return { sum_w, mean, m2, m3, m4 };
+    }
+
+    // merges the lanes (for SIMD types) and returns { sum_w, mean, m2, m3, m4 }
+    [[nodiscard]] auto stats() const noexcept -> std::tuple<double, double, double, double, double>
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            return { sum_w, mean, m2, m3, m4 };
+        } else {
+            moments_accumulator<double> acc;
+            for (auto i = 0; i < T::size(); ++i) {
+                acc += moments_accumulator<double>::load_state(sum_w.get(i), mean.get(i), m2.get(i), m3.get(i), m4.get(i));
+            }
+            return acc.stats();
+        }
+    }
+
+private:
+    inline void merge_state(T nb, T mean_b, T m2b, T m3b, T m4b) noexcept
+    {
+        T const na = sum_w;
+        T const n = na + nb;
+        T const inv = detail::reciprocal(n);
+        T const delta = mean_b - mean;
+        T const d = delta * inv;
+        T const nab = na * nb;
+
+        m4 += m4b + delta * d * d * d * nab * (na * na - nab + nb * nb)
+            + 6 * d * d * (na * na * m2b + nb * nb * m2) // NOLINT
+            + 4 * d * (na * m3b - nb * m3); // NOLINT
+        m3 += m3b + delta * d * d * nab * (na - nb) + 3 * d * (na * m2b - nb * m2); // NOLINT
+        m2 += m2b + delta * d * nab;
+        mean += delta * (nb * inv);
+        sum_w = n;
+    }
+
+    T sum_w{0};
+    T mean{0};
+    T m2{0};
+    T m3{0};
+    T m4{0};
+};
+
+/*!
+    \brief Statistics based on the central moments
+
+    The skewness and kurtosis are the population (biased) estimates \f$g_1 = \sqrt{n} M_3 / M_2^{3/2}\f$ and
+    \f$g_2 = n M_4 / M_2^2 - 3\f$ (excess kurtosis). The sample versions apply the usual bias corrections for
+    unweighted data (as in Excel or pandas).
+*/
+struct moments_statistics {
+    double count;
+    double mean;
+    double variance;
+    double sample_variance;
+    double skewness;
+    double kurtosis;
+    double sample_skewness;
+    double sample_kurtosis;
+
+    template <typename T>
+    explicit moments_statistics(T const& accumulator)
+    {
+        auto [n, m, m2, m3, m4] = accumulator.stats();
+        count = n;
+        mean = m;
+        variance = m2 / n;
+        sample_variance = m2 / (n - 1);
+        skewness = std::sqrt(n) * m3 / std::pow(m2, 1.5); // NOLINT
+        kurtosis = n * m4 / (m2 * m2) - 3; // NOLINT
+        sample_skewness = skewness * std::sqrt(n * (n - 1)) / (n - 2);
+        sample_kurtosis = ((n + 1) * kurtosis + 6) * (n - 1) / ((n - 2) * (n - 3)); // NOLINT
+    }
+};
+
+inline auto operator<<(std::ostream& os, moments_statistics const& stats) -> std::ostream&
+{
+    os << "count:          \t" << stats.count
+       << "\nmean:           \t" << stats.mean
+       << "\nvariance:       \t" << stats.variance
+       << "\nsample variance:\t" << stats.sample_variance
+       << "\nskewness:       \t" << stats.skewness
+       << "\nkurtosis:       \t" << stats.kurtosis
+       << "\nsample skewness:\t" << stats.sample_skewness
+       << "\nsample kurtosis:\t" << stats.sample_kurtosis
+       << "\n";
+    return os;
+}
+} // namespace VSTAT_NAMESPACE
+
+#endif
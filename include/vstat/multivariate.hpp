@@ -0,0 +1,323 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_MULTIVARIATE_HPP
+#define VSTAT_MULTIVARIATE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <iostream>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "combine.hpp"
+
+namespace VSTAT_NAMESPACE {
+/*!
+    \brief Multivariate accumulator object
+
+    Accumulates the sums and the co-moment matrix \f$C = \sum_i w_i (x_i - \bar{x})(x_i - \bar{x})^T\f$ of
+    `dim`-dimensional observations. Only the upper triangle of \f$C\f$ is stored, packed row by row.
+
+    The observations are buffered in blocks of `block_rows` rows. Each full block is centered on its own mean
+    and its co-moment matrix is computed with a register-tiled SIMD kernel, then the block is merged into the
+    running state with the pairwise formula (Schubert et al., eq. 21-26). Compared to updating \f$C\f$ for every
+    observation (a rank-1 update), this turns the bulk of the work into dot products over contiguous memory.
+
+    \tparam T The scalar value type of the observations, used for the `eve::wide<T>` SIMD type of the block
+              kernel. The running state is kept in double precision.
+*/
+template<std::floating_point T>
+struct multivariate_accumulator {
+    explicit multivariate_accumulator(std::size_t dim, std::size_t block_rows = default_block_rows)
+        : dim_{dim}
+        , dim_padded_{(dim + tile_i - 1) / tile_i * tile_i}
+        , rows_{std::max(lanes, (block_rows + lanes - 1) / lanes * lanes)}
+        , sum_x_(dim, 0.0)
+        , sum_xx_(dim * (dim + 1) / 2, 0.0)
+        , block_(dim_padded_ * rows_, T{0})
+        , weights_(rows_, T{0})
+        , sqrt_w_(rows_, T{0})
+        , block_x_(dim, 0.0)
+        , block_xx_(sum_xx_.size(), 0.0)
+        , delta_(dim, 0.0)
+    {
+    }
+
+    // adds a single observation (buffered)
+    inline void operator()(std::span<T const> x, T w = T{1}) noexcept
+    {
+        VSTAT_EXPECT(x.size() == dim_);
+        for (std::size_t i = 0; i < dim_; ++i) {
+            block_[i * rows_ + pending_] = x[i];
+        }
+        weights_[pending_] = w;
+        if (++pending_ == rows_) {
+            flush();
+        }
+    }
+
+    // adds `rows` observations from a matrix with arbitrary row and column strides (given in elements)
+    inline void operator()(T const* data, std::size_t rows, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride = 1) noexcept
+    {
+        add(data, rows, row_stride, col_stride, [](std::size_t) { return T{1}; });
+    }
+
+    // adds `rows` weighted observations from a matrix with arbitrary row and column strides (given in elements)
+    inline void operator()(T const* data, T const* weights, std::size_t rows, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride = 1) noexcept
+    {
+        add(data, rows, row_stride, col_stride, [&](std::size_t r) { return weights[r]; });
+    }
+
+    // folds the buffered observations into the running state
+    void flush() noexcept
+    {
+        if (pending_ == 0) {
+            return;
+        }
+        auto const n = std::exchange(pending_, 0UL);
+
+        double sw{0};
+        for (std::size_t r = 0; r < n; ++r) {
+            sw += weights_[r];
+        }
+        if (sw == 0) {
+            return;
+        }
+
+        // center each feature on the block mean and scale the rows by sqrt(w), so that C = Y^T Y
+        std::transform(weights_.begin(), weights_.begin() + n, sqrt_w_.begin(), [](auto w) { return std::sqrt(w); });
+        auto const k = (n + lanes - 1) / lanes * lanes;
+        for (std::size_t i = 0; i < dim_; ++i) {
+            T* y = block_.data() + i * rows_;
+            double s{0};
+            for (std::size_t r = 0; r < n; ++r) {
+                s += static_cast<double>(weights_[r]) * y[r];
+            }
+            block_x_[i] = s;
+            auto const mean = static_cast<T>(s / sw);
+            for (std::size_t r = 0; r < n; ++r) {
+                y[r] = sqrt_w_[r] * (y[r] - mean);
+            }
+            std::fill(y + n, y + k, T{0});
+        }
+
+        comoments(k, block_xx_);
+        merge_state(sw, block_x_, block_xx_);
+    }
+
+    // merges the state of another accumulator into this one (the dimensions must match)
+    inline auto merge(multivariate_accumulator<T> const& other) noexcept -> multivariate_accumulator<T>&
+    {
+        VSTAT_EXPECT(dim_ == other.dim_);
+        flush();
+        if (other.pending_ > 0) {
+            auto tmp = other;
+            tmp.flush();
+            merge_state(tmp.sum_w_, tmp.sum_x_, tmp.sum_xx_);
+        } else {
+            merge_state(other.sum_w_, other.sum_x_, other.sum_xx_);
+        }
+        return *this;
+    }
+
+    inline auto operator+=(multivariate_accumulator<T> const& other) noexcept -> multivariate_accumulator<T>&
+    {
+        return merge(other);
+    }
+
+    [[nodiscard]] auto dim() const noexcept { return dim_; }
+
+    // returns { sum_w, sum_x, sum_xx }, where sum_xx is the packed upper triangle of the co-moment matrix
+    [[nodiscard]] auto stats() const -> std::tuple<double, std::vector<double>, std::vector<double>>
+    {
+        if (pending_ > 0) {
+            auto tmp = *this;
+            tmp.flush();
+            return { tmp.sum_w_, tmp.sum_x_, tmp.sum_xx_ };
+        }
+        return { sum_w_, sum_x_, sum_xx_ };
+    }
+
+    // offset of row i in the packed upper triangle, the element (i, j) with j >= i is found at offset(i) + j - i
+    [[nodiscard]] static constexpr auto offset(std::size_t dim, std::size_t i) noexcept -> std::size_t
+    {
+        return i * dim - i * (i - 1) / 2;
+    }
+
+    static auto constexpr default_block_rows{ 256UL };
+
+private:
+    using wide = eve::wide<T>;
+    static auto constexpr lanes{ static_cast<std::size_t>(wide::size()) };
+    static auto constexpr tile_i{ 4UL };
+    static auto constexpr tile_j{ 2UL };
+
+    template<typename W>
+    inline void add(T const* data, std::size_t rows, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride, W&& weight) noexcept
+    {
+        for (std::size_t r = 0; r < rows; ++r) {
+            T const* x = data + static_cast<std::ptrdiff_t>(r) * row_stride;
+            for (std::size_t i = 0; i < dim_; ++i) {
+                block_[i * rows_ + pending_] = x[static_cast<std::ptrdiff_t>(i) * col_stride];
+            }
+            weights_[pending_] = weight(r);
+            if (++pending_ == rows_) {
+                flush();
+            }
+        }
+    }
+
+    // computes the upper triangle of Y^T Y for the first k (zero-padded) rows of the block. the dot products
+    // are computed in tiles of tile_i x tile_j features, so that each load feeds several multiply-adds and the
+    // accumulators stay in registers. every element of the upper triangle is written.
+    void comoments(std::size_t k, std::vector<double>& sxx) const noexcept
+    {
+        auto column = [&](std::size_t i) { return block_.data() + i * rows_; };
+
+        for (std::size_t i0 = 0; i0 < dim_; i0 += tile_i) {
+            for (std::size_t j0 = i0; j0 < dim_; j0 += tile_j) {
+                std::array<wide, tile_i * tile_j> acc;
+                acc.fill(wide{0});
+
+                for (std::size_t r = 0; r < k; r += lanes) {
+                    std::array<wide, tile_i> a;
+                    std::array<wide, tile_j> b;
+                    for (std::size_t u = 0; u < tile_i; ++u) {
+                        a[u] = wide{ column(i0 + u) + r };
+                    }
+                    for (std::size_t v = 0; v < tile_j; ++v) {
+                        b[v] = wide{ column(j0 + v) + r };
+                    }
+                    for (std::size_t u = 0; u < tile_i; ++u) {
+                        for (std::size_t v = 0; v < tile_j; ++v) {
+                            acc[u * tile_j + v] += a[u] * b[v];
+                        }
+                    }
+                }
+
+                for (std::size_t u = 0; u < tile_i && i0 + u < dim_; ++u) {
+                    auto const i = i0 + u;
+                    for (std::size_t v = 0; v < tile_j && j0 + v < dim_; ++v) {
+                        auto const j = j0 + v;
+                        if (j >= i) {
+                            sxx[offset(dim_, i) + j - i] = eve::reduce(acc[u * tile_j + v]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // C = Ca + Cb + f * d d^T, where d = nb * Sa - na * Sb and f = 1 / (na * nb * (na + nb)) (eq. 21-26)
+    void merge_state(double sw, std::span<double const> sx, std::span<double const> sxx) noexcept
+    {
+        auto const f = detail::combine_factor(sum_w_, sw);
+        auto& d = delta_;
+        for (std::size_t i = 0; i < dim_; ++i) {
+            d[i] = sw * sum_x_[i] - sum_w_ * sx[i];
+        }
+        for (std::size_t i = 0; i < dim_; ++i) {
+            auto* c = sum_xx_.data() + offset(dim_, i);
+            auto const* cb = sxx.data() + offset(dim_, i);
+            auto const fi = f * d[i];
+            for (std::size_t j = i; j < dim_; ++j) {
+                c[j - i] += cb[j - i] + fi * d[j];
+            }
+        }
+        for (std::size_t i = 0; i < dim_; ++i) {
+            sum_x_[i] += sx[i];
+        }
+        sum_w_ += sw;
+    }
+
+    std::size_t dim_;
+    std::size_t dim_padded_;
+    std::size_t rows_;
+    std::size_t pending_{0};
+
+    double sum_w_{0};
+    std::vector<double> sum_x_;
+    std::vector<double> sum_xx_;
+
+    // buffered observations, stored feature by feature (the padding features remain zero)
+    std::vector<T> block_;
+    std::vector<T> weights_;
+
+    // scratch buffers of flush and merge_state, sized once so that the block updates do not allocate
+    std::vector<T> sqrt_w_;
+    std::vector<double> block_x_;
+    std::vector<double> block_xx_;
+    std::vector<double> delta_;
+};
+
+/*!
+    \brief Multivariate statistics
+
+    The matrices are stored in row-major order as `dim` x `dim` arrays.
+*/
+struct multivariate_statistics {
+    std::size_t dim;
+    double count;
+    std::vector<double> sum;
+    std::vector<double> mean;
+    std::vector<double> covariance;
+    std::vector<double> sample_covariance;
+    std::vector<double> correlation;
+
+    template <typename T>
+    explicit multivariate_statistics(T const& accumulator)
+        : dim{accumulator.dim()}
+    {
+        auto [sw, sx, sxx] = accumulator.stats();
+        count = sw;
+        sum = std::move(sx);
+        mean.resize(dim);
+        std::transform(sum.begin(), sum.end(), mean.begin(), [&](auto s) { return s / sw; });
+
+        covariance.resize(dim * dim);
+        sample_covariance.resize(dim * dim);
+        correlation.resize(dim * dim);
+
+        auto comoment = [&](std::size_t i, std::size_t j) {
+            if (i > j) { std::swap(i, j); }
+            return sxx[T::offset(dim, i) + j - i];
+        };
+
+        for (std::size_t i = 0; i < dim; ++i) {
+            for (std::size_t j = 0; j < dim; ++j) {
+                auto const c = comoment(i, j);
+                auto const cii = comoment(i, i);
+                auto const cjj = comoment(j, j);
+                covariance[i * dim + j] = c / sw;
+                sample_covariance[i * dim + j] = c / (sw - 1);
+                correlation[i * dim + j] = (cii > 0 && cjj > 0) ? c / std::sqrt(cii * cjj) : static_cast<double>(cii == cjj);
+            }
+        }
+    }
+};
+
+inline auto operator<<(std::ostream& os, multivariate_statistics const& stats) -> std::ostream&
+{
+    auto print = [&](char const* name, std::vector<double> const& values, std::size_t cols) {
+        os << name;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            os << (i % cols == 0 ? "\n\t" : "\t") << values[i];
+        }
+        os << "\n";
+    };
+    os << "count:             \t" << stats.count << "\n";
+    print("mean:", stats.mean, stats.dim);
+    print("covariance:", stats.covariance, stats.dim);
+    print("sample covariance:", stats.sample_covariance, stats.dim);
+    print("correlation:", stats.correlation, stats.dim);
+    return os;
+}
+} // namespace VSTAT_NAMESPACE
+
+#endif
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_PARALLEL_HPP
+#define VSTAT_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "combine.hpp"
+#include "util.hpp"
+
+namespace VSTAT_NAMESPACE {
+/*!
+    \brief Execution policy for the multi-threaded `accumulate` overloads
+
+    The input range is split into at most `threads` contiguous chunks of at least `min_chunk_size` elements.
+    Each chunk is processed by its own worker and the partial results are merged in chunk order, therefore
+    the result is deterministic for a fixed number of threads.
+*/
+struct parallel_policy {
+    std::size_t threads{ std::max(1U, std::thread::hardware_concurrency()) };
+    std::size_t min_chunk_size{ 1UL << 16U };
+};
+
+namespace detail {
+    // splits [0, n) into chunks whose size is a multiple of `Align` and calls `func(begin, end)` for each
+    // chunk on a separate thread. the partial results are returned in chunk order.
+    template<std::size_t Align, typename Func>
+    auto parallel_chunks(parallel_policy const& policy, std::ptrdiff_t n, Func&& func)
+    {
+        using result_t = std::invoke_result_t<Func, std::ptrdiff_t, std::ptrdiff_t>;
+        auto constexpr align{ static_cast<std::ptrdiff_t>(Align) };
+
+        auto const grain = std::max(static_cast<std::ptrdiff_t>(policy.min_chunk_size), align);
+        auto const threads = std::max(static_cast<std::ptrdiff_t>(policy.threads), std::ptrdiff_t{1});
+        auto const k = std::clamp(n / grain, std::ptrdiff_t{1}, threads);
+        auto chunk = (n + k - 1) / k;
+        chunk += (align - chunk % align) % align;
+
+        // the partial results are not required to be default constructible
+        std::vector<std::optional<result_t>> partials(k);
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(k - 1);
+            for (auto i = std::ptrdiff_t{1}; i < k; ++i) {
+                auto const b = std::min(i * chunk, n);
+                auto const e = std::min(b + chunk, n);
+                workers.emplace_back([&, i, b, e]() { partials[i].emplace(func(b, e)); });
+            }
+            partials.front().emplace(func(std::ptrdiff_t{0}, std::min(chunk, n)));
+        } // workers join here
+
+        std::vector<result_t> results;
+        results.reserve(k);
+        for (auto& p : partials) {
+            results.push_back(std::move(*p));
+        }
+        return results;
+    }
+
+    // merges the partial states in order, using the pairwise formula from combine.hpp
+    template<typename State>
+    auto merge_partials(std::vector<State> const& partials) noexcept -> State
+    {
+        return std::accumulate(partials.begin() + 1, partials.end(), partials.front(), [](auto const& a, auto const& b) {
+            return combine(a, b);
+        });
+    }
+} // namespace detail
+} // namespace VSTAT_NAMESPACE
+
+#endif
@@ -0,0 +1,303 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_QUANTILE_HPP
+#define VSTAT_QUANTILE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <eve/wide.hpp>
+#include <eve/module/core.hpp>
+
+#include "util.hpp"
+
+namespace VSTAT_NAMESPACE {
+/*!
+    \brief Mergeable quantile sketch with bounded memory
+
+    Implements the KLL sketch (Karnin, Lang, Liberty - Optimal Quantile Approximation in Streams, 2016). The
+    values are kept in a hierarchy of compactors, where an item at level \f$h\f$ stands for \f$2^h\f$ values.
+    When the sketch is full, the lowest full level is sorted and every other item (starting at a random offset)
+    is promoted to the next level. The capacity of a level decreases geometrically (by a factor 2/3) with its
+    distance from the top, so the sketch holds about \f$4k\f$ items (plus a few per level) regardless of the
+    number of values, and the rank error of a quantile is about \f$1.7 / k\f$ (1% for the default \f$k = 200\f$).
+
+    Values are appended to the first level (SIMD vectors with a single store), which is only sorted when it is
+    compacted. The other levels are kept sorted by merging. NaN values are ignored.
+
+    \tparam T The value type of the items (`float` or `double`)
+*/
+template<std::floating_point T>
+struct quantile_sketch {
+    static auto constexpr default_k{ 200UL };
+
+    explicit quantile_sketch(std::size_t k = default_k)
+        : k_{std::max<std::size_t>(k, 8)}
+    {
+        grow();
+    }
+
+    // restores a sketch from its levels (as returned by `levels()`) and the extrema of the values
+    static auto load_state(std::size_t k, std::uint64_t count, T min, T max, std::vector<std::vector<T>> levels) -> quantile_sketch<T>
+    {
+        quantile_sketch<T> sketch(k);
+        sketch.count_ = count;
+        sketch.min_ = min;
+        sketch.max_ = max;
+        while (sketch.levels_.size() < levels.size()) {
+            sketch.grow();
+        }
+        for (std::size_t h = 0; h < levels.size(); ++h) {
+            sketch.levels_[h] = std::move(levels[h]);
+            std::sort(sketch.levels_[h].begin(), sketch.levels_[h].end());
+        }
+        sketch.update_size();
+        sketch.compress();
+        return sketch;
+    }
+
+    inline void operator()(T x)
+    {
+        if (std::isnan(x)) {
+            return;
+        }
+        levels_.front().push_back(x);
+        min_ = std::min(min_, x);
+        max_ = std::max(max_, x);
+        ++count_;
+        if (++size_ >= capacity_) {
+            compress();
+        }
+    }
+
+    template<eve::simd_value W>
+    requires std::same_as<typename W::value_type, T>
+    inline void operator()(W const& x)
+    {
+        auto& level = levels_.front();
+        auto const offset = level.size();
+        level.resize(offset + W::size());
+        eve::store(x, level.data() + offset);
+        if (eve::all(eve::is_not_nan(x))) {
+            min_ = std::min(min_, eve::minimum(x));
+            max_ = std::max(max_, eve::maximum(x));
+        } else {
+            // NaN lanes are stored and removed again (rare)
+            level.erase(std::remove_if(level.begin() + static_cast<std::ptrdiff_t>(offset), level.end(), [](T v) { return std::isnan(v); }), level.end());
+            for (auto i = offset; i < level.size(); ++i) {
+                min_ = std::min(min_, level[i]);
+                max_ = std::max(max_, level[i]);
+            }
+        }
+        auto const added = level.size() - offset;
+        count_ += added;
+        size_ += added;
+        if (size_ >= capacity_) {
+            compress();
+        }
+    }
+
+    // merges another sketch into this one. the sketches are not required to have the same parameter k.
+    inline auto merge(quantile_sketch<T> const& other) -> quantile_sketch<T>&
+    {
+        while (levels_.size() < other.levels_.size()) {
+            grow();
+        }
+        for (std::size_t h = 0; h < other.levels_.size(); ++h) {
+            auto& level = levels_[h];
+            auto const mid = static_cast<std::ptrdiff_t>(level.size());
+            level.insert(level.end(), other.levels_[h].begin(), other.levels_[h].end());
+            if (h > 0) {
+                std::inplace_merge(level.begin(), level.begin() + mid, level.end());
+            }
+        }
+        count_ += other.count_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        update_size();
+        compress();
+        return *this;
+    }
+
+    inline auto operator+=(quantile_sketch<T> const& other) -> quantile_sketch<T>&
+    {
+        return merge(other);
+    }
+
+    // the number of (non-NaN) values seen
+    [[nodiscard]] auto count() const noexcept -> std::uint64_t { return count_; }
+
+    [[nodiscard]] auto k() const noexcept -> std::size_t { return k_; }
+
+    // the exact extrema of the values (infinite if the sketch is empty)
+    [[nodiscard]] auto min() const noexcept -> T { return min_; }
+
+    [[nodiscard]] auto max() const noexcept -> T { return max_; }
+
+    // the items retained at each level, an item at level h has weight 2^h
+    [[nodiscard]] auto levels() const noexcept -> std::vector<std::vector<T>> const& { return levels_; }
+
+    // returns the approximate q-quantile (0 <= q <= 1), i.e. the smallest retained item whose rank is at least
+    // q * count. the extrema (q = 0 and q = 1) are exact. returns NaN if the sketch is empty.
+    [[nodiscard]] auto quantile(double q) const -> double
+    {
+        return quantiles(std::span<double const>{&q, 1}).front();
+    }
+
+    // returns the approximate quantiles for all the given fractions, sorting the retained items only once
+    [[nodiscard]] auto quantiles(std::span<double const> qs) const -> std::vector<double>
+    {
+        std::vector<double> result(qs.size(), std::numeric_limits<double>::quiet_NaN());
+        if (count_ == 0) {
+            return result;
+        }
+        auto const items = weighted_items();
+        // the total weight of the retained items equals count_
+        auto const total = static_cast<double>(items.back().second);
+        for (std::size_t i = 0; i < qs.size(); ++i) {
+            auto const q = std::clamp(qs[i], 0.0, 1.0);
+            if (q == 0 || q == 1) {
+                result[i] = static_cast<double>(q == 0 ? min_ : max_);
+                continue;
+            }
+            auto const target = q * total;
+            auto it = std::lower_bound(items.begin(), items.end(), target, [](auto const& item, double t) {
+                return static_cast<double>(item.second) < t;
+            });
+            result[i] = static_cast<double>(it == items.end() ? items.back().first : it->first);
+        }
+        return result;
+    }
+
+    // returns the approximate fraction of the values that are less than or equal to x
+    [[nodiscard]] auto rank(double x) const -> double
+    {
+        if (count_ == 0) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        std::uint64_t weight{0};
+        for (std::size_t h = 0; h < levels_.size(); ++h) {
+            weight += static_cast<std::uint64_t>(std::ranges::count_if(levels_[h], [&](T v) { return v <= x; })) << h;
+        }
+        return static_cast<double>(weight) / static_cast<double>(count_);
+    }
+
+private:
+    // the capacity of level h, which is smaller the further the level is from the top (but at least min_width,
+    // so that the lowest levels are not compacted every few values)
+    [[nodiscard]] auto level_capacity(std::size_t h) const noexcept -> std::size_t
+    {
+        return capacities_[h];
+    }
+
+    void grow()
+    {
+        levels_.emplace_back();
+        capacities_.resize(levels_.size());
+        capacity_ = 0;
+        for (std::size_t h = 0; h < levels_.size(); ++h) {
+            auto const depth = static_cast<double>(levels_.size() - h - 1);
+            capacities_[h] = std::max(min_width, static_cast<std::size_t>(std::ceil(std::pow(2.0 / 3.0, depth) * static_cast<double>(k_))));
+            if (h == 0) {
+                // the first level doubles as the insertion buffer, so it is sorted in batches of at least k values
+                capacities_[h] = std::max(capacities_[h], k_);
+            }
+            capacity_ += capacities_[h];
+        }
+    }
+
+    void update_size() noexcept
+    {
+        size_ = 0;
+        for (auto const& level : levels_) {
+            size_ += level.size();
+        }
+    }
+
+    // compacts the lowest full levels until the sketch is below its capacity
+    void compress()
+    {
+        while (size_ >= capacity_) {
+            for (std::size_t h = 0; h < levels_.size(); ++h) {
+                if (levels_[h].size() < level_capacity(h)) {
+                    continue;
+                }
+                if (h + 1 == levels_.size()) {
+                    grow();
+                }
+                compact(h);
+                break;
+            }
+            update_size();
+        }
+    }
+
+    // promotes every other item of the sorted level to the next one. with an odd number of items, the largest
+    // item stays at its level. only the first level needs sorting, the other levels are kept sorted.
+    void compact(std::size_t h)
+    {
+        auto& level = levels_[h];
+        auto& next = levels_[h + 1];
+        if (h == 0) {
+            std::sort(level.begin(), level.end());
+        }
+        auto const n = level.size() - level.size() % 2;
+        auto const mid = next.size();
+        for (auto i = static_cast<std::size_t>(random_bit()); i < n; i += 2) {
+            next.push_back(level[i]);
+        }
+        std::inplace_merge(next.begin(), next.begin() + static_cast<std::ptrdiff_t>(mid), next.end());
+        level.erase(level.begin(), level.begin() + static_cast<std::ptrdiff_t>(n));
+    }
+
+    // xorshift64
+    auto random_bit() noexcept -> std::uint64_t
+    {
+        seed_ ^= seed_ << 13U;
+        seed_ ^= seed_ >> 7U;
+        seed_ ^= seed_ << 17U;
+        return seed_ & 1U;
+    }
+
+    // the retained items sorted by value, paired with their cumulative weights
+    [[nodiscard]] auto weighted_items() const -> std::vector<std::pair<T, std::uint64_t>>
+    {
+        std::vector<std::pair<T, std::uint64_t>> items;
+        items.reserve(size_);
+        for (std::size_t h = 0; h < levels_.size(); ++h) {
+            for (auto v : levels_[h]) {
+                items.emplace_back(v, std::uint64_t{1} << h);
+            }
+        }
+        std::sort(items.begin(), items.end());
+        std::uint64_t sum{0};
+        for (auto& item : items) {
+            sum += item.second;
+            item.second = sum;
+        }
+        return items;
+    }
+
+    std::size_t k_;
+    std::uint64_t count_{0};
+    std::size_t size_{0};
+    std::size_t capacity_{0};
+    std::uint64_t seed_{0x9E3779B97F4A7C15ULL};
+    T min_{std::numeric_limits<T>::infinity()};
+    T max_{-std::numeric_limits<T>::infinity()};
+    std::vector<std::vector<T>> levels_;
+    std::vector<std::size_t> capacities_;
+
+    static auto constexpr min_width{ 8UL };
+};
+} // namespace VSTAT_NAMESPACE
+
+#endif
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_ROLLING_HPP
+#define VSTAT_ROLLING_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+
+#include "util.hpp"
+
+namespace VSTAT_NAMESPACE {
+/*!
+    \brief State of a sliding window of fixed size over one sequence
+
+    Keeps the mean and the sum of squared residuals of the last `window` values. Sliding the window replaces the
+    oldest value with a new one in a single update (a combined removal and addition of the Welford kind):
+    \f$\delta = x_{new} - x_{old}\f$, \f$\mu' = \mu + \delta / w\f$ and
+    \f$M_2' = M_2 + \delta (x_{new} - \mu' + x_{old} - \mu)\f$. The rounding errors of the updates accumulate, so
+    the state should be recomputed from the window values every `recompute_interval(window)` updates.
+
+    \tparam T The value type
+*/
+template<std::floating_point T>
+struct rolling_accumulator {
+    explicit rolling_accumulator(std::size_t window) noexcept
+        : inv_{T{1} / static_cast<T>(window)}
+    {
+        VSTAT_EXPECT(window > 0);
+    }
+
+    // the number of updates after which the exact state is recomputed (at most 1/8 of the cost of the updates)
+    static auto constexpr recompute_interval(std::size_t window) noexcept -> std::size_t
+    {
+        return std::max<std::size_t>(8 * window, 1024); // NOLINT
+    }
+
+    // sets the state of the window (e.g. computed exactly from its values)
+    inline void load_state(T mean, T ssr) noexcept
+    {
+        mean_ = mean;
+        ssr_ = ssr;
+    }
+
+    // slides the window: `x_old` leaves and `x_new` enters it
+    inline void replace(T x_old, T x_new) noexcept
+    {
+        T const delta = x_new - x_old;
+        T const mean = mean_ + delta * inv_;
+        ssr_ += delta * (x_new - mean + x_old - mean_);
+        mean_ = mean;
+    }
+
+    [[nodiscard]] auto mean() const noexcept -> T { return mean_; }
+
+    // the sum of squared residuals (clamped at zero, since the updates may leave a tiny negative residue)
+    [[nodiscard]] auto ssr() const noexcept -> T { return std::max(ssr_, T{0}); }
+
+    [[nodiscard]] auto variance() const noexcept -> T { return ssr() * inv_; }
+
+private:
+    T inv_;
+    T mean_{0};
+    T ssr_{0};
+};
+
+/*!
+    \brief State of a sliding window of fixed size over two sequences
+
+    Keeps the means, the sums of squared residuals and the co-moment
+    \f$C = \sum (x - \mu_x)(y - \mu_y)\f$ of the last `window` pairs. Sliding the window updates the co-moment as
+    \f$C' = C + (x_{new} - \mu_x)(y_{new} - \mu_y) - (x_{old} - \mu_x)(y_{old} - \mu_y) - \delta_x \delta_y / w\f$,
+    with the means before the update (and likewise for the sums of squared residuals).
+
+    \tparam T The value type
+*/
+template<std::floating_point T>
+struct rolling_bivariate_accumulator {
+    explicit rolling_bivariate_accumulator(std::size_t window) noexcept
+        : inv_{T{1} / static_cast<T>(window)}
+    {
+        VSTAT_EXPECT(window > 0);
+    }
+
+    inline void load_state(T mean_x, T mean_y, T ssr_x, T ssr_y, T sxy) noexcept
+    {
+        mean_x_ = mean_x;
+        mean_y_ = mean_y;
+        ssr_x_ = ssr_x;
+        ssr_y_ = ssr_y;
+        sxy_ = sxy;
+    }
+
+    inline void replace(T x_old, T y_old, T x_new, T y_new) noexcept
+    {
+        T const dx = x_new - x_old;
+        T const dy = y_new - y_old;
+        T const ax = x_new - mean_x_;
+        T const ay = y_new - mean_y_;
+        T const bx = x_old - mean_x_;
+        T const by = y_old - mean_y_;
+        ssr_x_ += ax * ax - bx * bx - dx * dx * inv_;
+        ssr_y_ += ay * ay - by * by - dy * dy * inv_;
+        sxy_ += ax * ay - bx * by - dx * dy * inv_;
+        mean_x_ += dx * inv_;
+        mean_y_ += dy * inv_;
+    }
+
+    [[nodiscard]] auto mean_x() const noexcept -> T { return mean_x_; }
+
+    [[nodiscard]] auto mean_y() const noexcept -> T { return mean_y_; }
+
+    [[nodiscard]] auto covariance() const noexcept -> T { return sxy_ * inv_; }
+
+    // the correlation, with the same convention as `bivariate_statistics` for constant windows
+    [[nodiscard]] auto correlation() const noexcept -> T
+    {
+        T const sxx = std::max(ssr_x_, T{0});
+        T const syy = std::max(ssr_y_, T{0});
+        if (std::isnan(sxx + syy + sxy_)) {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+        if (!(sxx > 0 && syy > 0)) {
+            return static_cast<T>(sxx == syy);
+        }
+        return std::clamp(sxy_ / std::sqrt(sxx * syy), T{-1}, T{1});
+    }
+
+private:
+    T inv_;
+    T mean_x_{0};
+    T mean_y_{0};
+    T ssr_x_{0};
+    T ssr_y_{0};
+    T sxy_{0};
+};
+} // namespace VSTAT_NAMESPACE
+
+#endif
@@ -0,0 +1,428 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_SERIALIZE_HPP
+#define VSTAT_SERIALIZE_HPP
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "bivariate.hpp"
+#include "quantile.hpp"
+#include "univariate.hpp"
+
+/*
+    Binary format of a serialized accumulator state (all the values are stored in little-endian byte order):
+
+    offset  size  description
+    0       4     magic bytes "VSTA"
+    4       2     format version
+    6       1     accumulator kind (1: univariate, 2: bivariate)
+    7       1     value type (1: float32, 2: float64)
+    8       2     number of lanes L (1 for scalar or reduced states, the SIMD width otherwise)
+    10      2     number of fields K (3 for univariate, 6 for bivariate)
+    12      4     reserved (zero)
+    16      ...   K x L values, field by field, in the order of the accumulator's `state()`
+
+    Quantile sketches (kind 3) have a variable number of items per level and use the header fields differently:
+    L is 1, K is the number of levels H and the reserved bytes hold the sketch parameter k. The header is followed
+    by the number of values seen (8 bytes), the minimum and maximum values, the number of items of each level
+    (H x 4 bytes) and the items, level by level.
+*/
+namespace VSTAT_NAMESPACE {
+namespace detail::serialization {
+    inline constexpr std::array<std::byte, 4> magic{ std::byte{'V'}, std::byte{'S'}, std::byte{'T'}, std::byte{'A'} };
+    inline constexpr std::uint16_t version{ 1 };
+    inline constexpr std::size_t header_size{ 16 };
+
+    enum class accumulator_kind : std::uint8_t { univariate = 1, bivariate = 2, quantile_sketch = 3 };
+    enum class value_type : std::uint8_t { float32 = 1, float64 = 2 };
+
+    template<typename A> struct accumulator_traits;
+
+    template<typename T, typename S> struct accumulator_traits<univariate_accumulator<T, S>> {
+        static auto constexpr kind{ accumulator_kind::univariate };
+        static auto constexpr fields{ 3UL };
+
+        static auto from_state(std::array<T, fields> const& s) noexcept {
+            return univariate_accumulator<T, S>::load_state(s[0], s[1], s[2]);
+        }
+    };
+
+    template<typename T, typename S> struct accumulator_traits<bivariate_accumulator<T, S>> {
+        static auto constexpr kind{ accumulator_kind::bivariate };
+        static auto constexpr fields{ 6UL };
+
+        // load_state expects { sum_x, sum_y, sum_w, ... } while state() returns { sum_w, sum_x, sum_y, ... }
+        static auto from_state(std::array<T, fields> const& s) noexcept {
+            return bivariate_accumulator<T, S>::load_state(s[1], s[2], s[0], s[3], s[4], s[5]);
+        }
+    };
+
+    template<typename V> struct lane_traits {
+        using element_type = V;
+        static auto constexpr lanes{ 1UL };
+        static auto get(V v, std::size_t /*unused*/) noexcept -> V { return v; }
+    };
+
+    template<eve::simd_value V> struct lane_traits<V> {
+        using element_type = typename V::value_type;
+        static auto constexpr lanes{ static_cast<std::size_t>(V::size()) };
+        static auto get(V const& v, std::size_t i) noexcept -> element_type { return v.get(i); }
+    };
+
+    template<std::floating_point E>
+    inline constexpr auto type_code{ sizeof(E) == 4 ? value_type::float32 : value_type::float64 };
+
+    template<std::unsigned_integral U>
+    inline auto store(std::byte* p, U value) noexcept -> void {
+        for (std::size_t i = 0; i < sizeof(U); ++i) {
+            p[i] = static_cast<std::byte>((value >> (8 * i)) & 0xFFU);
+        }
+    }
+
+    template<std::unsigned_integral U>
+    inline auto load(std::byte const* p) noexcept -> U {
+        U value{0};
+        for (std::size_t i = 0; i < sizeof(U); ++i) {
+            value |= static_cast<U>(std::to_integer<U>(p[i]) << (8 * i));
+        }
+        return value;
+    }
+
+    template<std::floating_point E>
+    inline auto store_value(std::byte* p, E value) noexcept -> void {
+        using U = std::conditional_t<sizeof(E) == 4, std::uint32_t, std::uint64_t>;
+        store(p, std::bit_cast<U>(value));
+    }
+
+    template<std::floating_point E>
+    inline auto load_value(std::byte const* p) noexcept -> E {
+        using U = std::conditional_t<sizeof(E) == 4, std::uint32_t, std::uint64_t>;
+        return std::bit_cast<E>(load<U>(p));
+    }
+
+    // writes the header and the K x L values given by `value(field, lane)`, returns the number of bytes written
+    template<std::floating_point E, typename F>
+    inline auto write(std::span<std::byte> buffer, accumulator_kind k, std::size_t lanes, std::size_t fields, F&& value) noexcept -> std::size_t {
+        auto const size = header_size + lanes * fields * sizeof(E);
+        VSTAT_EXPECT(buffer.size() >= size);
+
+        auto* p = buffer.data();
+        std::copy(magic.begin(), magic.end(), p);
+        store(p + 4, version);
+        p[6] = static_cast<std::byte>(k);
+        p[7] = static_cast<std::byte>(type_code<E>);
+        store(p + 8, static_cast<std::uint16_t>(lanes));
+        store(p + 10, static_cast<std::uint16_t>(fields));
+        store(p + 12, std::uint32_t{0});
+
+        p += header_size;
+        for (std::size_t f = 0; f < fields; ++f) {
+            for (std::size_t l = 0; l < lanes; ++l, p += sizeof(E)) {
+                store_value<E>(p, value(f, l));
+            }
+        }
+        return size;
+    }
+
+    // a parsed serialized state, the values are converted to double precision
+    struct payload {
+        std::size_t size; // number of bytes consumed
+        std::size_t lanes;
+        std::size_t fields;
+        std::vector<double> values; // field by field
+
+        [[nodiscard]] auto get(std::size_t field, std::size_t lane) const noexcept -> double { return values[field * lanes + lane]; }
+    };
+
+    // parses a serialized state of the given kind, returns an empty payload (size zero) if the data is not valid
+    inline auto read(std::span<std::byte const> bytes, accumulator_kind k, std::size_t fields) -> payload {
+        payload invalid{ 0, 0, 0, {} };
+        if (bytes.size() < header_size || !std::equal(magic.begin(), magic.end(), bytes.begin())) {
+            return invalid;
+        }
+        auto const* p = bytes.data();
+        auto const type = static_cast<value_type>(p[7]);
+        auto const lanes = load<std::uint16_t>(p + 8);
+        if (load<std::uint16_t>(p + 4) != version || static_cast<accumulator_kind>(p[6]) != k || load<std::uint16_t>(p + 10) != fields || lanes == 0) {
+            return invalid;
+        }
+        if (type != value_type::float32 && type != value_type::float64) {
+            return invalid;
+        }
+        auto const width = type == value_type::float32 ? sizeof(float) : sizeof(double);
+        auto const size = header_size + lanes * fields * width;
+        if (bytes.size() < size) {
+            return invalid;
+        }
+
+        payload result{ size, lanes, fields, std::vector<double>(lanes * fields) };
+        p += header_size;
+        for (auto& v : result.values) {
+            v = type == value_type::float32 ? load_value<float>(p) : load_value<double>(p);
+            p += width;
+        }
+        return result;
+    }
+} // namespace detail::serialization
+
+/*!
+    \brief Returns the number of bytes needed to serialize the accumulator
+
+    \param acc     The accumulator (univariate or bivariate, scalar or SIMD)
+    \param reduced If true, the size of the reduced state (a single lane in double precision) is returned
+*/
+template<typename A>
+inline auto serialized_size(A const& acc, bool reduced = false) noexcept -> std::size_t {
+    using namespace detail::serialization;
+    using V = std::tuple_element_t<0, decltype(acc.state())>;
+    using lane = lane_traits<V>;
+    auto constexpr fields{ accumulator_traits<A>::fields };
+    return reduced
+        ? header_size + fields * sizeof(double)
+        : header_size + fields * lane::lanes * sizeof(typename lane::element_type);
+}
+
+/*!
+    \brief Serializes the state of an accumulator into a caller-supplied buffer
+
+    \param acc    The accumulator (univariate or bivariate, scalar or SIMD)
+    \param buffer The output buffer, which must be at least `serialized_size(acc)` bytes large
+
+    The state of every SIMD lane is stored in the precision of the accumulator, so nothing is lost to an early
+    reduction (the error terms of compensated accumulators are folded into the sums). Returns the number of
+    bytes written.
+*/
+template<typename A>
+inline auto serialize(A const& acc, std::span<std::byte> buffer) noexcept -> std::size_t {
+    using namespace detail::serialization;
+    using V = std::tuple_element_t<0, decltype(acc.state())>;
+    using lane = lane_traits<V>;
+    auto constexpr fields{ accumulator_traits<A>::fields };
+
+    auto const state = std::apply([](auto const&... v) { return std::array<V, fields>{ v... }; }, acc.state());
+    return write<typename lane::element_type>(buffer, accumulator_traits<A>::kind, lane::lanes, fields, [&](auto f, auto l) {
+        return lane::get(state[f], l);
+    });
+}
+
+/*!
+    \brief Serializes the reduced state of an accumulator (one lane in double precision)
+
+    \param acc    The accumulator (univariate or bivariate, scalar or SIMD)
+    \param buffer The output buffer, which must be at least `serialized_size(acc, true)` bytes large
+
+    Returns the number of bytes written.
+*/
+template<typename A>
+inline auto serialize_reduced(A const& acc, std::span<std::byte> buffer) noexcept -> std::size_t {
+    using namespace detail::serialization;
+    auto constexpr fields{ accumulator_traits<A>::fields };
+
+    auto const state = std::apply([](auto const&... v) { return std::array<double, fields>{ v... }; }, acc.stats());
+    return write<double>(buffer, accumulator_traits<A>::kind, 1, fields, [&](auto f, auto /*unused*/) {
+        return state[f];
+    });
+}
+
+/*!
+    \brief Merges a serialized state into an accumulator
+
+    \param acc   The accumulator (univariate or bivariate, scalar or SIMD)
+    \param bytes The serialized state, as written by `serialize` or `serialize_reduced`
+
+    The serialized state does not need to have the same value type or number of lanes as the accumulator. When
+    the number of lanes matches, the states are merged lane by lane. Otherwise the serialized lanes are merged
+    sequentially into a scalar accumulator (or into the first lane of a SIMD accumulator).
+
+    Returns the number of bytes consumed (serialized states can be concatenated), or zero if the data is not a
+    valid serialized state of the same kind of accumulator, in which case `acc` is left unchanged.
+*/
+template<typename A>
+inline auto merge_serialized(A& acc, std::span<std::byte const> bytes) -> std::size_t {
+    using namespace detail::serialization;
+    using traits = accumulator_traits<A>;
+    using V = std::tuple_element_t<0, decltype(acc.state())>;
+    using lane = lane_traits<V>;
+    using E = typename lane::element_type;
+    auto constexpr fields{ traits::fields };
+    auto constexpr lanes{ lane::lanes };
+
+    auto const p = read(bytes, traits::kind, fields);
+    if (p.size == 0) {
+        return 0;
+    }
+
+    if constexpr (eve::simd_value<V>) {
+        std::array<std::array<E, lanes>, fields> values{};
+        if (p.lanes == lanes) {
+            for (std::size_t f = 0; f < fields; ++f) {
+                for (std::size_t l = 0; l < lanes; ++l) {
+                    values[f][l] = static_cast<E>(p.get(f, l));
+                }
+            }
+        } else {
+            // fold the serialized lanes together, then merge the result into the first lane
+            using scalar_traits = accumulator_traits<std::conditional_t<fields == 3, univariate_accumulator<double>, bivariate_accumulator<double>>>;
+            auto folded = scalar_traits::from_state({});
+            for (std::size_t l = 0; l < p.lanes; ++l) {
+                std::array<double, fields> s{};
+                for (std::size_t f = 0; f < fields; ++f) { s[f] = p.get(f, l); }
+                folded += scalar_traits::from_state(s);
+            }
+            auto const state = folded.state();
+            std::apply([&](auto const&... v) {
+                std::size_t f{0};
+                ((values[f++][0] = static_cast<E>(v)), ...);
+            }, state);
+        }
+        std::array<V, fields> state{};
+        for (std::size_t f = 0; f < fields; ++f) {
+            state[f] = V{ values[f].data() };
+        }
+        acc += traits::from_state(state);
+    } else {
+        for (std::size_t l = 0; l < p.lanes; ++l) {
+            std::array<V, fields> s{};
+            for (std::size_t f = 0; f < fields; ++f) { s[f] = static_cast<V>(p.get(f, l)); }
+            acc += traits::from_state(s);
+        }
+    }
+    return p.size;
+}
+
+/*!
+    \brief Returns the number of bytes needed to serialize the quantile sketch
+*/
+template<std::floating_point T>
+inline auto serialized_size(quantile_sketch<T> const& sketch) noexcept -> std::size_t {
+    using namespace detail::serialization;
+    std::size_t items{0};
+    for (auto const& level : sketch.levels()) {
+        items += level.size();
+    }
+    return header_size + sizeof(std::uint64_t) + sketch.levels().size() * sizeof(std::uint32_t) + (items + 2) * sizeof(T);
+}
+
+/*!
+    \brief Serializes a quantile sketch into a caller-supplied buffer
+
+    \param sketch The quantile sketch
+    \param buffer The output buffer, which must be at least `serialized_size(sketch)` bytes large
+
+    Returns the number of bytes written.
+*/
+template<std::floating_point T>
+inline auto serialize(quantile_sketch<T> const& sketch, std::span<std::byte> buffer) noexcept -> std::size_t {
+    using namespace detail::serialization;
+    auto const size = serialized_size(sketch);
+    VSTAT_EXPECT(buffer.size() >= size);
+
+    auto const& levels = sketch.levels();
+    auto* p = buffer.data();
+    std::copy(magic.begin(), magic.end(), p);
+    store(p + 4, version);
+    p[6] = static_cast<std::byte>(accumulator_kind::quantile_sketch);
+    p[7] = static_cast<std::byte>(type_code<T>);
+    store(p + 8, std::uint16_t{1});
+    store(p + 10, static_cast<std::uint16_t>(levels.size()));
+    store(p + 12, static_cast<std::uint32_t>(sketch.k()));
+
+    p += header_size;
+    store(p, sketch.count());
+    p += sizeof(std::uint64_t);
+    store_value<T>(p, sketch.min());
+    store_value<T>(p + sizeof(T), sketch.max());
+    p += 2 * sizeof(T);
+    for (auto const& level : levels) {
+        store(p, static_cast<std::uint32_t>(level.size()));
+        p += sizeof(std::uint32_t);
+    }
+    for (auto const& level : levels) {
+        for (auto v : level) {
+            store_value<T>(p, v);
+            p += sizeof(T);
+        }
+    }
+    return size;
+}
+
+/*!
+    \brief Merges a serialized quantile sketch into a sketch
+
+    \param sketch The quantile sketch
+    \param bytes  The serialized sketch, as written by `serialize`
+
+    The serialized sketch does not need to have the same value type or parameter k. Returns the number of bytes
+    consumed, or zero if the data is not a valid serialized quantile sketch, in which case `sketch` is left
+    unchanged.
+*/
+template<std::floating_point T>
+inline auto merge_serialized(quantile_sketch<T>& sketch, std::span<std::byte const> bytes) -> std::size_t {
+    using namespace detail::serialization;
+    if (bytes.size() < header_size || !std::equal(magic.begin(), magic.end(), bytes.begin())) {
+        return 0;
+    }
+    auto const* p = bytes.data();
+    auto const type = static_cast<value_type>(p[7]);
+    if (load<std::uint16_t>(p + 4) != version || static_cast<accumulator_kind>(p[6]) != accumulator_kind::quantile_sketch) {
+        return 0;
+    }
+    if (type != value_type::float32 && type != value_type::float64) {
+        return 0;
+    }
+    auto const width = type == value_type::float32 ? sizeof(float) : sizeof(double);
+    auto const h = std::size_t{ load<std::uint16_t>(p + 10) };
+    auto const k = std::size_t{ load<std::uint32_t>(p + 12) };
+    auto const levels_offset = header_size + sizeof(std::uint64_t) + 2 * width;
+    if (bytes.size() < levels_offset) {
+        return 0;
+    }
+    auto read_value = [&](std::size_t offset) {
+        return static_cast<T>(type == value_type::float32 ? load_value<float>(p + offset) : load_value<double>(p + offset));
+    };
+    auto const count = load<std::uint64_t>(p + header_size);
+    auto const min = read_value(header_size + sizeof(std::uint64_t));
+    auto const max = read_value(header_size + sizeof(std::uint64_t) + width);
+
+    auto offset = levels_offset;
+    if (h > std::numeric_limits<std::uint64_t>::digits || bytes.size() < offset + h * sizeof(std::uint32_t)) {
+        return 0;
+    }
+    // the total weight of the items (an item at level i has weight 2^i) must match the number of values
+    std::vector<std::vector<T>> levels(h);
+    std::size_t items{0};
+    std::uint64_t weight{0};
+    for (std::size_t i = 0; i < h; ++i, offset += sizeof(std::uint32_t)) {
+        auto const n = std::size_t{ load<std::uint32_t>(p + offset) };
+        items += n;
+        weight += static_cast<std::uint64_t>(n) << i;
+    }
+    if (weight != count || bytes.size() < offset + items * width) {
+        return 0;
+    }
+    offset = levels_offset;
+    for (std::size_t i = 0; i < h; ++i, offset += sizeof(std::uint32_t)) {
+        levels[i].resize(load<std::uint32_t>(p + offset));
+    }
+    for (auto& level : levels) {
+        for (auto& v : level) {
+            v = read_value(offset);
+            offset += width;
+        }
+    }
+    sketch += quantile_sketch<T>::load_state(k, count, min, max, std::move(levels));
+    return offset;
+}
+} // namespace VSTAT_NAMESPACE
+
+#endif
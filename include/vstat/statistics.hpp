@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_STATISTICS_HPP
+#define VSTAT_STATISTICS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <tuple>
+
+#include "util.hpp"
+
+// the result types of the accumulate methods (they do not depend on EVE)
+namespace VSTAT_NAMESPACE {
+/*!
+    \brief Univariate statistics
+*/
+struct univariate_statistics {
+    double count;
+    double sum;
+    double ssr;
+    double mean;
+    double variance;
+    double sample_variance;
+    std::size_t skipped{0}; // values left out by the masked and NaN-aware methods
+    // the extrema and their positions are only computed by the `with_extrema` methods (NaN and -1 otherwise)
+    double min{std::numeric_limits<double>::quiet_NaN()};
+    double max{std::numeric_limits<double>::quiet_NaN()};
+    std::int64_t argmin{-1};
+    std::int64_t argmax{-1};
+
+    template <typename T>
+    explicit univariate_statistics(T const& accumulator)
+    {
+        auto [sw, sx, sxx] = accumulator.stats();
+        count = sw;
+        sum = sx;
+        ssr = sxx;
+        mean = sx / sw;
+        variance = sxx / sw;
+        sample_variance = sxx / (sw - 1);
+    }
+
+    template <typename T, typename E>
+    univariate_statistics(T const& accumulator, E const& extrema)
+        : univariate_statistics(accumulator)
+    {
+        std::tie(std::ignore, min, max, argmin, argmax) = extrema.stats();
+    }
+};
+
+inline auto operator<<(std::ostream& os, univariate_statistics const& stats) -> std::ostream&
+{
+    os << "count:          \t" << stats.count
+       << "\nsum:            \t" << stats.sum
+       << "\nssr:            \t" << stats.ssr
+       << "\nmean:           \t" << stats.mean
+       << "\nvariance:       \t" << stats.variance
+       << "\nsample variance:\t" << stats.sample_variance
+       << "\n";
+    if (stats.argmin >= 0) {
+        os << "min:            \t" << stats.min << " (at " << stats.argmin << ")"
+           << "\nmax:            \t" << stats.max << " (at " << stats.argmax << ")"
+           << "\n";
+    }
+    return os;
+}
+
+/*!
+    \brief Bivariate statistics
+*/
+struct bivariate_statistics {
+    double count;
+    double sum_x;
+    double sum_y;
+    double ssr_x;
+    double ssr_y;
+    double sum_xy;
+    double mean_x;
+    double mean_y;
+    double variance_x;
+    double variance_y;
+    double sample_variance_x;
+    double sample_variance_y;
+    double correlation;
+    double covariance;
+    double sample_covariance;
+    std::size_t skipped{0}; // pairs left out by the masked and NaN-aware methods
+
+    template <typename T>
+    explicit bivariate_statistics(T accumulator)
+    {
+        auto [sw, sx, sy, sxx, syy, sxy] = accumulator.stats();
+        count = sw;
+        sum_x = sx;
+        sum_y = sy;
+        ssr_x = sxx;
+        ssr_y = syy;
+        sum_xy = sxy;
+        mean_x = sx / sw;
+        mean_y = sy / sw;
+        variance_x = sxx / sw;
+        variance_y = syy / sw;
+        sample_variance_x = sxx / (sw - 1);
+        sample_variance_y = syy / (sw - 1);
+
+        if (!(sxx > 0 && syy > 0)) {
+            correlation = static_cast<double>(sxx == syy);
+        } else {
+            correlation = sxy / std::sqrt(sxx * syy);
+        }
+
+        covariance = sxy / sw;
+        sample_covariance = sxy / (sw - 1);
+    }
+};
+
+inline auto operator<<(std::ostream& os, bivariate_statistics const& stats) -> std::ostream&
+{
+    os << "count:              \t" << stats.count
+       << "\nsum_x:            \t" << stats.sum_x
+       << "\nssr_x:            \t" << stats.ssr_x
+       << "\nmean_x:           \t" << stats.mean_x
+       << "\nvariance_x:       \t" << stats.variance_x
+       << "\nsample variance_x:\t" << stats.sample_variance_x
+       << "\nsum_y:            \t" << stats.sum_y
+       << "\nssr_y:            \t" << stats.ssr_y
+       << "\nmean_y:           \t" << stats.mean_y
+       << "\nvariance_y:       \t" << stats.variance_y
+       << "\nsample variance_y:\t" << stats.sample_variance_y
+       << "\ncorrelation:      \t" << stats.correlation
+       << "\ncovariance:       \t" << stats.covariance
+       << "\nsample covariance:\t" << stats.sample_covariance
+       << "\n";
+    return os;
+}
+} // namespace VSTAT_NAMESPACE
+
+#endif
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_STRIDED_HPP
+#define VSTAT_STRIDED_HPP
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "util.hpp"
+
+namespace VSTAT_NAMESPACE {
+/*!
+    \brief Random access iterator over equally spaced elements in memory
+
+    Allows the accumulate methods to work directly on strided views (for example a column of a row-major matrix
+    or a sliced numpy array) without copying. The stride is given in elements and may be negative or zero (broadcast views).
+*/
+template<typename T>
+class strided_iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    strided_iterator() = default;
+    strided_iterator(T* base, std::ptrdiff_t stride, std::ptrdiff_t index = 0) noexcept
+        : base_(base), stride_(stride), index_(index) { }
+
+    [[nodiscard]] auto stride() const noexcept { return stride_; }
+
+    auto operator*() const noexcept -> reference { return base_[index_ * stride_]; }
+    auto operator[](difference_type n) const noexcept -> reference { return base_[(index_ + n) * stride_]; }
+
+    auto operator++() noexcept -> strided_iterator& { ++index_; return *this; }
+    auto operator--() noexcept -> strided_iterator& { --index_; return *this; }
+    auto operator++(int) noexcept -> strided_iterator { auto it = *this; ++index_; return it; }
+    auto operator--(int) noexcept -> strided_iterator { auto it = *this; --index_; return it; }
+
+    auto operator+=(difference_type n) noexcept -> strided_iterator& { index_ += n; return *this; }
+    auto operator-=(difference_type n) noexcept -> strided_iterator& { index_ -= n; return *this; }
+
+    friend auto operator+(strided_iterator it, difference_type n) noexcept -> strided_iterator { return it += n; }
+    friend auto operator+(difference_type n, strided_iterator it) noexcept -> strided_iterator { return it += n; }
+    friend auto operator-(strided_iterator it, difference_type n) noexcept -> strided_iterator { return it -= n; }
+
+    // iterators are compared by their position in the view, so both must refer to the same view
+    friend auto operator-(strided_iterator const& a, strided_iterator const& b) noexcept -> difference_type
+    {
+        return a.index_ - b.index_;
+    }
+
+    friend auto operator==(strided_iterator const& a, strided_iterator const& b) noexcept -> bool { return a.index_ == b.index_; }
+    friend auto operator<=>(strided_iterator const& a, strided_iterator const& b) noexcept { return a.index_ <=> b.index_; }
+
+private:
+    T* base_{nullptr};
+    std::ptrdiff_t stride_{1};
+    std::ptrdiff_t index_{0};
+};
+} // namespace VSTAT_NAMESPACE
+
+#endif
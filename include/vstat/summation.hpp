@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_SUMMATION_HPP
+#define VSTAT_SUMMATION_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <eve/wide.hpp>
+#include <eve/module/core.hpp>
+
+#include "util.hpp"
+
+namespace VSTAT_NAMESPACE {
+/*!
+    \brief Summation policies for the accumulators
+
+    `plain_summation` adds the values to the running sums directly. `compensated_summation` additionally keeps
+    the rounding error of every running sum (per SIMD lane) and feeds it back into the next addition (Kahan),
+    so that the error of the sums no longer grows with the number of values. This allows accumulating long
+    streams of `float` values at full SIMD width with an accuracy close to double precision accumulation.
+
+    The error terms are folded into the sums when the state is reduced. Note that compensated summation relies
+    on the exact evaluation order of floating point operations and does not work with `-ffast-math`.
+*/
+struct plain_summation { };
+struct compensated_summation { };
+
+namespace detail {
+    template<typename S>
+    inline constexpr bool is_compensated = std::is_same_v<S, compensated_summation>;
+
+    // the rounding error of a running sum (empty for plain summation)
+    template<typename T, typename S>
+    struct sum_error { };
+
+    template<typename T>
+    struct sum_error<T, compensated_summation> {
+        T value{0};
+    };
+
+    // sum += x
+    template<typename T, typename S>
+    inline auto add(T& sum, sum_error<T, S>& err, T x) noexcept -> void
+    {
+        if constexpr (is_compensated<S>) {
+            T const y = x - err.value;
+            T const t = sum + y;
+            err.value = (t - sum) - y;
+            sum = t;
+        } else {
+            sum += x;
+        }
+    }
+
+    // sum += other, where the other sum carries its own rounding error
+    template<typename T, typename S>
+    inline auto add(T& sum, sum_error<T, S>& err, T other, sum_error<T, S> const& other_err) noexcept -> void
+    {
+        add(sum, err, other);
+        if constexpr (is_compensated<S>) {
+            err.value += other_err.value;
+        }
+    }
+
+    // the running sum corrected by its rounding error
+    template<typename T, typename S>
+    inline auto corrected(T sum, sum_error<T, S> const& err) noexcept -> T
+    {
+        if constexpr (is_compensated<S>) {
+            return sum - err.value;
+        } else {
+            return sum;
+        }
+    }
+
+    // the running sum corrected by its rounding error, computed in double precision lane by lane
+    template<typename T>
+    inline auto corrected_lanes(T sum, sum_error<T, compensated_summation> const& err) noexcept
+    {
+        if constexpr (eve::simd_value<T>) {
+            std::array<double, T::size()> lanes{};
+            for (std::size_t i = 0; i < lanes.size(); ++i) {
+                lanes[i] = static_cast<double>(sum.get(i)) - static_cast<double>(err.value.get(i));
+            }
+            return lanes;
+        } else {
+            return std::array<double, 1>{ static_cast<double>(sum) - static_cast<double>(err.value) };
+        }
+    }
+} // namespace detail
+} // namespace VSTAT_NAMESPACE
+
+#endif
@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_TAGS_HPP
+#define VSTAT_TAGS_HPP
+
+#include "util.hpp"
+
+namespace VSTAT_NAMESPACE {
+/*!
+    \brief Tag selecting the NaN-aware variants of the accumulate and metrics methods
+
+    NaN values (in any of the inputs, including the weights) are masked out of the SIMD updates, so they add zero
+    weight without a separate filtering pass. The bivariate methods and the metrics use pairwise-complete
+    observations: a pair is skipped if any of its values is NaN. The number of skipped values is reported in the
+    `skipped` field of the returned statistics, or through the `skipped` out-parameter of the metrics.
+*/
+struct skip_nan_t { };
+inline constexpr skip_nan_t skip_nan{};
+
+/*!
+    \brief Tag selecting the variants of the univariate accumulate methods that also compute the extrema
+
+    The minimum and maximum values and their (first) positions are updated from the same SIMD vectors as the
+    moments and reported in the `min`, `max`, `argmin` and `argmax` fields of the returned statistics.
+*/
+struct with_extrema_t { };
+inline constexpr with_extrema_t with_extrema{};
+} // namespace VSTAT_NAMESPACE
+
+#endif
@@ -4,25 +4,34 @@
 #ifndef VSTAT_UNIVARIATE_HPP
 #define VSTAT_UNIVARIATE_HPP
 
+#include <cstdint>
+#include <limits>
+#include <tuple>
+
 #include "combine.hpp"
+#include "statistics.hpp"
+#include "summation.hpp"
 
 namespace VSTAT_NAMESPACE {
 /*!
     \brief Univariate accumulator object
+
+    \tparam T The value type (a scalar type or an `eve::wide` SIMD type)
+    \tparam S The summation policy (`plain_summation` or `compensated_summation`)
 */
-template <typename T>
+template <typename T, typename S = plain_summation>
 struct univariate_accumulator {
-    static auto load_state(T sw, T sx, T sxx) noexcept -> univariate_accumulator<T>
+    static auto load_state(T sw, T sx, T sxx) noexcept -> univariate_accumulator<T, S>
     {
-        univariate_accumulator<T> acc;
+        univariate_accumulator<T, S> acc;
         acc.sum_w = sw;
-        acc.sum_w_old = sw;
+        acc.sum_w_old = detail::nonzero_weight(sw);
         acc.sum_x = sx;
         acc.sum_xx = sxx;
         return acc;
     }
 
-    static auto load_state(std::tuple<T, T, T> state) noexcept -> univariate_accumulator<T>
+    static auto load_state(std::tuple<T, T, T> state) noexcept -> univariate_accumulator<T, S>
     {
         auto [sw, sx, sxx] = state;
         return load_state(sw, sx, sxx);
@@ -31,9 +40,9 @@ struct univariate_accumulator {
     inline void operator()(T x) noexcept
     {
         T dx = sum_w * x - sum_x;
-        sum_x += x;
-        sum_w += 1;
-        sum_xx += dx * dx / (sum_w * sum_w_old);
+        detail::add(sum_x, err_x, x);
+        detail::add(sum_w, err_w, T{1});
+        detail::add(sum_xx, err_xx, dx * dx / (sum_w * sum_w_old));
         sum_w_old = sum_w;
     }
 
@@ -41,12 +50,36 @@ struct univariate_accumulator {
     {
         x *= w;
         T dx = sum_w * x - sum_x * w;
-        sum_x += x;
-        sum_w += w;
-        sum_xx += dx * dx / (w * sum_w * sum_w_old);
+        detail::add(sum_x, err_x, x);
+        detail::add(sum_w, err_w, w);
+        detail::add(sum_xx, err_xx, dx * dx / (w * sum_w * sum_w_old));
         sum_w_old = sum_w;
     }
 
+    // masked updates: only the lanes selected by the mask are accumulated, the other lanes add zero weight
+    inline void operator()(T x, eve::as_logical_t<T> mask) noexcept
+    requires eve::simd_value<T>
+    {
+        x = eve::if_else(mask, x, T{0});
+        T dx = sum_w * x - sum_x;
+        detail::add(sum_x, err_x, x);
+        detail::add(sum_w, err_w, eve::if_else(mask, T{1}, T{0}));
+        detail::add(sum_xx, err_xx, eve::if_else(mask, dx * dx / (sum_w * sum_w_old), T{0}));
+        sum_w_old = detail::nonzero_weight(sum_w);
+    }
+
+    inline void operator()(T x, T w, eve::as_logical_t<T> mask) noexcept
+    requires eve::simd_value<T>
+    {
+        w = eve::if_else(mask, w, T{0});
+        x = eve::if_else(mask, x * w, T{0});
+        T dx = sum_w * x - sum_x * w;
+        detail::add(sum_x, err_x, x);
+        detail::add(sum_w, err_w, w);
+        detail::add(sum_xx, err_xx, eve::if_else(mask, dx * dx / (w * sum_w * sum_w_old), T{0}));
+        sum_w_old = detail::nonzero_weight(sum_w);
+    }
+
     template<typename U>
     requires eve::simd_value<T> && eve::simd_compatible_ptr<U, T>
     inline void operator()(U const* x) noexcept
@@ -61,10 +94,43 @@ struct univariate_accumulator {
         (*this)(T{x}, T{w});
     }
 
+    // merges the state of another accumulator into this one (Schubert et al., eq. 21-22).
+    // for SIMD types the merge is performed lane-wise, without any reduction.
+    inline auto merge(univariate_accumulator<T, S> const& other) noexcept -> univariate_accumulator<T, S>&
+    {
+        T const d = other.sum_w * sum_x - sum_w * other.sum_x;
+        detail::add(sum_xx, err_xx, other.sum_xx + detail::combine_factor(sum_w, other.sum_w) * d * d, other.err_xx);
+        detail::add(sum_x, err_x, other.sum_x, other.err_x);
+        detail::add(sum_w, err_w, other.sum_w, other.err_w);
+        sum_w_old = detail::nonzero_weight(sum_w);
+        return *this;
+    }
+
+    inline auto operator+=(univariate_accumulator<T, S> const& other) noexcept -> univariate_accumulator<T, S>&
+    {
+        return merge(other);
+    }
+
+    // returns the raw (unreduced) state { sum_w, sum_x, sum_xx }, with the error terms folded into the sums
+    [[nodiscard]] auto state() const noexcept -> std::tuple<T, T, T>
+    {
+        return { detail::corrected(sum_w, err_w), detail::corrected(sum_x, err_x), detail::corrected(sum_xx, err_xx) };
+    }
+
     // performs the reductions and returns { sum_w, sum_x, sum_xx }
     [[nodiscard]] auto stats() const noexcept -> std::tuple<double, double, double>
     {
-        if constexpr (std::is_floating_point_v<T>) {
+        if constexpr (detail::is_compensated<S>) {
+            // fold the error terms in double precision before reducing the lanes
+            auto const sw = detail::corrected_lanes(sum_w, err_w);
+            auto const sx = detail::corrected_lanes(sum_x, err_x);
+            auto const sxx = detail::corrected_lanes(sum_xx, err_xx);
+            univariate_accumulator<double> acc;
+            for (std::size_t i = 0; i < sw.size(); ++i) {
+                acc += univariate_accumulator<double>::load_state(sw[i], sx[i], sxx[i]);
+            }
+            return acc.stats();
+        } else if constexpr (std::is_floating_point_v<T>) {
             return { sum_w, sum_x, sum_xx };
         } else {
             return { eve::reduce(sum_w), eve::reduce(sum_x), combine(sum_w, sum_x, sum_xx) };
@@ -76,44 +142,11 @@ private:
     T sum_w_old{1};
     T sum_x{0};
     T sum_xx{0};
+    // rounding errors (compensated summation only)
+    [[no_unique_address]] detail::sum_error<T, S> err_w;
+    [[no_unique_address]] detail::sum_error<T, S> err_x;
+    [[no_unique_address]] detail::sum_error<T, S> err_xx;
 };
-
-/*!
-    \brief Univariate statistics
-*/
-struct univariate_statistics {
-    double count;
-    double sum;
-    double ssr;
-    double mean;
-    double variance;
-    double sample_variance;
-
-    template <typename T>
-    explicit univariate_statistics(T const& accumulator)
-    {
-        auto [sw, sx, sxx] = accumulator.stats();
-        count = sw;
-        sum = sx;
-        ssr = sxx;
-        mean = sx / sw;
-        variance = sxx / sw;
-        sample_variance = sxx / (sw - 1);
-    }
-};
-
-inline auto operator<<(std::ostream& os, univariate_statistics const& stats) -> std::ostream&
-{
-    os << "count:          \t" << stats.count
-       << "\nsum:            \t" << stats.sum
-       << "\nssr:            \t" << stats.ssr
-       << "\nmean:           \t" << stats.mean
-       << "\nvariance:       \t" << stats.variance
-       << "\nsample variance:\t" << stats.sample_variance
-       << "\n";
-    return os;
-}
-
 } // namespace VSTAT_NAMESPACE
 
 #endif
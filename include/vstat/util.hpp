@@ -4,6 +4,9 @@
 #ifndef VSTAT_UTIL_HPP
 #define VSTAT_UTIL_HPP
 
+#include <exception>
+#include <iostream>
+
 #if defined(__GNUC__) || defined(__GNUG__)
 #define VSTAT_FORCE_INLINE __attribute__((always_inline)) inline
 #else
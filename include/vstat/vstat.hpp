@@ -5,32 +5,493 @@
 #define VSTAT_HPP
 
 #include "bivariate.hpp"
+#include "ewma.hpp"
+#include "extrema.hpp"
+#include "grouped.hpp"
+#include "histogram.hpp"
+#include "moments.hpp"
+#include "multivariate.hpp"
+#include "parallel.hpp"
+#include "quantile.hpp"
+#include "rolling.hpp"
+#include "serialize.hpp"
+#include "strided.hpp"
+#include "tags.hpp"
 #include "univariate.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
 
+#include <eve/memory/aligned_ptr.hpp>
 #include <eve/module/math.hpp>
 #include <eve/module/special.hpp>
 
 namespace VSTAT_NAMESPACE {
 
 namespace detail {
-    // utility method to load data into a wide type
-    template<eve::simd_value T, std::input_iterator I, typename F>
+    // true when the values can be loaded directly from memory, without going through the projection
+    template<typename T, typename I, typename F>
+    concept contiguous_load = std::contiguous_iterator<I>
+                              && std::same_as<std::remove_cvref_t<F>, std::identity>
+                              && std::same_as<std::iter_value_t<I>, typename T::value_type>;
+
+    // true when the values are stored contiguously as another arithmetic type (e.g. float or int16 values
+    // accumulated in double precision), so they can be loaded as a vector and converted in registers
+    template<typename T, typename I, typename F>
+    concept converting_load = std::contiguous_iterator<I>
+                              && std::same_as<std::remove_cvref_t<F>, std::identity>
+                              && std::is_arithmetic_v<std::iter_value_t<I>>
+                              && !std::same_as<std::iter_value_t<I>, bool>
+                              && !std::same_as<std::iter_value_t<I>, typename T::value_type>;
+
+    // utility method to load data into a wide type. contiguous ranges without a projection are loaded with
+    // a single (aligned or unaligned) vector load, converting the values if their type differs from the value
+    // type of the wide (e.g. a float -> double load widens one half register into a full register). other
+    // ranges are gathered one lane at a time.
+    template<eve::simd_value T, bool Aligned = false, std::input_iterator I, typename F = std::identity>
     requires std::is_invocable_v<F, std::iter_value_t<I>>
-    auto inline load(I iter, F&& func) {
-        return [&]<std::size_t ...Idx>(std::index_sequence<Idx...>){
-            return T{ std::forward<F>(func)(*(iter + Idx))... };
-        }(std::make_index_sequence<T::size()>{});
+    auto inline load(I iter, F&& func = F{}) {
+        if constexpr (contiguous_load<T, I, F>) {
+            auto const* ptr = std::to_address(iter);
+            if constexpr (Aligned) {
+                return T{ eve::aligned_ptr<typename T::value_type const, typename T::cardinal_type>{ptr} };
+            } else {
+                return T{ ptr };
+            }
+        } else if constexpr (converting_load<T, I, F>) {
+            using U = std::iter_value_t<I>;
+            eve::wide<U, typename T::cardinal_type> const v{ std::to_address(iter) };
+            return eve::convert(v, eve::as<typename T::value_type>{});
+        } else {
+            return [&]<std::size_t ...Idx>(std::index_sequence<Idx...>){
+                return T{ std::forward<F>(func)(*(iter + Idx))... };
+            }(std::make_index_sequence<T::size()>{});
+        }
+    }
+
+    // returns true if the iterator points to contiguous memory aligned for an aligned load of T
+    template<eve::simd_value T, std::input_iterator I>
+    auto inline is_aligned(I iter) -> bool {
+        if constexpr (std::contiguous_iterator<I>) {
+            return reinterpret_cast<std::uintptr_t>(std::to_address(iter)) % alignof(T) == 0;
+        } else {
+            return false;
+        }
     }
 
-    // utility method to advance a set of iterators
+    // invokes `func` with std::true_type if all the iterators allow aligned loads of T and std::false_type otherwise
+    template<eve::simd_value T, typename Func, std::input_iterator... Iters>
+    auto inline with_alignment(Func&& func, Iters const&... iters) -> void {
+        if ((is_aligned<T>(iters) && ...)) {
+            std::forward<Func>(func)(std::true_type{});
+        } else {
+            std::forward<Func>(func)(std::false_type{});
+        }
+    }
+
+    // placeholder for an absent sequence (weights or mask) in the masked methods
+    struct none { };
+
+    // utility method to advance a set of iterators (placeholders are left as they are)
     template<typename Distance, typename... Iters>
     auto inline advance(Distance d, Iters&... iters) -> void {
-        (std::advance(iters, d), ...);
+        ([&](auto& it) {
+            if constexpr (!std::same_as<std::remove_cvref_t<decltype(it)>, none>) { std::advance(it, d); }
+        }(iters), ...);
+    }
+
+    // number of SIMD vectors per lane that are summed before being folded into the accumulator
+    auto constexpr block_size{ 64 };
+
+    // division-free accumulation of `count` SIMD vectors into `acc`: the values are shifted by the running mean
+    // of each lane and summed by `Chains` independent accumulators, then each block is folded into `acc` with a
+    // single pairwise merge. this avoids the per-element division and the loop-carried dependency on sum_w.
+    template<std::size_t Chains, eve::simd_value T, std::input_iterator I, typename F>
+    auto inline accumulate_blocked(univariate_accumulator<T>& acc, I& first, std::ptrdiff_t count, F&& f) noexcept -> void {
+        auto constexpr s{ T::size() };
+
+        for (std::ptrdiff_t i = 0; i < count; i += block_size) {
+            auto const b = std::min<std::ptrdiff_t>(block_size, count - i);
+            auto const [sw, sx, sxx] = acc.state();
+            T const c = eve::if_else(sw == T{0}, load<T>(first, f), sx / sw);
+
+            std::array<T, Chains> s1; s1.fill(T{0});
+            std::array<T, Chains> s2; s2.fill(T{0});
+
+            std::ptrdiff_t j = 0;
+            for (; j + static_cast<std::ptrdiff_t>(Chains) <= b; j += Chains) {
+                for (std::size_t k = 0; k < Chains; ++k) {
+                    T const d = load<T>(first, f) - c;
+                    s1[k] += d;
+                    s2[k] += d * d;
+                    detail::advance(s, first);
+                }
+            }
+            for (; j < b; ++j) {
+                T const d = load<T>(first, f) - c;
+                s1[0] += d;
+                s2[0] += d * d;
+                detail::advance(s, first);
+            }
+            for (std::size_t k = 1; k < Chains; ++k) {
+                s1[0] += s1[k];
+                s2[0] += s2[k];
+            }
+
+            T const n{ static_cast<typename T::value_type>(b) };
+            acc.merge(univariate_accumulator<T>::load_state(n, s1[0] + n * c, s2[0] - s1[0] * s1[0] / n));
+        }
+    }
+
+    // weighted variant of the division-free accumulation
+    template<std::size_t Chains, eve::simd_value T, std::input_iterator I, std::input_iterator J, typename F>
+    auto inline accumulate_blocked(univariate_accumulator<T>& acc, I& first1, J& first2, std::ptrdiff_t count, F&& f) noexcept -> void {
+        auto constexpr s{ T::size() };
+
+        for (std::ptrdiff_t i = 0; i < count; i += block_size) {
+            auto const b = std::min<std::ptrdiff_t>(block_size, count - i);
+            auto const [sw, sx, sxx] = acc.state();
+            T const c = eve::if_else(sw == T{0}, load<T>(first1, f), sx / sw);
+
+            std::array<T, Chains> s0; s0.fill(T{0});
+            std::array<T, Chains> s1; s1.fill(T{0});
+            std::array<T, Chains> s2; s2.fill(T{0});
+
+            auto update = [&](std::size_t k) {
+                T const w = load<T>(first2, std::identity{});
+                T const d = load<T>(first1, f) - c;
+                T const wd = w * d;
+                s0[k] += w;
+                s1[k] += wd;
+                s2[k] += wd * d;
+                detail::advance(s, first1, first2);
+            };
+
+            std::ptrdiff_t j = 0;
+            for (; j + static_cast<std::ptrdiff_t>(Chains) <= b; j += Chains) {
+                for (std::size_t k = 0; k < Chains; ++k) { update(k); }
+            }
+            for (; j < b; ++j) { update(0); }
+            for (std::size_t k = 1; k < Chains; ++k) {
+                s0[0] += s0[k];
+                s1[0] += s1[k];
+                s2[0] += s2[k];
+            }
+
+            T const q = eve::if_else(s0[0] == T{0}, T{0}, s1[0] * s1[0] / s0[0]);
+            acc.merge(univariate_accumulator<T>::load_state(s0[0], s1[0] + s0[0] * c, s2[0] - q));
+        }
+    }
+
+    // bivariate variant of the division-free accumulation
+    template<std::size_t Chains, eve::simd_value T, std::input_iterator I, std::input_iterator J, typename F1, typename F2>
+    auto inline accumulate_blocked(bivariate_accumulator<T>& acc, I& first1, J& first2, std::ptrdiff_t count, F1&& f1, F2&& f2) noexcept -> void {
+        auto constexpr s{ T::size() };
+
+        for (std::ptrdiff_t i = 0; i < count; i += block_size) {
+            auto const b = std::min<std::ptrdiff_t>(block_size, count - i);
+            auto const [sw, sx, sy, sxx, syy, sxy] = acc.state();
+            T const cx = eve::if_else(sw == T{0}, load<T>(first1, f1), sx / sw);
+            T const cy = eve::if_else(sw == T{0}, load<T>(first2, f2), sy / sw);
+
+            std::array<T, Chains> s1x; s1x.fill(T{0});
+            std::array<T, Chains> s1y; s1y.fill(T{0});
+            std::array<T, Chains> s2x; s2x.fill(T{0});
+            std::array<T, Chains> s2y; s2y.fill(T{0});
+            std::array<T, Chains> s2xy; s2xy.fill(T{0});
+
+            auto update = [&](std::size_t k) {
+                T const dx = load<T>(first1, f1) - cx;
+                T const dy = load<T>(first2, f2) - cy;
+                s1x[k] += dx;
+                s1y[k] += dy;
+                s2x[k] += dx * dx;
+                s2y[k] += dy * dy;
+                s2xy[k] += dx * dy;
+                detail::advance(s, first1, first2);
+            };
+
+            std::ptrdiff_t j = 0;
+            for (; j + static_cast<std::ptrdiff_t>(Chains) <= b; j += Chains) {
+                for (std::size_t k = 0; k < Chains; ++k) { update(k); }
+            }
+            for (; j < b; ++j) { update(0); }
+            for (std::size_t k = 1; k < Chains; ++k) {
+                s1x[0] += s1x[k];
+                s1y[0] += s1y[k];
+                s2x[0] += s2x[k];
+                s2y[0] += s2y[k];
+                s2xy[0] += s2xy[k];
+            }
+
+            T const n{ static_cast<typename T::value_type>(b) };
+            acc.merge(bivariate_accumulator<T>::load_state(
+                s1x[0] + n * cx,
+                s1y[0] + n * cy,
+                n,
+                s2x[0] - s1x[0] * s1x[0] / n,
+                s2y[0] - s1y[0] * s1y[0] / n,
+                s2xy[0] - s1x[0] * s1y[0] / n
+            ));
+        }
+    }
+
+    // computes the states { sum_w, sum_x, sum_xx } of the columns of a row-major matrix with contiguous rows.
+    // the matrix is traversed in memory order: consecutive columns are mapped onto the lanes of the wide
+    // accumulators and the rows are folded in with the division-free blocked update.
+    template<std::floating_point T>
+    auto accumulate_columns(T const* data, std::size_t rows, std::size_t cols, std::ptrdiff_t row_stride) -> std::vector<std::tuple<double, double, double>>
+    {
+        using wide = eve::wide<T>;
+        std::size_t constexpr s{ wide::size() };
+        auto const m = cols - cols % s;
+        auto const k = m / s;
+
+        std::vector<univariate_accumulator<wide>> acc(k);
+        std::vector<wide> shift(k);
+        std::vector<wide> s1(k);
+        std::vector<wide> s2(k);
+        std::vector<univariate_accumulator<T>> tail(cols - m);
+
+        auto row = [&](std::size_t r) { return data + static_cast<std::ptrdiff_t>(r) * row_stride; };
+
+        for (std::size_t i = 0; i < rows; i += block_size) {
+            auto const b = std::min<std::size_t>(block_size, rows - i);
+            for (std::size_t j = 0; j < k; ++j) {
+                auto const [sw, sx, sxx] = acc[j].state();
+                shift[j] = eve::if_else(sw == wide{0}, wide{row(i) + j * s}, sx / sw);
+                s1[j] = wide{0};
+                s2[j] = wide{0};
+            }
+
+            for (auto r = i; r < i + b; ++r) {
+                auto const* x = row(r);
+                for (std::size_t j = 0; j < k; ++j) {
+                    wide const d = wide{x + j * s} - shift[j];
+                    s1[j] += d;
+                    s2[j] += d * d;
+                }
+                for (auto j = m; j < cols; ++j) {
+                    tail[j - m](x[j]);
+                }
+            }
+
+            wide const n{ static_cast<T>(b) };
+            for (std::size_t j = 0; j < k; ++j) {
+                acc[j].merge(univariate_accumulator<wide>::load_state(n, s1[j] + n * shift[j], s2[j] - s1[j] * s1[j] / n));
+            }
+        }
+
+        std::vector<std::tuple<double, double, double>> states;
+        states.reserve(cols);
+        for (auto const& a : acc) {
+            auto const [sw, sx, sxx] = a.state();
+            for (std::size_t l = 0; l < s; ++l) {
+                states.emplace_back(sw.get(l), sx.get(l), sxx.get(l));
+            }
+        }
+        for (auto const& a : tail) {
+            states.push_back(a.stats());
+        }
+        return states;
+    }
+
+    inline auto column_statistics(std::vector<std::tuple<double, double, double>> const& states) -> std::vector<univariate_statistics>
+    {
+        std::vector<univariate_statistics> stats;
+        stats.reserve(states.size());
+        for (auto const& state : states) {
+            stats.emplace_back(univariate_accumulator<double>::load_state(state));
+        }
+        return stats;
+    }
+
+    // the lanes selected by the mask (if any) where none of the values is NaN (if NaNs are skipped)
+    template<bool SkipNan, eve::simd_value T, typename M, typename... V>
+    auto inline select(M const& mask, V const&... values) -> eve::as_logical_t<T> {
+        eve::as_logical_t<T> valid{true};
+        if constexpr (!std::same_as<M, none>) {
+            valid = load<T>(mask, [](auto b) { return static_cast<typename T::value_type>(static_cast<bool>(b)); }) != T{0};
+        }
+        if constexpr (SkipNan) {
+            ((valid = valid && eve::is_not_nan(values)), ...);
+        }
+        return valid;
+    }
+
+    // scalar version of the above
+    template<bool SkipNan, typename M, typename... V>
+    auto inline select_scalar(M const& mask, V const&... values) -> bool {
+        bool valid{true};
+        if constexpr (!std::same_as<M, none>) {
+            valid = static_cast<bool>(*mask);
+        }
+        if constexpr (SkipNan) {
+            valid = valid && (!std::isnan(values) && ...);
+        }
+        return valid;
+    }
+
+    // accumulates the (weighted) values selected by `select`. vectors where all the lanes are selected take the
+    // regular update, the others the masked update in which the rejected lanes add zero weight. the weights and
+    // the mask are loaded without alignment assumptions.
+    template<std::floating_point T, bool SkipNan, std::input_iterator I, typename J, typename M, typename F>
+    auto inline accumulate_selected(I first, std::ptrdiff_t n, J first2, M mask, F&& f) noexcept -> univariate_statistics {
+        using wide = eve::wide<T>;
+        auto constexpr s{ wide::size() };
+        auto constexpr weighted{ !std::same_as<J, none> };
+        auto const m{ n - n % s };
+        std::ptrdiff_t skipped{0};
+
+        univariate_accumulator<wide> acc;
+        with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+            for (std::ptrdiff_t i = 0; i < m; i += s) {
+                wide const x = load<wide, Aligned>(first, f);
+                if constexpr (weighted) {
+                    wide const w = load<wide>(first2);
+                    auto const valid = select<SkipNan, wide>(mask, x, w);
+                    if (eve::all(valid)) { acc(x, w); } else { acc(x, w, valid); skipped += s - eve::count_true(valid); }
+                } else {
+                    auto const valid = select<SkipNan, wide>(mask, x);
+                    if (eve::all(valid)) { acc(x); } else { acc(x, valid); skipped += s - eve::count_true(valid); }
+                }
+                advance(s, first, first2, mask);
+            }
+        }, first);
+
+        // use a scalar accumulator for the remaining values
+        auto tail = univariate_accumulator<T>::load_state(acc.stats());
+        for (std::ptrdiff_t i = m; i < n; ++i) {
+            T const x = std::invoke(f, *first);
+            if constexpr (weighted) {
+                T const w = *first2;
+                if (select_scalar<SkipNan>(mask, x, w)) { tail(x, w); } else { ++skipped; }
+            } else {
+                if (select_scalar<SkipNan>(mask, x)) { tail(x); } else { ++skipped; }
+            }
+            advance(1, first, first2, mask);
+        }
+
+        univariate_statistics stats(tail);
+        stats.skipped = static_cast<std::size_t>(skipped);
+        return stats;
+    }
+
+    // bivariate version of the above, a pair is only accumulated if both values (and the weight) are selected
+    template<std::floating_point T, bool SkipNan, std::input_iterator I, std::input_iterator J, typename K, typename M, typename F1, typename F2>
+    auto inline accumulate_selected(I first1, std::ptrdiff_t n, J first2, K first3, M mask, F1&& f1, F2&& f2) noexcept -> bivariate_statistics {
+        using wide = eve::wide<T>;
+        auto constexpr s{ wide::size() };
+        auto constexpr weighted{ !std::same_as<K, none> };
+        auto const m{ n - n % s };
+        std::ptrdiff_t skipped{0};
+
+        bivariate_accumulator<wide> acc;
+        with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+            for (std::ptrdiff_t i = 0; i < m; i += s) {
+                wide const x = load<wide, Aligned>(first1, f1);
+                wide const y = load<wide, Aligned>(first2, f2);
+                if constexpr (weighted) {
+                    wide const w = load<wide>(first3);
+                    auto const valid = select<SkipNan, wide>(mask, x, y, w);
+                    if (eve::all(valid)) { acc(x, y, w); } else { acc(x, y, w, valid); skipped += s - eve::count_true(valid); }
+                } else {
+                    auto const valid = select<SkipNan, wide>(mask, x, y);
+                    if (eve::all(valid)) { acc(x, y); } else { acc(x, y, valid); skipped += s - eve::count_true(valid); }
+                }
+                advance(s, first1, first2, first3, mask);
+            }
+        }, first1, first2);
+
+        // use a scalar accumulator for the remaining values
+        auto [sw, sx, sy, sxx, syy, sxy] = acc.stats();
+        auto tail = bivariate_accumulator<T>::load_state(sx, sy, sw, sxx, syy, sxy);
+        for (std::ptrdiff_t i = m; i < n; ++i) {
+            T const x = std::invoke(f1, *first1);
+            T const y = std::invoke(f2, *first2);
+            if constexpr (weighted) {
+                T const w = *first3;
+                if (select_scalar<SkipNan>(mask, x, y, w)) { tail(x, y, w); } else { ++skipped; }
+            } else {
+                if (select_scalar<SkipNan>(mask, x, y)) { tail(x, y); } else { ++skipped; }
+            }
+            advance(1, first1, first2, first3, mask);
+        }
+
+        bivariate_statistics stats(tail);
+        stats.skipped = static_cast<std::size_t>(skipped);
+        return stats;
+    }
+
+    // accumulates the central moments of n (projected, optionally weighted) values. like accumulate_blocked,
+    // the power sums of the values shifted by the running mean of each lane are computed for a block of SIMD
+    // vectors and each block is folded into the accumulator with a single pairwise merge.
+    template<std::floating_point T, std::input_iterator I, typename J, typename F>
+    auto inline accumulate_moments(I first, std::ptrdiff_t n, J first2, F&& f) noexcept -> moments_accumulator<double> {
+        using wide = eve::wide<T>;
+        auto constexpr s{ wide::size() };
+        auto constexpr weighted{ !std::same_as<J, none> };
+        auto const m{ n - n % s };
+
+        moments_accumulator<wide> acc;
+        with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+            for (std::ptrdiff_t i = 0; i < m; i += s * block_size) {
+                auto const b = std::min<std::ptrdiff_t>(block_size, (m - i) / s);
+                auto const [sw, mean, m2, m3, m4] = acc.state();
+                wide const c = eve::if_else(sw == wide{0}, load<wide, Aligned>(first, f), mean);
+
+                wide sn{0};
+                wide s1{0};
+                wide s2{0};
+                wide s3{0};
+                wide s4{0};
+                for (std::ptrdiff_t j = 0; j < b; ++j) {
+                    wide const d = load<wide, Aligned>(first, f) - c;
+                    wide const d2 = d * d;
+                    if constexpr (weighted) {
+                        wide const w = load<wide>(first2);
+                        sn += w;
+                        s1 += w * d;
+                        s2 += w * d2;
+                        s3 += w * d2 * d;
+                        s4 += w * d2 * d2;
+                    } else {
+                        s1 += d;
+                        s2 += d2;
+                        s3 += d2 * d;
+                        s4 += d2 * d2;
+                    }
+                    advance(s, first, first2);
+                }
+                if constexpr (!weighted) {
+                    sn = wide{ static_cast<T>(b) };
+                }
+                acc += moments_accumulator<wide>::from_power_sums(sn, c, s1, s2, s3, s4);
+            }
+        }, first);
+
+        // use a scalar accumulator for the remaining values
+        auto tail = moments_accumulator<double>::load_state(acc.stats());
+        for (std::ptrdiff_t i = m; i < n; ++i) {
+            if constexpr (weighted) {
+                tail(static_cast<double>(std::invoke(f, *first)), static_cast<double>(*first2));
+            } else {
+                tail(static_cast<double>(std::invoke(f, *first)));
+            }
+            advance(1, first, first2);
+        }
+        return tail;
     }
 } // namespace detail
 
@@ -81,10 +542,12 @@ inline auto accumulate(I first, std::sized_sentinel_for<I> auto last, F&& f = F{
     }
 
     univariate_accumulator<wide> acc;
-    for (size_t i = 0; i < m; i += s) {
-        acc(detail::load<wide>(first, std::forward<F>(f)));
-        detail::advance(s, first);
-    }
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (size_t i = 0; i < m; i += s) {
+            acc(detail::load<wide, Aligned>(first, std::forward<F>(f)));
+            detail::advance(s, first);
+        }
+    }, first);
 
     // gather the remaining values with a scalar accumulator
     if (m < n) {
@@ -128,10 +591,12 @@ inline auto accumulate(I first1, std::sized_sentinel_for<I> auto last1, J first2
     }
 
     univariate_accumulator<wide> acc;
-    for (size_t i = 0; i < m; i += s) {
-        acc(detail::load<wide>(first1, std::forward<F>(f)), wide(first2, first2 + s));
-        detail::advance(s, first1, first2);
-    }
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (size_t i = 0; i < m; i += s) {
+            acc(detail::load<wide, Aligned>(first1, std::forward<F>(f)), detail::load<wide, Aligned>(first2));
+            detail::advance(s, first1, first2);
+        }
+    }, first1, first2);
 
     // use a scalar accumulator to gather the remaining values
     if (m < n) {
@@ -148,696 +613,2781 @@ inline auto accumulate(I first1, std::sized_sentinel_for<I> auto last1, J first2
 /*!
     \ingroup Univariate
 
-    \brief Accumulates over the projected values from applying `BinaryOp` on the input sequences.
+    \brief Accumulates a sequence of (projected) values using multiple threads
 
-    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats
-    \tparam BinaryOp Binary projection \f$op(a,b) \to c\f$
-    \tparam F1 Unary projection \f$f(x_1) \to a\f$
-    \tparam F2 Unary projection \f$f(x_2) \to b\f$
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param policy The parallel execution policy (number of threads and minimum chunk size)
+    \param first  The begin iterator for the first sequence
+    \param last   The end iterator for the first sequence
+    \param f      A projection mapping `std::iter_value_t<I>` to a scalar value (invoked concurrently)
+
+    Each thread accumulates a contiguous chunk of the input. The partial results are merged in chunk order
+    using the pairwise formula by Schubert and Gertz, so the result only depends on the number of threads.
+*/
+template<std::floating_point T, std::random_access_iterator I, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto accumulate(parallel_policy const& policy, I first, std::sized_sentinel_for<I> auto last, F&& f = F{}) -> univariate_statistics
+{
+    auto const n{ std::distance(first, last) };
+    auto const partials = detail::parallel_chunks<eve::wide<T>::size()>(policy, n, [&](auto b, auto e) {
+        auto const stats = accumulate<T>(first + b, first + e, f);
+        return std::tuple{ stats.count, stats.sum, stats.ssr };
+    });
+    return univariate_statistics(univariate_accumulator<double>::load_state(detail::merge_partials(partials)));
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates a sequence of (projected) weighted values using multiple threads
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
 
+    \param policy The parallel execution policy (number of threads and minimum chunk size)
     \param first1 The begin iterator for the first sequence
     \param last1  The end iterator for the first sequence
-    \param first2 The begin iterator for the second sequence
-    \param op     A binary projection mapping a tuple \f$(f_1(\cdot), f_2(\cdot))\f$ to a scalar value
-    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
-    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+    \param first2 The begin iterator for the second (weights) sequence
+    \param f      A projection mapping `std::iter_value_t<I>` to a scalar value (invoked concurrently)
 */
-template<std::floating_point T, std::input_iterator I, std::input_iterator J, typename BinaryOp, typename F1 = std::identity, typename F2 = std::identity>
-requires std::is_invocable_v<F1, std::iter_value_t<I>> and
-         std::is_invocable_v<F2, std::iter_value_t<J>> and
-         std::is_invocable_v<
-            BinaryOp,
-            std::invoke_result_t<F1, std::iter_value_t<I>>,
-            std::invoke_result_t<F2, std::iter_value_t<J>>
-         > and
-         concepts::arithmetic_projection<
-            BinaryOp,
-            std::invoke_result_t<F1, std::iter_value_t<I>>,
-            std::invoke_result_t<F2, std::iter_value_t<J>>
-         >
-inline auto accumulate(I first1, std::sized_sentinel_for<I> auto last1, J first2, BinaryOp&& op = BinaryOp{}, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> univariate_statistics
+template<std::floating_point T, std::random_access_iterator I, std::random_access_iterator J, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>> and std::is_arithmetic_v<std::iter_value_t<J>>
+inline auto accumulate(parallel_policy const& policy, I first1, std::sized_sentinel_for<I> auto last1, J first2, F&& f = F{}) -> univariate_statistics
 {
-    using wide = eve::wide<T>;
-    auto constexpr s{ wide::size() };
     auto const n{ std::distance(first1, last1) };
-    auto const m = n - n % s;
+    auto const partials = detail::parallel_chunks<eve::wide<T>::size()>(policy, n, [&](auto b, auto e) {
+        auto const stats = accumulate<T>(first1 + b, first1 + e, first2 + b, f);
+        return std::tuple{ stats.count, stats.sum, stats.ssr };
+    });
+    return univariate_statistics(univariate_accumulator<double>::load_state(detail::merge_partials(partials)));
+}
 
-    auto f = [&](auto a, auto b){
-        return std::invoke(std::forward<BinaryOp>(op), std::invoke(std::forward<F1>(f1), a), std::invoke(std::forward<F2>(f2), b));
-    };
+/*!
+    \ingroup Univariate
 
-    if (n < s) {
-        univariate_accumulator<T> scalar_acc;
-        for (; first1 < last1; ++first1, ++first2) {
-            scalar_acc(f(*first1, *first2));
-        }
-        return univariate_statistics(scalar_acc);
-    }
+    \brief Accumulates a sequence of (projected) values using the division-free blocked kernel
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param first The begin iterator for the first sequence
+    \param last  The end iterator for the first sequence
+    \param f     A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    Instead of updating the accumulator for every SIMD vector, the values are summed in blocks by several
+    independent accumulators (after shifting them by the running mean of each lane) and every block is folded
+    into the running state with a single pairwise merge. This removes the per-element division and the
+    loop-carried dependency of the regular update.
+*/
+template<std::floating_point T, std::input_iterator I, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto accumulate_blocked(I first, std::sized_sentinel_for<I> auto last, F&& f = F{}) noexcept -> univariate_statistics
+{
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first, last) };
 
-    std::array<T, s> x;
     univariate_accumulator<wide> acc;
-    for (size_t i = 0; i < m; i += s) {
-        std::transform(first1, first1 + s, first2, x.begin(), f);
-        acc(wide{x.data()});
-        detail::advance(s, first1, first2);
-    }
+    detail::accumulate_blocked<4>(acc, first, n / s, f);
 
-    // use a scalar accumulator to gather the remaining values
-    if (m < n) {
-        auto [sw, sx, sxx] = acc.stats();
-        auto scalar_acc = univariate_accumulator<T>::load_state(sw, sx, sxx);
-        for (; first1 < last1; ++first1, ++first2) {
-            scalar_acc(f(*first1, *first2));
-        }
-        return univariate_statistics(scalar_acc);
+    // gather the remaining values with a scalar accumulator
+    auto scalar_acc = univariate_accumulator<T>::load_state(acc.stats());
+    for (; first < last; ++first) {
+        scalar_acc(std::invoke(f, *first));
     }
-    return univariate_statistics(acc);
+    return univariate_statistics(scalar_acc);
 }
 
 /*!
     \ingroup Univariate
 
-    \brief Accumulates over the projected values from applying `BinaryOp` on the input sequences, with weights
+    \brief Accumulates a sequence of (projected) weighted values using the division-free blocked kernel
 
-    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats
-    \tparam BinaryOp Binary projection \f$op(a,b) \to c\f$
-    \tparam F1 Unary projection \f$f(x_1) \to a\f$
-    \tparam F2 Unary projection \f$f(x_2) \to b\f$
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
 
     \param first1 The begin iterator for the first sequence
     \param last1  The end iterator for the first sequence
-    \param first2 The begin iterator for the second sequence
-    \param first3 The begin iterator for the third sequence (weights)
-    \param op     A binary projection mapping a tuple \f$(f_1(\bullet), f_2(\bullet))\f$ to a scalar value
-    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
-    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+    \param first2 The begin iterator for the second (weights) sequence
+    \param f      A projection mapping `std::iter_value_t<I>` to a scalar value
 */
-template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K, typename BinaryOp, typename F1 = std::identity, typename F2 = std::identity>
-requires std::is_arithmetic_v<std::iter_value_t<K>> &&
-         std::is_invocable_v<F1, std::iter_value_t<I>> &&
-         std::is_invocable_v<F2, std::iter_value_t<J>> &&
-         std::is_invocable_v<
-            BinaryOp,
-            std::invoke_result_t<F1, std::iter_value_t<I>>,
-            std::invoke_result_t<F2, std::iter_value_t<J>>
-         > &&
-         concepts::arithmetic_projection<
-            BinaryOp,
-            std::invoke_result_t<F1, std::iter_value_t<I>>,
-            std::invoke_result_t<F2, std::iter_value_t<J>>
-         >
-inline auto accumulate(I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, BinaryOp&& op = BinaryOp{}, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> univariate_statistics
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>> and std::is_arithmetic_v<std::iter_value_t<J>>
+inline auto accumulate_blocked(I first1, std::sized_sentinel_for<I> auto last1, J first2, F&& f = F{}) noexcept -> univariate_statistics
 {
     using wide = eve::wide<T>;
     auto constexpr s{ wide::size() };
     auto const n{ std::distance(first1, last1) };
-    auto const m = n - n % s;
-
-    auto f = [&](auto a, auto b){
-        return std::invoke(std::forward<BinaryOp>(op), std::invoke(std::forward<F1>(f1), a), std::invoke(std::forward<F2>(f2), b));
-    };
-
-    if (n < s) {
-        univariate_accumulator<T> scalar_acc;
-        for (; first1 < last1; ++first1, ++first2, ++first3) {
-            scalar_acc(f(*first1, *first2), *first3);
-        }
-        return univariate_statistics(scalar_acc);
-    }
 
-    std::array<T, s> x;
     univariate_accumulator<wide> acc;
-    for (size_t i = 0; i < m; i += s) {
-        std::transform(first1, first1 + s, first2, x.begin(), f);
-        acc(wide(x), wide(first3, first3 + s));
-        detail::advance(s, first1, first2, first3);
-    }
+    detail::accumulate_blocked<4>(acc, first1, first2, n / s, f);
 
     // use a scalar accumulator to gather the remaining values
-    if (m < n) {
-        auto [sw, sx, sxx] = acc.stats();
-        auto scalar_acc = univariate_accumulator<T>::load_state(sw, sx, sxx);
-        for (; first1 < last1; ++first1, ++first2, ++first3) {
-            scalar_acc(f(*first1, *first2), *first3);
-        }
-        return univariate_statistics(scalar_acc);
+    auto scalar_acc = univariate_accumulator<T>::load_state(acc.stats());
+    for (; first1 < last1; ++first1, ++first2) {
+        scalar_acc(std::invoke(f, *first1), *first2);
     }
-    return univariate_statistics(acc);
+    return univariate_statistics(scalar_acc);
 }
-} // namespace univariate
 
-namespace bivariate {
 /*!
-    \defgroup Bivariate Bivariate statistics
+    \ingroup Univariate
 
-    \brief Methods for bivariate statistics
+    \brief Accumulates each column of a row-major matrix
+
+    \tparam T The scalar value type of the matrix, also used for the `eve::wide<T>` SIMD type
+
+    \param data       Pointer to the first element of the matrix
+    \param rows       The number of rows
+    \param cols       The number of columns (the elements of a row must be contiguous)
+    \param row_stride The distance between the first elements of two consecutive rows (in elements, may be negative)
+
+    The matrix is read once in memory order, each row being loaded with contiguous vector loads, instead of
+    making one strided pass per column. Returns the statistics of every column.
 */
+template<std::floating_point T>
+inline auto accumulate_columns(T const* data, std::size_t rows, std::size_t cols, std::ptrdiff_t row_stride) -> std::vector<univariate_statistics>
+{
+    return detail::column_statistics(detail::accumulate_columns(data, rows, cols, row_stride));
+}
 
 /*!
-    \ingroup Bivariate
-
-    \brief Compute bivariate statistics from two sequences of values. The values can be provided directly or via a projection method.
+    \ingroup Univariate
 
-    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+    \brief Accumulates each column of a row-major matrix using multiple threads
 
-    \param first1 The begin iterator for the first sequence
-    \param last1  The end iterator for the first sequence
-    \param first2 The begin iterator for the second sequence
-    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
-    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+    \tparam T The scalar value type of the matrix, also used for the `eve::wide<T>` SIMD type
 
-    \b Example
+    \param policy     The parallel execution policy (the minimum chunk size is given in elements)
+    \param data       Pointer to the first element of the matrix
+    \param rows       The number of rows
+    \param cols       The number of columns (the elements of a row must be contiguous)
+    \param row_stride The distance between the first elements of two consecutive rows (in elements, may be negative)
 
-    \code
-    float x[] = { 1., 1., 2., 6. };
-    float y[] = { 2., 4., 3., 1. };
-    auto stats = bivariate::accumulate<float>(std::begin(x), std::end(x), std::begin(y));
-    std::cout << stats << "\n";
-    // results
-    count:                  4
-    sum_x:                  10
-    ssr_x:                  17
-    mean_x:                 2.5
-    variance_x:             4.25
-    sample variance_x:      5.66667
-    sum_y:                  10
-    ssr_y:                  5
-    mean_y:                 2.5
-    variance_y:             1.25
-    sample variance_y:      1.66667
-    correlation:            -0.759257
-    covariance:             -1.75
-    sample covariance:      -2.33333
-    \endcode
+    The rows are split in contiguous chunks and the per-column partial results are merged in chunk order.
 */
-template<std::floating_point T, std::input_iterator I, std::input_iterator J, typename F1 = std::identity, typename F2 = std::identity>
-requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> and
-         concepts::arithmetic_projection<F2, std::iter_value_t<J>>
-inline auto accumulate(I first1, std::sized_sentinel_for<I> auto last1, J first2, F1&& f1 = F1{}, F2&& f2 = F2{})
+template<std::floating_point T>
+inline auto accumulate_columns(parallel_policy const& policy, T const* data, std::size_t rows, std::size_t cols, std::ptrdiff_t row_stride) -> std::vector<univariate_statistics>
 {
-    using wide = eve::wide<T>;
-    auto constexpr s { wide::size() };
-    auto const n { std::distance(first1, last1) };
-    auto const m = n - n % s;
-
-    if (n < s) {
-        bivariate_accumulator<T> scalar_acc;
-        for (; first1 < last1; ++first1, ++first2) {
-            scalar_acc(std::invoke(std::forward<F1>(f1), *first1), std::invoke(std::forward<F2>(f2), *first2));
+    parallel_policy const row_policy{ policy.threads, std::max<std::size_t>(1, policy.min_chunk_size / std::max<std::size_t>(1, cols)) };
+    auto partials = detail::parallel_chunks<1>(row_policy, static_cast<std::ptrdiff_t>(rows), [&](auto b, auto e) {
+        return detail::accumulate_columns(data + b * row_stride, static_cast<std::size_t>(e - b), cols, row_stride);
+    });
+
+    auto states = std::move(partials.front());
+    for (auto p = partials.begin() + 1; p < partials.end(); ++p) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            states[j] = combine(states[j], (*p)[j]);
         }
-        return bivariate_statistics(scalar_acc);
     }
+    return detail::column_statistics(states);
+}
 
-    bivariate_accumulator<wide> acc;
-    for (size_t i = 0; i < m; i += s) {
-        acc(detail::load<wide>(first1, std::forward<F1>(f1)), detail::load<wide>(first2, std::forward<F2>(f2)));
-        detail::advance(s, first1, first2);
-    }
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates a sequence of (projected) values, skipping NaNs
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param first The begin iterator for the sequence
+    \param last  The end iterator for the sequence
+    \param f     A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    The number of NaN values is reported in the `skipped` field of the result.
+*/
+template<std::floating_point T, std::input_iterator I, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto accumulate(skip_nan_t /*unused*/, I first, std::sized_sentinel_for<I> auto last, F&& f = F{}) noexcept -> univariate_statistics
+{
+    return detail::accumulate_selected<T, true>(first, std::distance(first, last), detail::none{}, detail::none{}, std::forward<F>(f));
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates a sequence of (projected) weighted values, skipping NaNs
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param first1 The begin iterator for the values
+    \param last1  The end iterator for the values
+    \param first2 The begin iterator for the weights
+    \param f      A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    A value is skipped if either the value or its weight is NaN.
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>> and std::is_arithmetic_v<std::iter_value_t<J>>
+inline auto accumulate(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, F&& f = F{}) noexcept -> univariate_statistics
+{
+    return detail::accumulate_selected<T, true>(first1, std::distance(first1, last1), first2, detail::none{}, std::forward<F>(f));
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates a sequence of (projected) values, including the extrema and their positions
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param first The begin iterator for the sequence
+    \param last  The end iterator for the sequence
+    \param f     A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    NaN values are ignored by the extrema (but not by the moments).
+*/
+template<std::floating_point T, std::input_iterator I, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto accumulate(with_extrema_t /*unused*/, I first, std::sized_sentinel_for<I> auto last, F&& f = F{}) noexcept -> univariate_statistics
+{
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first, last) };
+    auto const m = n - n % s;
+
+    univariate_accumulator<wide> acc;
+    extrema_accumulator<wide> ext;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (std::ptrdiff_t i = 0; i < m; i += s) {
+            wide const x = detail::load<wide, Aligned>(first, f);
+            acc(x);
+            ext(x);
+            detail::advance(s, first);
+        }
+    }, first);
+
+    // gather the remaining values with scalar accumulators
+    auto scalar_acc = univariate_accumulator<T>::load_state(acc.stats());
+    auto scalar_ext = extrema_accumulator<double>::load_state(ext.stats());
+    for (; first < last; ++first) {
+        T const x = std::invoke(f, *first);
+        scalar_acc(x);
+        scalar_ext(x);
+    }
+    return univariate_statistics(scalar_acc, scalar_ext);
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates a sequence of (projected) values, including the extrema, using multiple threads
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param policy The parallel execution policy (number of threads and minimum chunk size)
+    \param first  The begin iterator for the sequence
+    \param last   The end iterator for the sequence
+    \param f      A projection mapping `std::iter_value_t<I>` to a scalar value (invoked concurrently)
+*/
+template<std::floating_point T, std::random_access_iterator I, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto accumulate(parallel_policy const& policy, with_extrema_t /*unused*/, I first, std::sized_sentinel_for<I> auto last, F&& f = F{}) -> univariate_statistics
+{
+    auto const n{ std::distance(first, last) };
+    auto const partials = detail::parallel_chunks<eve::wide<T>::size()>(policy, n, [&](auto b, auto e) {
+        auto const stats = accumulate<T>(with_extrema, first + b, first + e, f);
+        return std::pair{
+            univariate_accumulator<double>::load_state(stats.count, stats.sum, stats.ssr),
+            extrema_accumulator<double>::load_state(e - b, stats.min, stats.max, stats.argmin, stats.argmax)
+        };
+    });
+    // the chunks are merged in order, so the positions of each chunk are offset by the preceding chunks
+    auto [acc, ext] = partials.front();
+    for (auto i = 1UL; i < partials.size(); ++i) {
+        acc += partials[i].first;
+        ext += partials[i].second;
+    }
+    return univariate_statistics(acc, ext);
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates a sequence of (projected) values and inserts them into a quantile sketch in the same pass
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param sketch The quantile sketch receiving the values (it may already hold values from previous calls)
+    \param first  The begin iterator for the sequence
+    \param last   The end iterator for the sequence
+    \param f      A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    Every loaded SIMD vector updates the moments and is appended to the sketch with a single store.
+*/
+template<std::floating_point T, std::input_iterator I, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto accumulate(quantile_sketch<T>& sketch, I first, std::sized_sentinel_for<I> auto last, F&& f = F{}) -> univariate_statistics
+{
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first, last) };
+    auto const m = n - n % s;
+
+    univariate_accumulator<wide> acc;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (std::ptrdiff_t i = 0; i < m; i += s) {
+            wide const x = detail::load<wide, Aligned>(first, f);
+            acc(x);
+            sketch(x);
+            detail::advance(s, first);
+        }
+    }, first);
+
+    // gather the remaining values with a scalar accumulator
+    auto scalar_acc = univariate_accumulator<T>::load_state(acc.stats());
+    for (; first < last; ++first) {
+        T const x = std::invoke(f, *first);
+        scalar_acc(x);
+        sketch(x);
+    }
+    return univariate_statistics(scalar_acc);
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates a sequence of (projected) values and counts them in a histogram in the same pass
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param hist  The histogram receiving the values (it may already hold values from previous calls)
+    \param first The begin iterator for the sequence
+    \param last  The end iterator for the sequence
+    \param f     A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    Every loaded SIMD vector updates the moments and the lane-private sub-histograms.
+*/
+template<std::floating_point T, std::input_iterator I, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto accumulate(histogram_accumulator<T>& hist, I first, std::sized_sentinel_for<I> auto last, F&& f = F{}) -> univariate_statistics
+{
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first, last) };
+    auto const m = n - n % s;
+
+    univariate_accumulator<wide> acc;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (std::ptrdiff_t i = 0; i < m; i += s) {
+            wide const x = detail::load<wide, Aligned>(first, f);
+            acc(x);
+            hist(x);
+            detail::advance(s, first);
+        }
+    }, first);
+
+    // gather the remaining values with a scalar accumulator
+    auto scalar_acc = univariate_accumulator<T>::load_state(acc.stats());
+    for (; first < last; ++first) {
+        T const x = std::invoke(f, *first);
+        scalar_acc(x);
+        hist(x);
+    }
+    return univariate_statistics(scalar_acc);
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates a sequence of (projected) values and counts them in a histogram using multiple threads
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param policy The parallel execution policy (number of threads and minimum chunk size)
+    \param hist   The histogram receiving the values (it may already hold values from previous calls)
+    \param first  The begin iterator for the sequence
+    \param last   The end iterator for the sequence
+    \param f      A projection mapping `std::iter_value_t<I>` to a scalar value (invoked concurrently)
+
+    Each chunk fills its own histogram with the bin layout of `hist`, the chunk histograms are merged at the end.
+*/
+template<std::floating_point T, std::random_access_iterator I, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto accumulate(parallel_policy const& policy, histogram_accumulator<T>& hist, I first, std::sized_sentinel_for<I> auto last, F&& f = F{}) -> univariate_statistics
+{
+    auto const n{ std::distance(first, last) };
+    auto partials = detail::parallel_chunks<eve::wide<T>::size()>(policy, n, [&](auto b, auto e) {
+        histogram_accumulator<T> chunk(hist.bins());
+        auto const stats = accumulate<T>(chunk, first + b, first + e, f);
+        return std::pair{ univariate_accumulator<double>::load_state(stats.count, stats.sum, stats.ssr), std::move(chunk) };
+    });
+    auto acc = partials.front().first;
+    hist += partials.front().second;
+    for (auto i = 1UL; i < partials.size(); ++i) {
+        acc += partials[i].first;
+        hist += partials[i].second;
+    }
+    return univariate_statistics(acc);
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates the (projected) values selected by a mask
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param first The begin iterator for the sequence
+    \param last  The end iterator for the sequence
+    \param mask  The begin iterator for the mask (values convertible to `bool`, true selects the value)
+    \param f     A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    The masked-out values add zero weight to the SIMD updates and are counted in the `skipped` field of the result.
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator M, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto accumulate_masked(I first, std::sized_sentinel_for<I> auto last, M mask, F&& f = F{}) noexcept -> univariate_statistics
+{
+    return detail::accumulate_selected<T, false>(first, std::distance(first, last), detail::none{}, mask, std::forward<F>(f));
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates the (projected) weighted values selected by a mask
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param first1 The begin iterator for the values
+    \param last1  The end iterator for the values
+    \param first2 The begin iterator for the weights
+    \param mask   The begin iterator for the mask (values convertible to `bool`, true selects the value)
+    \param f      A projection mapping `std::iter_value_t<I>` to a scalar value
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator M, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>> and std::is_arithmetic_v<std::iter_value_t<J>>
+inline auto accumulate_masked(I first1, std::sized_sentinel_for<I> auto last1, J first2, M mask, F&& f = F{}) noexcept -> univariate_statistics
+{
+    return detail::accumulate_selected<T, false>(first1, std::distance(first1, last1), first2, mask, std::forward<F>(f));
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Updates a SIMD accumulator with a sequence of (projected) values
+
+    \param acc   The SIMD accumulator
+    \param first The begin iterator for the sequence
+    \param last  The end iterator for the sequence
+    \param f     A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    Only whole SIMD vectors are consumed. The returned iterator points to the leftover values (fewer than the
+    SIMD width), which the caller is expected to feed to a scalar accumulator. This allows an accumulator to
+    process a stream of batches without reducing its state after each batch.
+*/
+template<eve::simd_value W, typename S, std::input_iterator I, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto update(univariate_accumulator<W, S>& acc, I first, std::sized_sentinel_for<I> auto last, F&& f = F{}) noexcept -> I
+{
+    auto constexpr s{ W::size() };
+    auto const n{ std::distance(first, last) };
+    auto const m = n - n % s;
+
+    detail::with_alignment<W>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (std::ptrdiff_t i = 0; i < m; i += s) {
+            acc(detail::load<W, Aligned>(first, f));
+            detail::advance(s, first);
+        }
+    }, first);
+    return first;
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Updates a SIMD accumulator with a sequence of (projected) weighted values
+
+    \param acc    The SIMD accumulator
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second (weights) sequence
+    \param f      A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    Returns the iterators to the leftover values and weights (see above).
+*/
+template<eve::simd_value W, typename S, std::input_iterator I, std::input_iterator J, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>> and std::is_arithmetic_v<std::iter_value_t<J>>
+inline auto update(univariate_accumulator<W, S>& acc, I first1, std::sized_sentinel_for<I> auto last1, J first2, F&& f = F{}) noexcept -> std::pair<I, J>
+{
+    auto constexpr s{ W::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m = n - n % s;
+
+    detail::with_alignment<W>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (std::ptrdiff_t i = 0; i < m; i += s) {
+            acc(detail::load<W, Aligned>(first1, f), detail::load<W, Aligned>(first2));
+            detail::advance(s, first1, first2);
+        }
+    }, first1, first2);
+    return { first1, first2 };
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Updates a histogram with a sequence of (projected) values
+
+    \param hist  The histogram
+    \param first The begin iterator for the sequence
+    \param last  The end iterator for the sequence
+    \param f     A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    The whole SIMD vectors are binned with vector arithmetic and the leftover values one at a time, so all the
+    values are consumed (a histogram has no state that needs reducing between batches).
+*/
+template<std::floating_point T, std::input_iterator I, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto update(histogram_accumulator<T>& hist, I first, std::sized_sentinel_for<I> auto last, F&& f = F{}) noexcept -> void
+{
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first, last) };
+    auto const m = n - n % s;
+
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (std::ptrdiff_t i = 0; i < m; i += s) {
+            hist(detail::load<wide, Aligned>(first, f));
+            detail::advance(s, first);
+        }
+    }, first);
+    for (; first < last; ++first) {
+        hist(static_cast<T>(std::invoke(f, *first)));
+    }
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Updates an exponentially weighted moving average with a sequence of (projected) samples
+
+    \param acc   The moving average accumulator
+    \param first The begin iterator for the samples
+    \param last  The end iterator for the samples
+    \param f     A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    The whole SIMD vectors are processed as a prefix scan and the leftover samples one at a time, so all the
+    samples are consumed in order.
+*/
+template<std::floating_point T, std::input_iterator I, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto update(ewma_accumulator<T>& acc, I first, std::sized_sentinel_for<I> auto last, F&& f = F{}) noexcept -> void
+{
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first, last) };
+    auto const m = n - n % s;
+
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (std::ptrdiff_t i = 0; i < m; i += s) {
+            acc(detail::load<wide, Aligned>(first, f));
+            detail::advance(s, first);
+        }
+    }, first);
+    for (; first < last; ++first) {
+        acc(static_cast<T>(std::invoke(f, *first)));
+    }
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Updates an exponentially weighted moving average and writes the moving mean and variance after each sample
+
+    \param acc      The moving average accumulator
+    \param first    The begin iterator for the samples
+    \param last     The end iterator for the samples
+    \param mean     The output iterator receiving the moving mean after each sample
+    \param variance The output iterator receiving the moving variance after each sample
+    \param f        A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    \return The output iterators past the last written values
+*/
+template<std::floating_point T, std::input_iterator I, std::output_iterator<T> O1, std::output_iterator<T> O2, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto update(ewma_accumulator<T>& acc, I first, std::sized_sentinel_for<I> auto last, O1 mean, O2 variance, F&& f = F{}) noexcept -> std::pair<O1, O2>
+{
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first, last) };
+    auto const m = n - n % s;
+
+    std::array<T, s> buffer;
+    auto write = [&](wide const& x, auto& out) {
+        eve::store(x, buffer.data());
+        out = std::copy(buffer.begin(), buffer.end(), out);
+    };
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (std::ptrdiff_t i = 0; i < m; i += s) {
+            auto const [mu, var] = acc(detail::load<wide, Aligned>(first, f));
+            write(mu, mean);
+            write(var, variance);
+            detail::advance(s, first);
+        }
+    }, first);
+    for (; first < last; ++first) {
+        acc(static_cast<T>(std::invoke(f, *first)));
+        *mean++ = static_cast<T>(acc.mean());
+        *variance++ = static_cast<T>(acc.variance());
+    }
+    return { mean, variance };
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates over the projected values from applying `BinaryOp` on the input sequences.
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats
+    \tparam BinaryOp Binary projection \f$op(a,b) \to c\f$
+    \tparam F1 Unary projection \f$f(x_1) \to a\f$
+    \tparam F2 Unary projection \f$f(x_2) \to b\f$
+
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param op     A binary projection mapping a tuple \f$(f_1(\cdot), f_2(\cdot))\f$ to a scalar value
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, typename BinaryOp, typename F1 = std::identity, typename F2 = std::identity>
+requires std::is_invocable_v<F1, std::iter_value_t<I>> and
+         std::is_invocable_v<F2, std::iter_value_t<J>> and
+         std::is_invocable_v<
+            BinaryOp,
+            std::invoke_result_t<F1, std::iter_value_t<I>>,
+            std::invoke_result_t<F2, std::iter_value_t<J>>
+         > and
+         concepts::arithmetic_projection<
+            BinaryOp,
+            std::invoke_result_t<F1, std::iter_value_t<I>>,
+            std::invoke_result_t<F2, std::iter_value_t<J>>
+         >
+inline auto accumulate(I first1, std::sized_sentinel_for<I> auto last1, J first2, BinaryOp&& op = BinaryOp{}, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> univariate_statistics
+{
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m = n - n % s;
+
+    auto f = [&](auto a, auto b){
+        return std::invoke(std::forward<BinaryOp>(op), std::invoke(std::forward<F1>(f1), a), std::invoke(std::forward<F2>(f2), b));
+    };
+
+    if (n < s) {
+        univariate_accumulator<T> scalar_acc;
+        for (; first1 < last1; ++first1, ++first2) {
+            scalar_acc(f(*first1, *first2));
+        }
+        return univariate_statistics(scalar_acc);
+    }
+
+    std::array<T, s> x;
+    univariate_accumulator<wide> acc;
+    for (size_t i = 0; i < m; i += s) {
+        std::transform(first1, first1 + s, first2, x.begin(), f);
+        acc(wide{x.data()});
+        detail::advance(s, first1, first2);
+    }
+
+    // use a scalar accumulator to gather the remaining values
+    if (m < n) {
+        auto [sw, sx, sxx] = acc.stats();
+        auto scalar_acc = univariate_accumulator<T>::load_state(sw, sx, sxx);
+        for (; first1 < last1; ++first1, ++first2) {
+            scalar_acc(f(*first1, *first2));
+        }
+        return univariate_statistics(scalar_acc);
+    }
+    return univariate_statistics(acc);
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates over the projected values from applying `BinaryOp` on the input sequences, with weights
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats
+    \tparam BinaryOp Binary projection \f$op(a,b) \to c\f$
+    \tparam F1 Unary projection \f$f(x_1) \to a\f$
+    \tparam F2 Unary projection \f$f(x_2) \to b\f$
+
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param first3 The begin iterator for the third sequence (weights)
+    \param op     A binary projection mapping a tuple \f$(f_1(\bullet), f_2(\bullet))\f$ to a scalar value
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K, typename BinaryOp, typename F1 = std::identity, typename F2 = std::identity>
+requires std::is_arithmetic_v<std::iter_value_t<K>> &&
+         std::is_invocable_v<F1, std::iter_value_t<I>> &&
+         std::is_invocable_v<F2, std::iter_value_t<J>> &&
+         std::is_invocable_v<
+            BinaryOp,
+            std::invoke_result_t<F1, std::iter_value_t<I>>,
+            std::invoke_result_t<F2, std::iter_value_t<J>>
+         > &&
+         concepts::arithmetic_projection<
+            BinaryOp,
+            std::invoke_result_t<F1, std::iter_value_t<I>>,
+            std::invoke_result_t<F2, std::iter_value_t<J>>
+         >
+inline auto accumulate(I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, BinaryOp&& op = BinaryOp{}, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> univariate_statistics
+{
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m = n - n % s;
+
+    auto f = [&](auto a, auto b){
+        return std::invoke(std::forward<BinaryOp>(op), std::invoke(std::forward<F1>(f1), a), std::invoke(std::forward<F2>(f2), b));
+    };
+
+    if (n < s) {
+        univariate_accumulator<T> scalar_acc;
+        for (; first1 < last1; ++first1, ++first2, ++first3) {
+            scalar_acc(f(*first1, *first2), *first3);
+        }
+        return univariate_statistics(scalar_acc);
+    }
+
+    std::array<T, s> x;
+    univariate_accumulator<wide> acc;
+    for (size_t i = 0; i < m; i += s) {
+        std::transform(first1, first1 + s, first2, x.begin(), f);
+        acc(wide(x), wide(first3, first3 + s));
+        detail::advance(s, first1, first2, first3);
+    }
+
+    // use a scalar accumulator to gather the remaining values
+    if (m < n) {
+        auto [sw, sx, sxx] = acc.stats();
+        auto scalar_acc = univariate_accumulator<T>::load_state(sw, sx, sxx);
+        for (; first1 < last1; ++first1, ++first2, ++first3) {
+            scalar_acc(f(*first1, *first2), *first3);
+        }
+        return univariate_statistics(scalar_acc);
+    }
+    return univariate_statistics(acc);
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates the central moments (up to the fourth order) of a sequence of (projected) values
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param first The begin iterator for the first sequence
+    \param last  The end iterator for the first sequence
+    \param f     A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    Computes the skewness and the excess kurtosis (along with the mean and variance) in a single pass. The
+    regular `accumulate` methods do not track the higher moments and are not affected by this.
+*/
+template<std::floating_point T, std::input_iterator I, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto accumulate_moments(I first, std::sized_sentinel_for<I> auto last, F&& f = F{}) noexcept -> moments_statistics
+{
+    return moments_statistics(detail::accumulate_moments<T>(first, std::distance(first, last), detail::none{}, std::forward<F>(f)));
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates the central moments (up to the fourth order) of a sequence of (projected) weighted values
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second (weights) sequence
+    \param f      A projection mapping `std::iter_value_t<I>` to a scalar value
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>> and std::is_arithmetic_v<std::iter_value_t<J>>
+inline auto accumulate_moments(I first1, std::sized_sentinel_for<I> auto last1, J first2, F&& f = F{}) noexcept -> moments_statistics
+{
+    return moments_statistics(detail::accumulate_moments<T>(first1, std::distance(first1, last1), first2, std::forward<F>(f)));
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Accumulates the central moments of a sequence of (projected) values using multiple threads
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param policy The parallel execution policy (number of threads and minimum chunk size)
+    \param first  The begin iterator for the first sequence
+    \param last   The end iterator for the first sequence
+    \param f      A projection mapping `std::iter_value_t<I>` to a scalar value (invoked concurrently)
+
+    The partial moments of the chunks are merged in chunk order with the pairwise formulas by Pébay.
+*/
+template<std::floating_point T, std::random_access_iterator I, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto accumulate_moments(parallel_policy const& policy, I first, std::sized_sentinel_for<I> auto last, F&& f = F{}) -> moments_statistics
+{
+    auto const n{ std::distance(first, last) };
+    auto const partials = detail::parallel_chunks<eve::wide<T>::size()>(policy, n, [&](auto b, auto e) {
+        return detail::accumulate_moments<T>(first + b, e - b, detail::none{}, f);
+    });
+    auto acc = partials.front();
+    for (auto i = 1UL; i < partials.size(); ++i) {
+        acc += partials[i];
+    }
+    return moments_statistics(acc);
+}
+
+/*!
+    \ingroup Univariate
+
+    \brief Computes the mean and variance of a sliding window over a sequence of (projected) values
+
+    \tparam T The scalar value type of the computations and of the outputs
+
+    \param first    The begin iterator for the sequence
+    \param last     The end iterator for the sequence
+    \param window   The number of values in the window
+    \param mean     The output iterator receiving the mean of each window
+    \param variance The output iterator receiving the (population) variance of each window
+    \param f        A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    One value is written for each value of the sequence, for the window ending at that value. The first
+    `window - 1` outputs (incomplete windows) are NaN, as are the outputs for windows containing a NaN. Sliding
+    the window costs a constant number of operations, and the exact state of the window is recomputed every
+    `rolling_accumulator<T>::recompute_interval(window)` steps to bound the accumulated rounding errors.
+
+    \return The output iterators past the last written values
+*/
+template<std::floating_point T, std::random_access_iterator I, std::output_iterator<T> O1, std::output_iterator<T> O2, typename F = std::identity>
+requires concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto rolling(I first, std::sized_sentinel_for<I> auto last, std::size_t window, O1 mean, O2 variance, F&& f = F{}) noexcept -> std::pair<O1, O2>
+{
+    VSTAT_EXPECT(window > 0);
+    auto const n{ std::distance(first, last) };
+    auto const w{ static_cast<std::ptrdiff_t>(window) };
+    auto constexpr nan{ std::numeric_limits<T>::quiet_NaN() };
+    for (std::ptrdiff_t i = 0; i < std::min(w - 1, n); ++i) {
+        *mean++ = nan;
+        *variance++ = nan;
+    }
+    if (n < w) {
+        return { mean, variance };
+    }
+
+    rolling_accumulator<T> acc(window);
+    auto recompute = [&](std::ptrdiff_t end) {
+        auto const stats = accumulate<T>(first + (end - w), first + end, f);
+        acc.load_state(static_cast<T>(stats.mean), static_cast<T>(stats.ssr));
+    };
+    // the number of non-finite values in the window, which make the state non-finite until it is recomputed
+    std::ptrdiff_t nonfinite{0};
+    for (std::ptrdiff_t i = 0; i < w; ++i) {
+        nonfinite += static_cast<std::ptrdiff_t>(!std::isfinite(static_cast<T>(std::invoke(f, first[i]))));
+    }
+    recompute(w);
+    *mean++ = acc.mean();
+    *variance++ = acc.variance();
+
+    auto const interval{ rolling_accumulator<T>::recompute_interval(window) };
+    std::size_t updates{0};
+    for (auto i = w; i < n; ++i) {
+        T const x_old = std::invoke(f, first[i - w]);
+        T const x_new = std::invoke(f, first[i]);
+        nonfinite += static_cast<std::ptrdiff_t>(!std::isfinite(x_new)) - static_cast<std::ptrdiff_t>(!std::isfinite(x_old));
+        acc.replace(x_old, x_new);
+        if (++updates == interval || (nonfinite == 0 && !std::isfinite(acc.mean() + acc.variance()))) {
+            recompute(i + 1);
+            updates = 0;
+        }
+        *mean++ = acc.mean();
+        *variance++ = acc.variance();
+    }
+    return { mean, variance };
+}
+} // namespace univariate
+
+namespace bivariate {
+/*!
+    \defgroup Bivariate Bivariate statistics
+
+    \brief Methods for bivariate statistics
+*/
+
+/*!
+    \ingroup Bivariate
+
+    \brief Compute bivariate statistics from two sequences of values. The values can be provided directly or via a projection method.
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+
+    \b Example
+
+    \code
+    float x[] = { 1., 1., 2., 6. };
+    float y[] = { 2., 4., 3., 1. };
+    auto stats = bivariate::accumulate<float>(std::begin(x), std::end(x), std::begin(y));
+    std::cout << stats << "\n";
+    // results
+    count:                  4
+    sum_x:                  10
+    ssr_x:                  17
+    mean_x:                 2.5
+    variance_x:             4.25
+    sample variance_x:      5.66667
+    sum_y:                  10
+    ssr_y:                  5
+    mean_y:                 2.5
+    variance_y:             1.25
+    sample variance_y:      1.66667
+    correlation:            -0.759257
+    covariance:             -1.75
+    sample covariance:      -2.33333
+    \endcode
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, typename F1 = std::identity, typename F2 = std::identity>
+requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> and
+         concepts::arithmetic_projection<F2, std::iter_value_t<J>>
+inline auto accumulate(I first1, std::sized_sentinel_for<I> auto last1, J first2, F1&& f1 = F1{}, F2&& f2 = F2{})
+{
+    using wide = eve::wide<T>;
+    auto constexpr s { wide::size() };
+    auto const n { std::distance(first1, last1) };
+    auto const m = n - n % s;
+
+    if (n < s) {
+        bivariate_accumulator<T> scalar_acc;
+        for (; first1 < last1; ++first1, ++first2) {
+            scalar_acc(std::invoke(std::forward<F1>(f1), *first1), std::invoke(std::forward<F2>(f2), *first2));
+        }
+        return bivariate_statistics(scalar_acc);
+    }
+
+    bivariate_accumulator<wide> acc;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (size_t i = 0; i < m; i += s) {
+            acc(detail::load<wide, Aligned>(first1, std::forward<F1>(f1)), detail::load<wide, Aligned>(first2, std::forward<F2>(f2)));
+            detail::advance(s, first1, first2);
+        }
+    }, first1, first2);
+
+    if (m < n) {
+        auto [sw, sx, sy, sxx, syy, sxy] = acc.stats();
+        auto scalar_acc = bivariate_accumulator<T>::load_state(sx, sy, sw, sxx, syy, sxy);
+        for (; first1 < last1; ++first1, ++first2) {
+            scalar_acc(std::invoke(std::forward<F1>(f1), *first1), std::invoke(std::forward<F2>(f2), *first2));
+        }
+        return bivariate_statistics(scalar_acc);
+    }
+
+    return bivariate_statistics(acc);
+}
+
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K, typename F1 = std::identity, typename F2 = std::identity>
+requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> and
+         concepts::arithmetic_projection<F2, std::iter_value_t<J>> and
+         std::is_arithmetic_v<std::iter_value_t<K>>
+inline auto accumulate(I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> bivariate_statistics
+{
+    using wide = eve::wide<T>;
+    auto constexpr s { wide::size() };
+    auto const n = std::distance(first1, last1);
+    auto const m = n - n % s;
+
+    if (n < s) {
+        bivariate_accumulator<T> scalar_acc;
+        for (; first1 < last1; ++first1, ++first2, ++first3) {
+            scalar_acc(std::invoke(std::forward<F1>(f1), *first1), std::invoke(std::forward<F2>(f2), *first2), *first3);
+        }
+        return bivariate_statistics(scalar_acc);
+    }
+
+    bivariate_accumulator<wide> acc;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (size_t i = 0; i < m; i += s) {
+            acc(
+                detail::load<wide, Aligned>(first1, std::forward<F1>(f1)),
+                detail::load<wide, Aligned>(first2, std::forward<F2>(f2)),
+                detail::load<wide, Aligned>(first3)
+            );
+            detail::advance(s, first1, first2, first3);
+        }
+    }, first1, first2, first3);
+
+    if (m < n) {
+        auto [sw, sx, sy, sxx, syy, sxy] = acc.stats();
+        auto scalar_acc = bivariate_accumulator<T>::load_state(sx, sy, sw, sxx, syy, sxy);
+        for (; first1 < last1; ++first1, ++first2, ++first3) {
+            scalar_acc(std::invoke(std::forward<F1>(f1), *first1), std::invoke(std::forward<F2>(f2), *first2), *first3);
+        }
+        return bivariate_statistics(scalar_acc);
+    }
+    return bivariate_statistics(acc);
+}
+
+/*!
+    \ingroup Bivariate
+
+    \brief Compute bivariate statistics from two sequences of values using multiple threads
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param policy The parallel execution policy (number of threads and minimum chunk size)
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value (invoked concurrently)
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value (invoked concurrently)
+*/
+template<std::floating_point T, std::random_access_iterator I, std::random_access_iterator J, typename F1 = std::identity, typename F2 = std::identity>
+requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> and
+         concepts::arithmetic_projection<F2, std::iter_value_t<J>>
+inline auto accumulate(parallel_policy const& policy, I first1, std::sized_sentinel_for<I> auto last1, J first2, F1&& f1 = F1{}, F2&& f2 = F2{}) -> bivariate_statistics
+{
+    auto const n{ std::distance(first1, last1) };
+    auto const partials = detail::parallel_chunks<eve::wide<T>::size()>(policy, n, [&](auto b, auto e) {
+        auto const stats = accumulate<T>(first1 + b, first1 + e, first2 + b, f1, f2);
+        return std::tuple{ stats.count, stats.sum_x, stats.sum_y, stats.ssr_x, stats.ssr_y, stats.sum_xy };
+    });
+    auto [sw, sx, sy, sxx, syy, sxy] = detail::merge_partials(partials);
+    return bivariate_statistics(bivariate_accumulator<double>::load_state(sx, sy, sw, sxx, syy, sxy));
+}
+
+/*!
+    \ingroup Bivariate
+
+    \brief Compute weighted bivariate statistics from two sequences of values using multiple threads
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param policy The parallel execution policy (number of threads and minimum chunk size)
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param first3 The begin iterator for the third sequence (weights)
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value (invoked concurrently)
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value (invoked concurrently)
+*/
+template<std::floating_point T, std::random_access_iterator I, std::random_access_iterator J, std::random_access_iterator K, typename F1 = std::identity, typename F2 = std::identity>
+requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> and
+         concepts::arithmetic_projection<F2, std::iter_value_t<J>> and
+         std::is_arithmetic_v<std::iter_value_t<K>>
+inline auto accumulate(parallel_policy const& policy, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, F1&& f1 = F1{}, F2&& f2 = F2{}) -> bivariate_statistics
+{
+    auto const n{ std::distance(first1, last1) };
+    auto const partials = detail::parallel_chunks<eve::wide<T>::size()>(policy, n, [&](auto b, auto e) {
+        auto const stats = accumulate<T>(first1 + b, first1 + e, first2 + b, first3 + b, f1, f2);
+        return std::tuple{ stats.count, stats.sum_x, stats.sum_y, stats.ssr_x, stats.ssr_y, stats.sum_xy };
+    });
+    auto [sw, sx, sy, sxx, syy, sxy] = detail::merge_partials(partials);
+    return bivariate_statistics(bivariate_accumulator<double>::load_state(sx, sy, sw, sxx, syy, sxy));
+}
+
+/*!
+    \ingroup Bivariate
+
+    \brief Compute bivariate statistics from two sequences of values using the division-free blocked kernel
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, typename F1 = std::identity, typename F2 = std::identity>
+requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> and
+         concepts::arithmetic_projection<F2, std::iter_value_t<J>>
+inline auto accumulate_blocked(I first1, std::sized_sentinel_for<I> auto last1, J first2, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> bivariate_statistics
+{
+    using wide = eve::wide<T>;
+    auto constexpr s { wide::size() };
+    auto const n { std::distance(first1, last1) };
+
+    bivariate_accumulator<wide> acc;
+    detail::accumulate_blocked<2>(acc, first1, first2, n / s, f1, f2);
+
+    auto [sw, sx, sy, sxx, syy, sxy] = acc.stats();
+    auto scalar_acc = bivariate_accumulator<T>::load_state(sx, sy, sw, sxx, syy, sxy);
+    for (; first1 < last1; ++first1, ++first2) {
+        scalar_acc(std::invoke(f1, *first1), std::invoke(f2, *first2));
+    }
+    return bivariate_statistics(scalar_acc);
+}
+
+/*!
+    \ingroup Bivariate
+
+    \brief Accumulates two sequences of (projected) values, skipping the pairs that contain NaNs
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats.
+
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+
+    Only pairwise-complete observations are used. The number of skipped pairs is reported in the `skipped` field
+    of the result.
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, typename F1 = std::identity, typename F2 = std::identity>
+requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> and
+         concepts::arithmetic_projection<F2, std::iter_value_t<J>>
+inline auto accumulate(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> bivariate_statistics
+{
+    return detail::accumulate_selected<T, true>(first1, std::distance(first1, last1), first2, detail::none{}, detail::none{}, std::forward<F1>(f1), std::forward<F2>(f2));
+}
+
+/*!
+    \ingroup Bivariate
+
+    \brief Accumulates two sequences of (projected) weighted values, skipping the pairs that contain NaNs
+
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param first3 The begin iterator for the weights
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K, typename F1 = std::identity, typename F2 = std::identity>
+requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> and
+         concepts::arithmetic_projection<F2, std::iter_value_t<J>> and
+         std::is_arithmetic_v<std::iter_value_t<K>>
+inline auto accumulate(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> bivariate_statistics
+{
+    return detail::accumulate_selected<T, true>(first1, std::distance(first1, last1), first2, first3, detail::none{}, std::forward<F1>(f1), std::forward<F2>(f2));
+}
+
+/*!
+    \ingroup Bivariate
+
+    \brief Accumulates the pairs of (projected) values selected by a mask
+
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param mask   The begin iterator for the mask (values convertible to `bool`, true selects the pair)
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator M, typename F1 = std::identity, typename F2 = std::identity>
+requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> and
+         concepts::arithmetic_projection<F2, std::iter_value_t<J>>
+inline auto accumulate_masked(I first1, std::sized_sentinel_for<I> auto last1, J first2, M mask, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> bivariate_statistics
+{
+    return detail::accumulate_selected<T, false>(first1, std::distance(first1, last1), first2, detail::none{}, mask, std::forward<F1>(f1), std::forward<F2>(f2));
+}
+
+/*!
+    \ingroup Bivariate
+
+    \brief Accumulates the pairs of (projected) weighted values selected by a mask
+
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param first3 The begin iterator for the weights
+    \param mask   The begin iterator for the mask (values convertible to `bool`, true selects the pair)
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K, std::input_iterator M, typename F1 = std::identity, typename F2 = std::identity>
+requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> and
+         concepts::arithmetic_projection<F2, std::iter_value_t<J>> and
+         std::is_arithmetic_v<std::iter_value_t<K>>
+inline auto accumulate_masked(I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, M mask, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> bivariate_statistics
+{
+    return detail::accumulate_selected<T, false>(first1, std::distance(first1, last1), first2, first3, mask, std::forward<F1>(f1), std::forward<F2>(f2));
+}
+
+/*!
+    \ingroup Bivariate
+
+    \brief Updates a SIMD accumulator with two sequences of (projected) values
+
+    \param acc    The SIMD accumulator
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+
+    Only whole SIMD vectors are consumed. The returned iterators point to the leftover values (fewer than the
+    SIMD width), which the caller is expected to feed to a scalar accumulator.
+*/
+template<eve::simd_value W, typename S, std::input_iterator I, std::input_iterator J, typename F1 = std::identity, typename F2 = std::identity>
+requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> and
+         concepts::arithmetic_projection<F2, std::iter_value_t<J>>
+inline auto update(bivariate_accumulator<W, S>& acc, I first1, std::sized_sentinel_for<I> auto last1, J first2, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> std::pair<I, J>
+{
+    auto constexpr s{ W::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m = n - n % s;
+
+    detail::with_alignment<W>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (std::ptrdiff_t i = 0; i < m; i += s) {
+            acc(detail::load<W, Aligned>(first1, f1), detail::load<W, Aligned>(first2, f2));
+            detail::advance(s, first1, first2);
+        }
+    }, first1, first2);
+    return { first1, first2 };
+}
+
+/*!
+    \ingroup Bivariate
+
+    \brief Updates a SIMD accumulator with two sequences of (projected) weighted values
+
+    \param acc    The SIMD accumulator
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param first3 The begin iterator for the third (weights) sequence
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+
+    Returns the iterators to the leftover values and weights (see above).
+*/
+template<eve::simd_value W, typename S, std::input_iterator I, std::input_iterator J, std::input_iterator K, typename F1 = std::identity, typename F2 = std::identity>
+requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> and
+         concepts::arithmetic_projection<F2, std::iter_value_t<J>> and
+         std::is_arithmetic_v<std::iter_value_t<K>>
+inline auto update(bivariate_accumulator<W, S>& acc, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> std::tuple<I, J, K>
+{
+    auto constexpr s{ W::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m = n - n % s;
+
+    detail::with_alignment<W>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (std::ptrdiff_t i = 0; i < m; i += s) {
+            acc(detail::load<W, Aligned>(first1, f1), detail::load<W, Aligned>(first2, f2), detail::load<W, Aligned>(first3));
+            detail::advance(s, first1, first2, first3);
+        }
+    }, first1, first2, first3);
+    return { first1, first2, first3 };
+}
+
+/*!
+    \ingroup Bivariate
+
+    \brief Computes the covariance and correlation of a sliding window over two sequences of (projected) values
+
+    \tparam T The scalar value type of the computations and of the outputs
+
+    \param first1      The begin iterator for the first sequence
+    \param last1       The end iterator for the first sequence
+    \param first2      The begin iterator for the second sequence
+    \param window      The number of pairs in the window
+    \param covariance  The output iterator receiving the (population) covariance of each window
+    \param correlation The output iterator receiving the correlation of each window
+    \param f1          A projection mapping `std::iter_value_t<I>` to a scalar value
+    \param f2          A projection mapping `std::iter_value_t<J>` to a scalar value
+
+    The outputs follow the conventions of `univariate::rolling`.
+
+    \return The output iterators past the last written values
+*/
+template<std::floating_point T, std::random_access_iterator I, std::random_access_iterator J, std::output_iterator<T> O1, std::output_iterator<T> O2, typename F1 = std::identity, typename F2 = std::identity>
+requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> && concepts::arithmetic_projection<F2, std::iter_value_t<J>>
+inline auto rolling(I first1, std::sized_sentinel_for<I> auto last1, J first2, std::size_t window, O1 covariance, O2 correlation, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> std::pair<O1, O2>
+{
+    VSTAT_EXPECT(window > 0);
+    auto const n{ std::distance(first1, last1) };
+    auto const w{ static_cast<std::ptrdiff_t>(window) };
+    auto constexpr nan{ std::numeric_limits<T>::quiet_NaN() };
+    for (std::ptrdiff_t i = 0; i < std::min(w - 1, n); ++i) {
+        *covariance++ = nan;
+        *correlation++ = nan;
+    }
+    if (n < w) {
+        return { covariance, correlation };
+    }
+
+    rolling_bivariate_accumulator<T> acc(window);
+    auto recompute = [&](std::ptrdiff_t end) {
+        auto const b = end - w;
+        auto const stats = accumulate<T>(first1 + b, first1 + end, first2 + b, f1, f2);
+        acc.load_state(static_cast<T>(stats.mean_x), static_cast<T>(stats.mean_y), static_cast<T>(stats.ssr_x), static_cast<T>(stats.ssr_y), static_cast<T>(stats.sum_xy));
+    };
+    auto nonfinite_pair = [](T x, T y) { return static_cast<std::ptrdiff_t>(!std::isfinite(x + y)); };
+    std::ptrdiff_t nonfinite{0};
+    for (std::ptrdiff_t i = 0; i < w; ++i) {
+        nonfinite += nonfinite_pair(std::invoke(f1, first1[i]), std::invoke(f2, first2[i]));
+    }
+    recompute(w);
+    *covariance++ = acc.covariance();
+    *correlation++ = acc.correlation();
+
+    auto const interval{ rolling_accumulator<T>::recompute_interval(window) };
+    std::size_t updates{0};
+    for (auto i = w; i < n; ++i) {
+        T const x_old = std::invoke(f1, first1[i - w]);
+        T const y_old = std::invoke(f2, first2[i - w]);
+        T const x_new = std::invoke(f1, first1[i]);
+        T const y_new = std::invoke(f2, first2[i]);
+        nonfinite += nonfinite_pair(x_new, y_new) - nonfinite_pair(x_old, y_old);
+        acc.replace(x_old, y_old, x_new, y_new);
+        if (++updates == interval || (nonfinite == 0 && !std::isfinite(acc.covariance()))) {
+            recompute(i + 1);
+            updates = 0;
+        }
+        *covariance++ = acc.covariance();
+        *correlation++ = acc.correlation();
+    }
+    return { covariance, correlation };
+}
+} // namespace bivariate
+
+namespace multivariate {
+/*!
+    \defgroup Multivariate Multivariate statistics
+
+    \brief Methods for multivariate statistics (covariance and correlation matrices)
+*/
+
+/*!
+    \ingroup Multivariate
+
+    \brief Accumulates the rows of a matrix, each row being one observation
+
+    \tparam T The scalar value type of the matrix, also used for the `eve::wide<T>` SIMD type
+
+    \param data       Pointer to the first element of the matrix
+    \param rows       The number of rows (observations)
+    \param cols       The number of columns (features)
+    \param row_stride The distance between the first elements of two consecutive rows (in elements)
+    \param col_stride The distance between two consecutive elements of a row (in elements)
+*/
+template<std::floating_point T>
+inline auto accumulate(T const* data, std::size_t rows, std::size_t cols, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride = 1) -> multivariate_statistics
+{
+    multivariate_accumulator<T> acc(cols);
+    acc(data, rows, row_stride, col_stride);
+    return multivariate_statistics(acc);
+}
+
+/*!
+    \ingroup Multivariate
+
+    \brief Accumulates the weighted rows of a matrix, each row being one observation
+
+    \tparam T The scalar value type of the matrix, also used for the `eve::wide<T>` SIMD type
+
+    \param data       Pointer to the first element of the matrix
+    \param weights    Pointer to the weights (one per row)
+    \param rows       The number of rows (observations)
+    \param cols       The number of columns (features)
+    \param row_stride The distance between the first elements of two consecutive rows (in elements)
+    \param col_stride The distance between two consecutive elements of a row (in elements)
+*/
+template<std::floating_point T>
+inline auto accumulate(T const* data, T const* weights, std::size_t rows, std::size_t cols, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride = 1) -> multivariate_statistics
+{
+    multivariate_accumulator<T> acc(cols);
+    acc(data, weights, rows, row_stride, col_stride);
+    return multivariate_statistics(acc);
+}
+
+/*!
+    \ingroup Multivariate
+
+    \brief Accumulates the rows of a matrix using multiple threads
+
+    \tparam T The scalar value type of the matrix, also used for the `eve::wide<T>` SIMD type
+
+    \param policy     The parallel execution policy (the minimum chunk size is given in elements)
+    \param data       Pointer to the first element of the matrix
+    \param rows       The number of rows (observations)
+    \param cols       The number of columns (features)
+    \param row_stride The distance between the first elements of two consecutive rows (in elements)
+    \param col_stride The distance between two consecutive elements of a row (in elements)
+
+    The rows are split in contiguous chunks and the partial accumulators are merged in chunk order.
+*/
+template<std::floating_point T>
+inline auto accumulate(parallel_policy const& policy, T const* data, std::size_t rows, std::size_t cols, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride = 1) -> multivariate_statistics
+{
+    parallel_policy const row_policy{ policy.threads, std::max<std::size_t>(1, policy.min_chunk_size / std::max<std::size_t>(1, cols)) };
+    auto partials = detail::parallel_chunks<1>(row_policy, static_cast<std::ptrdiff_t>(rows), [&](auto b, auto e) {
+        multivariate_accumulator<T> acc(cols);
+        acc(data + b * row_stride, static_cast<std::size_t>(e - b), row_stride, col_stride);
+        acc.flush();
+        return acc;
+    });
+    for (auto p = partials.begin() + 1; p < partials.end(); ++p) {
+        partials.front() += *p;
+    }
+    return multivariate_statistics(partials.front());
+}
+} // namespace multivariate
+
+namespace detail {
+    // true if the key refers to a group of a table with the given number of groups
+    template<std::integral K>
+    inline auto valid_key(K key, std::size_t groups) noexcept -> bool
+    {
+        return std::cmp_greater_equal(key, 0) && std::cmp_less(key, groups);
+    }
+
+    // runs of keys shorter than this are accumulated one value at a time instead of with the SIMD kernels
+    template<std::floating_point T>
+    auto constexpr min_grouped_run{ 4 * eve::wide<T>::size() };
+} // namespace detail
+
+namespace grouped {
+/*!
+    \defgroup Grouped Grouped statistics
+
+    \brief Methods for statistics of groups of values identified by integer keys (group by)
+*/
+
+/*!
+    \ingroup Grouped
+
+    \brief Accumulates the (projected) values of each group, the groups being given by a parallel sequence of keys
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used for long runs of equal keys.
+
+    \param first  The begin iterator for the values
+    \param last   The end iterator for the values
+    \param keys   The begin iterator for the keys (integers in `[0, groups)`, other keys are counted as skipped)
+    \param groups The number of groups
+    \param f      A projection mapping `std::iter_value_t<I>` to a scalar value
+
+    When the keys are sorted, each group is a run of consecutive values: the long runs are accumulated with the
+    SIMD kernel and merged into the table in one step. Otherwise every value updates the entry of its group.
+
+    \return A table with the state of each group
+*/
+template<std::floating_point T, std::random_access_iterator I, std::random_access_iterator K, typename F = std::identity>
+requires std::integral<std::iter_value_t<K>> && concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto accumulate(I first, std::sized_sentinel_for<I> auto last, K keys, std::size_t groups, F&& f = F{}) -> grouped_table
+{
+    auto const n{ std::distance(first, last) };
+    grouped_table table(groups);
+
+    if (std::is_sorted(keys, keys + n)) {
+        for (std::ptrdiff_t b = 0; b < n;) {
+            auto const key = keys[b];
+            auto e = b + 1;
+            for (; e < n && keys[e] == key; ++e) { }
+            if (!detail::valid_key(key, groups)) {
+                table.skipped += static_cast<std::size_t>(e - b);
+            } else if (e - b >= detail::min_grouped_run<T>) {
+                auto const stats = univariate::accumulate<T>(first + b, first + e, f);
+                table.merge(static_cast<std::size_t>(key), std::tuple{ stats.count, stats.sum, stats.ssr });
+            } else {
+                for (auto i = b; i < e; ++i) {
+                    table(static_cast<std::size_t>(key), static_cast<double>(std::invoke(f, first[i])));
+                }
+            }
+            b = e;
+        }
+        return table;
+    }
+
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+        auto const key = keys[i];
+        if (detail::valid_key(key, groups)) {
+            table(static_cast<std::size_t>(key), static_cast<double>(std::invoke(f, first[i])));
+        } else {
+            ++table.skipped;
+        }
+    }
+    return table;
+}
+
+/*!
+    \ingroup Grouped
+
+    \brief Accumulates the (projected) pairs of values of each group, the groups being given by a parallel sequence of keys
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used for long runs of equal keys.
+
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param keys   The begin iterator for the keys (integers in `[0, groups)`, other keys are counted as skipped)
+    \param groups The number of groups
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value
+
+    \return A table with the (bivariate) state of each group
+*/
+template<std::floating_point T, std::random_access_iterator I, std::random_access_iterator J, std::random_access_iterator K, typename F1 = std::identity, typename F2 = std::identity>
+requires std::integral<std::iter_value_t<K>> && concepts::arithmetic_projection<F1, std::iter_value_t<I>> && concepts::arithmetic_projection<F2, std::iter_value_t<J>>
+inline auto accumulate(I first1, std::sized_sentinel_for<I> auto last1, J first2, K keys, std::size_t groups, F1&& f1 = F1{}, F2&& f2 = F2{}) -> grouped_table
+{
+    auto const n{ std::distance(first1, last1) };
+    grouped_table table(groups, /*bivariate=*/true);
+    auto update = [&](std::size_t key, std::ptrdiff_t i) {
+        table(key, static_cast<double>(std::invoke(f1, first1[i])), static_cast<double>(std::invoke(f2, first2[i])));
+    };
+
+    if (std::is_sorted(keys, keys + n)) {
+        for (std::ptrdiff_t b = 0; b < n;) {
+            auto const key = keys[b];
+            auto e = b + 1;
+            for (; e < n && keys[e] == key; ++e) { }
+            if (!detail::valid_key(key, groups)) {
+                table.skipped += static_cast<std::size_t>(e - b);
+            } else if (e - b >= detail::min_grouped_run<T>) {
+                auto const s = bivariate::accumulate<T>(first1 + b, first1 + e, first2 + b, f1, f2);
+                table.merge(static_cast<std::size_t>(key), std::tuple{ s.count, s.sum_x, s.sum_y, s.ssr_x, s.ssr_y, s.sum_xy });
+            } else {
+                for (auto i = b; i < e; ++i) {
+                    update(static_cast<std::size_t>(key), i);
+                }
+            }
+            b = e;
+        }
+        return table;
+    }
+
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+        auto const key = keys[i];
+        if (detail::valid_key(key, groups)) {
+            update(static_cast<std::size_t>(key), i);
+        } else {
+            ++table.skipped;
+        }
+    }
+    return table;
+}
+
+/*!
+    \ingroup Grouped
+
+    \brief Accumulates the (projected) values of each group using multiple threads
+
+    \param policy The parallel execution policy (number of threads and minimum chunk size)
+    \param first  The begin iterator for the values
+    \param last   The end iterator for the values
+    \param keys   The begin iterator for the keys
+    \param groups The number of groups
+    \param f      A projection mapping `std::iter_value_t<I>` to a scalar value (invoked concurrently)
+
+    Each thread fills a private table for its chunk of the values, the tables are merged with `combine`.
+*/
+template<std::floating_point T, std::random_access_iterator I, std::random_access_iterator K, typename F = std::identity>
+requires std::integral<std::iter_value_t<K>> && concepts::arithmetic_projection<F, std::iter_value_t<I>>
+inline auto accumulate(parallel_policy const& policy, I first, std::sized_sentinel_for<I> auto last, K keys, std::size_t groups, F&& f = F{}) -> grouped_table
+{
+    auto const n{ std::distance(first, last) };
+    auto partials = detail::parallel_chunks<eve::wide<T>::size()>(policy, n, [&](auto b, auto e) {
+        return accumulate<T>(first + b, first + e, keys + b, groups, f);
+    });
+    for (auto i = 1UL; i < partials.size(); ++i) {
+        partials.front() += partials[i];
+    }
+    return std::move(partials.front());
+}
+
+/*!
+    \ingroup Grouped
+
+    \brief Accumulates the (projected) pairs of values of each group using multiple threads
+
+    \param policy The parallel execution policy (number of threads and minimum chunk size)
+    \param first1 The begin iterator for the first sequence
+    \param last1  The end iterator for the first sequence
+    \param first2 The begin iterator for the second sequence
+    \param keys   The begin iterator for the keys
+    \param groups The number of groups
+    \param f1     A projection mapping `std::iter_value_t<I>` to a scalar value (invoked concurrently)
+    \param f2     A projection mapping `std::iter_value_t<J>` to a scalar value (invoked concurrently)
+*/
+template<std::floating_point T, std::random_access_iterator I, std::random_access_iterator J, std::random_access_iterator K, typename F1 = std::identity, typename F2 = std::identity>
+requires std::integral<std::iter_value_t<K>> && concepts::arithmetic_projection<F1, std::iter_value_t<I>> && concepts::arithmetic_projection<F2, std::iter_value_t<J>>
+inline auto accumulate(parallel_policy const& policy, I first1, std::sized_sentinel_for<I> auto last1, J first2, K keys, std::size_t groups, F1&& f1 = F1{}, F2&& f2 = F2{}) -> grouped_table
+{
+    auto const n{ std::distance(first1, last1) };
+    auto partials = detail::parallel_chunks<eve::wide<T>::size()>(policy, n, [&](auto b, auto e) {
+        return accumulate<T>(first1 + b, first1 + e, first2 + b, keys + b, groups, f1, f2);
+    });
+    for (auto i = 1UL; i < partials.size(); ++i) {
+        partials.front() += partials[i];
+    }
+    return std::move(partials.front());
+}
+} // namespace grouped
+
+namespace detail {
+    // concatenates the values accumulated by a set of metrics (see metrics::evaluate). the residual is computed
+    // once and shared by all the metrics. a metric that uses the weights itself (e.g. poisson) provides the
+    // weighted overloads of `values` and `weights`, the others use the weights as sample weights.
+    template<typename... Metrics>
+    struct metric_set {
+        static auto constexpr size{ (Metrics::size + ...) };
+
+        template<typename V>
+        static auto values(V const& y_true, V const& y_pred) noexcept -> std::array<V, size> {
+            V const e = y_true - y_pred;
+            return std::apply([](auto const&... v) { return std::array<V, size>{ v... }; },
+                std::tuple_cat(Metrics::values(y_true, y_pred, e)...));
+        }
+
+        template<typename V>
+        static auto values(V const& y_true, V const& y_pred, V const& w) noexcept -> std::array<V, size> {
+            V const e = y_true - y_pred;
+            auto const weighted_values = [&]<typename Metric>(Metric /*unused*/) {
+                if constexpr (requires { Metric::values(y_true, y_pred, e, w); }) {
+                    return Metric::values(y_true, y_pred, e, w);
+                } else {
+                    return Metric::values(y_true, y_pred, e);
+                }
+            };
+            return std::apply([](auto const&... v) { return std::array<V, size>{ v... }; },
+                std::tuple_cat(weighted_values(Metrics{})...));
+        }
+
+        // the weights of the accumulated values
+        template<typename V>
+        static auto weights(V const& w) noexcept -> std::array<V, size> {
+            auto const sample_weights = [&]<typename Metric>(Metric /*unused*/) {
+                if constexpr (requires { Metric::weights(w); }) {
+                    return Metric::weights(w);
+                } else {
+                    std::array<V, Metric::size> ws;
+                    ws.fill(w);
+                    return ws;
+                }
+            };
+            return std::apply([](auto const&... v) { return std::array<V, size>{ v... }; },
+                std::tuple_cat(sample_weights(Metrics{})...));
+        }
+
+        static auto finalize(std::span<univariate_statistics const, size> stats) noexcept -> std::array<double, sizeof...(Metrics)> {
+            std::array<double, sizeof...(Metrics)> result{};
+            std::size_t i{0};
+            std::size_t offset{0};
+            ((result[i++] = Metrics::finalize(stats.subspan(offset, Metrics::size)), offset += Metrics::size), ...);
+            return result;
+        }
+
+        template<typename T>
+        static auto finalize(std::array<univariate_accumulator<T>, size> const& acc) noexcept -> std::array<double, sizeof...(Metrics)> {
+            auto const stats = std::apply([](auto const&... a) { return std::array<univariate_statistics, size>{ univariate_statistics(a)... }; }, acc);
+            return finalize(stats);
+        }
+    };
+
+    // evaluates the metrics over the selected pairs (see accumulate_selected above), the number of rejected pairs is
+    // stored in `skipped`
+    template<std::floating_point T, bool SkipNan, typename... Metrics, std::input_iterator I, std::input_iterator J, typename K, typename M>
+    auto inline evaluate_selected(I first1, std::ptrdiff_t n, J first2, K first3, M mask, std::size_t& skipped) noexcept -> std::array<double, sizeof...(Metrics)> {
+        using wide = eve::wide<T>;
+        using set = metric_set<Metrics...>;
+        auto constexpr s{ wide::size() };
+        auto constexpr weighted{ !std::same_as<K, none> };
+        auto const m{ n - n % s };
+        std::ptrdiff_t rejected{0};
+
+        std::array<univariate_accumulator<wide>, set::size> acc;
+        with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+            for (std::ptrdiff_t i = 0; i < m; i += s) {
+                wide const y_true = load<wide, Aligned>(first1);
+                wide const y_pred = load<wide, Aligned>(first2);
+                if constexpr (weighted) {
+                    wide const w = load<wide>(first3);
+                    auto const v = set::values(y_true, y_pred, w);
+                    auto const ws = set::weights(w);
+                    auto const valid = select<SkipNan, wide>(mask, y_true, y_pred, w);
+                    bool const all = eve::all(valid);
+                    for (std::size_t k = 0; k < set::size; ++k) {
+                        all ? acc[k](v[k], ws[k]) : acc[k](v[k], ws[k], valid);
+                    }
+                    if (!all) { rejected += s - eve::count_true(valid); }
+                } else {
+                    auto const v = set::values(y_true, y_pred);
+                    auto const valid = select<SkipNan, wide>(mask, y_true, y_pred);
+                    bool const all = eve::all(valid);
+                    for (std::size_t k = 0; k < set::size; ++k) {
+                        all ? acc[k](v[k]) : acc[k](v[k], valid);
+                    }
+                    if (!all) { rejected += s - eve::count_true(valid); }
+                }
+                advance(s, first1, first2, first3, mask);
+            }
+        }, first1, first2);
+
+        // use scalar accumulators for the remaining values
+        std::array<univariate_accumulator<T>, set::size> tail;
+        for (std::size_t k = 0; k < set::size; ++k) {
+            tail[k] = univariate_accumulator<T>::load_state(acc[k].stats());
+        }
+        for (std::ptrdiff_t i = m; i < n; ++i) {
+            auto const y_true = static_cast<T>(*first1);
+            auto const y_pred = static_cast<T>(*first2);
+            if constexpr (weighted) {
+                auto const w = static_cast<T>(*first3);
+                if (select_scalar<SkipNan>(mask, y_true, y_pred, w)) {
+                    auto const v = set::values(y_true, y_pred, w);
+                    auto const ws = set::weights(w);
+                    for (std::size_t k = 0; k < set::size; ++k) { tail[k](v[k], ws[k]); }
+                } else {
+                    ++rejected;
+                }
+            } else {
+                if (select_scalar<SkipNan>(mask, y_true, y_pred)) {
+                    auto const v = set::values(y_true, y_pred);
+                    for (std::size_t k = 0; k < set::size; ++k) { tail[k](v[k]); }
+                } else {
+                    ++rejected;
+                }
+            }
+            advance(1, first1, first2, first3, mask);
+        }
+        skipped = static_cast<std::size_t>(rejected);
+
+        return set::finalize(tail);
+    }
+} // namespace detail
+
+namespace metrics {
+/*!
+    \defgroup Metrics Regression metrics
+
+    \brief Regression metrics (R2, MSE, MLSE, MAE).
+*/
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes the coefficient of determination \f$R^2\f$
+
+    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats
+
+    \f{align}{
+        R^2(y, \hat{y}) &= 1 - \frac{\text{RSS}}{\text{TSS}}\text{, where}\\
+        \text{RSS} &= \sum_{i=1}^n \left( y - \hat{y} \right)^2\\
+        \text{TSS} &= \sum_{i=1}^n \left( y - \bar{y} \right)^2\\
+    \f}
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J>
+inline auto r2_score(I first1, std::sentinel_for<I> auto last1, J first2) noexcept -> double {
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m{ n - n % s };
+
+    univariate_accumulator<wide> wx;
+    univariate_accumulator<wide> wy;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            wide y_true = detail::load<wide, Aligned>(first1);
+            wide y_pred = detail::load<wide, Aligned>(first2);
+            wx(eve::sqr(y_true-y_pred));
+            wy(y_true);
+            detail::advance(s, first1, first2);
+        }
+    }, first1, first2);
+
+    // use scalar accumulators for the remaining values
+    auto sx = univariate_accumulator<T>::load_state(wx.stats());
+    auto sy = univariate_accumulator<T>::load_state(wy.stats());
+
+    for(; first1 < last1; ++first1, ++first2) {
+        sx(eve::sqr(*first1 - *first2));
+        sy(*first1);
+    }
+
+    auto const rss = univariate_statistics(sx).sum;
+    auto const tss = univariate_statistics(sy).ssr;
+
+    return tss < std::numeric_limits<double>::epsilon()
+        ? std::numeric_limits<double>::lowest()
+        : 1.0 - rss / tss;
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes the weighted coefficient of determination \f$R^2\f$
+
+    \f{align}{
+        R^2(y, \hat{y}) &= 1 - \frac{\text{RSS}}{\text{TSS}}\text{, where}\\
+        \text{RSS} &= \sum_{i=1}^n w_i \left( y - \hat{y} \right)^2\\
+        \text{TSS} &= \sum_{i=1}^n w_i \left( y - \bar{y} \right)^2\\
+    \f}
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+inline auto r2_score(I first1, std::sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m{ n - n % s };
+
+    univariate_accumulator<wide> wx;
+    univariate_accumulator<wide> wy;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            wide y_true = detail::load<wide, Aligned>(first1);
+            wide y_pred = detail::load<wide, Aligned>(first2);
+            wide weight = detail::load<wide, Aligned>(first3);
+            wx(eve::sqr(y_true-y_pred), weight);
+            wy(y_true, weight);
+            detail::advance(s, first1, first2, first3);
+        }
+    }, first1, first2, first3);
+
+    // use scalar accumulators for the remaining values
+    auto sx = univariate_accumulator<T>::load_state(wx.stats());
+    auto sy = univariate_accumulator<T>::load_state(wy.stats());
+
+    for(; first1 < last1; ++first1, ++first2, ++first3) {
+        sx(eve::sqr(*first1 - *first2), *first3);
+        sy(*first1, *first3);
+    }
+
+    auto const rss = univariate_statistics(sx).sum;
+    auto const tss = univariate_statistics(sy).ssr;
+
+    return tss < std::numeric_limits<double>::epsilon()
+        ? std::numeric_limits<double>::lowest()
+        : 1.0 - rss / tss;
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes the mean squared error
+
+    \f[
+        \text{MSE}(y, \hat{y}) = \displaystyle \frac{1}{n} {\sum_{i=1}^n \left(y-\hat{y}\right)^2}
+    \f]
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J>
+inline auto mean_squared_error(I first1, std::sentinel_for<I> auto last1, J first2) noexcept -> double {
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m{ n - n % s };
+
+    univariate_accumulator<wide> we;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            wide y_true = detail::load<wide, Aligned>(first1);
+            wide y_pred = detail::load<wide, Aligned>(first2);
+            we(eve::sqr(y_true-y_pred));
+            detail::advance(s, first1, first2);
+        }
+    }, first1, first2);
+
+    // use scalar accumulators for the remaining values
+    auto se = univariate_accumulator<T>::load_state(we.stats());
+    for(; first1 < last1; ++first1, ++first2) {
+        se(eve::sqr(*first1 - *first2));
+    }
+    return univariate_statistics(se).mean;
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes the weighted mean squared error
+
+    \f[
+        \text{MSE}(y, \hat{y}) = {\displaystyle \frac{1}{\sum_{i=1}^n w_i}} \sum_{i=1}^n w_i \left(y-\hat{y}\right)^2
+    \f]
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+inline auto mean_squared_error(I first1, std::sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m{ n - n % s };
+
+    univariate_accumulator<wide> we;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            wide y_true = detail::load<wide, Aligned>(first1);
+            wide y_pred = detail::load<wide, Aligned>(first2);
+            wide weight = detail::load<wide, Aligned>(first3);
+            we(eve::sqr(y_true-y_pred), weight);
+            detail::advance(s, first1, first2, first3);
+        }
+    }, first1, first2, first3);
+
+    // use scalar accumulators for the remaining values
+    auto se = univariate_accumulator<T>::load_state(we.stats());
+    for(; first1 < last1; ++first1, ++first2, ++first3) {
+        se(eve::sqr(*first1 - *first2), *first3);
+    }
+    return univariate_statistics(se).mean;
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes the mean squared logarithmic error
+
+    \f[
+        \text{MSLE}(y, \hat{y}) = \frac{1}{n} \sum_{i=1}^{n} (\log_e (1 + y_i) - \log_e (1 + \hat{y}_i) )^2
+    \f]
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J>
+inline auto mean_squared_log_error(I first1, std::sentinel_for<I> auto last1, J first2) noexcept -> double {
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m{ n - n % s };
+
+    univariate_accumulator<wide> we;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            wide y_true = detail::load<wide, Aligned>(first1);
+            wide y_pred = detail::load<wide, Aligned>(first2);
+            we(eve::sqr(eve::log1p(y_true)-eve::log1p(y_pred)));
+            detail::advance(s, first1, first2);
+        }
+    }, first1, first2);
+
+    // use scalar accumulators for the remaining values
+    auto se = univariate_accumulator<T>::load_state(we.stats());
+    for(; first1 < last1; ++first1, ++first2) {
+        se(eve::sqr(eve::log1p(*first1) - eve::log1p(*first2)));
+    }
+    return univariate_statistics(se).mean;
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes the weighted mean squared logarithmic error
+
+    \f[
+        \text{MSLE}(y, \hat{y}) = \frac{1}{\sum_{i=1}^n w_i} \sum_{i=1}^{n} w_i (\log_e (1 + y_i) - \log_e (1 + \hat{y}_i) )^2
+    \f]
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+inline auto mean_squared_log_error(I first1, std::sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m{ n - n % s };
+
+    univariate_accumulator<wide> we;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            wide y_true = detail::load<wide, Aligned>(first1);
+            wide y_pred = detail::load<wide, Aligned>(first2);
+            wide weight = detail::load<wide, Aligned>(first3);
+            we(eve::sqr(eve::log1p(y_true)-eve::log1p(y_pred)), weight);
+            detail::advance(s, first1, first2, first3);
+        }
+    }, first1, first2, first3);
+
+    // use scalar accumulators for the remaining values
+    auto se = univariate_accumulator<T>::load_state(we.stats());
+    for(; first1 < last1; ++first1, ++first2, ++first3) {
+        se(eve::sqr(eve::log1p(*first1) - eve::log1p(*first2)), *first3);
+    }
+    return univariate_statistics(se).mean;
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes the mean absolute error
+
+    \f[
+        \text{MAE}(y, \hat{y}) = \displaystyle \frac{1}{n} {\sum_{i=1}^n |y-\hat{y}|}
+    \f]
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J>
+inline auto mean_absolute_error(I first1, std::sentinel_for<I> auto last1, J first2) noexcept -> double {
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m{ n - n % s };
+
+    univariate_accumulator<wide> we;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            wide y_true = detail::load<wide, Aligned>(first1);
+            wide y_pred = detail::load<wide, Aligned>(first2);
+            we(eve::abs(y_true-y_pred));
+            detail::advance(s, first1, first2);
+        }
+    }, first1, first2);
+
+    // use scalar accumulators for the remaining values
+    auto se = univariate_accumulator<T>::load_state(we.stats());
+    for(; first1 < last1; ++first1, ++first2) {
+        se(eve::abs(*first1 - *first2));
+    }
+    return univariate_statistics(se).mean;
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Weighted mean absolute error
+
+    \f[
+        \text{MAE}(y, \hat{y}) = \displaystyle \frac{1}{\sum_{i=1}^n w_i} \sum_{i=1}^n w_i |y-\hat{y}|
+    \f]
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+inline auto mean_absolute_error(I first1, std::sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m{ n - n % s };
+
+    univariate_accumulator<wide> we;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            wide y_true = detail::load<wide, Aligned>(first1);
+            wide y_pred = detail::load<wide, Aligned>(first2);
+            wide weight = detail::load<wide, Aligned>(first3);
+            we(eve::abs(y_true-y_pred), weight);
+            detail::advance(s, first1, first2, first3);
+        }
+    }, first1, first2, first3);
+
+    // use scalar accumulators for the remaining values
+    auto se = univariate_accumulator<T>::load_state(we.stats());
+    for(; first1 < last1; ++first1, ++first2, ++first3) {
+        se(eve::abs(*first1 - *first2), *first3);
+    }
+    return univariate_statistics(se).mean;
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes the mean absolute error
+
+    \tparam T
+
+    \f[
+        \text{MAPE}(y, \hat{y}) = \frac{1}{n} \sum_{i=1}^{n} \frac{{}\left| y_i - \hat{y}_i \right|}{\max(\epsilon, \left| y_i \right|)}
+    \f]
+    where \f$\epsilon\f$ = `std::numeric_limits<T>::epsilon()` is an arbitrarily small constant to prevent division by zero.
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J>
+inline auto mean_absolute_percentage_error(I first1, std::sentinel_for<I> auto last1, J first2) noexcept -> double {
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m{ n - n % s };
+
+    auto constexpr eps{ std::numeric_limits<T>::epsilon() };
+
+    univariate_accumulator<wide> we;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            wide y_true = detail::load<wide, Aligned>(first1);
+            wide y_pred = detail::load<wide, Aligned>(first2);
+            we(eve::abs(y_true-y_pred) / eve::max(eps, eve::abs(y_true)));
+            detail::advance(s, first1, first2);
+        }
+    }, first1, first2);
+
+    // use scalar accumulators for the remaining values
+    auto se = univariate_accumulator<T>::load_state(we.stats());
+    for(; first1 < last1; ++first1, ++first2) {
+        se(eve::abs(*first1 - *first2) / eve::max(eps, eve::abs(*first1)));
+    }
+    return univariate_statistics(se).mean;
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Weighted mean absolute percentage error
 
-    if (m < n) {
-        auto [sw, sx, sy, sxx, syy, sxy] = acc.stats();
-        auto scalar_acc = bivariate_accumulator<T>::load_state(sx, sy, sw, sxx, syy, sxy);
-        for (; first1 < last1; ++first1, ++first2) {
-            scalar_acc(std::invoke(std::forward<F1>(f1), *first1), std::invoke(std::forward<F2>(f2), *first2));
+    \f[
+        \text{WMAPE}(y, \hat{y}) = \displaystyle \frac{1}{\sum_i^n w_i} \frac{\sum_{i=1}^n w_i |y-\hat{y}|}{\max(\epsilon, \left| y_i \right|)}
+    \f]
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+inline auto mean_absolute_percentage_error(I first1, std::sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m{ n - n % s };
+    auto constexpr eps{ std::numeric_limits<T>::epsilon() };
+
+    univariate_accumulator<wide> we;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            wide y_true = detail::load<wide, Aligned>(first1);
+            wide y_pred = detail::load<wide, Aligned>(first2);
+            wide weight = detail::load<wide, Aligned>(first3);
+            we(eve::abs(y_true-y_pred) / eve::max(eps, eve::abs(y_true)), weight);
+            detail::advance(s, first1, first2, first3);
         }
-        return bivariate_statistics(scalar_acc);
-    }
+    }, first1, first2, first3);
 
-    return bivariate_statistics(acc);
+    // use scalar accumulators for the remaining values
+    auto se = univariate_accumulator<T>::load_state(we.stats());
+    for(; first1 < last1; ++first1, ++first2, ++first3) {
+        se(eve::abs(*first1 - *first2) / eve::max(eps, eve::abs(*first1)), *first3);
+    }
+    return univariate_statistics(se).mean;
 }
 
-template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K, typename F1 = std::identity, typename F2 = std::identity>
-requires concepts::arithmetic_projection<F1, std::iter_value_t<I>> and
-         concepts::arithmetic_projection<F2, std::iter_value_t<J>> and
-         std::is_arithmetic_v<std::iter_value_t<K>>
-inline auto accumulate(I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, F1&& f1 = F1{}, F2&& f2 = F2{}) noexcept -> bivariate_statistics
-{
+/*!
+    \ingroup Metrics
+
+    \brief Negative log likelihood loss with Poisson distribution of target.
+
+    \f[
+        -\log\mathcal{L}_\text{poisson}(y, \hat{y}) = \hat{y} - y \cdot \log(\hat{y}) + \ln(|\Gamma(y)|)
+    \f] where \f$\Gamma(y)\f$ is returned by <a href="https://jfalcou.github.io/eve/group__special_gae09a3d5ef50adfebd1d42611611cae5a.html#gae09a3d5ef50adfebd1d42611611cae5a">eve::gamma_p</a>.
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J>
+inline auto poisson_neg_likelihood_loss(I first1, std::sentinel_for<I> auto last1, J first2) noexcept -> double {
     using wide = eve::wide<T>;
-    auto constexpr s { wide::size() };
-    auto const n = std::distance(first1, last1);
-    auto const m = n - n % s;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m{ n - n % s };
 
-    if (n < s) {
-        bivariate_accumulator<T> scalar_acc;
-        for (; first1 < last1; ++first1, ++first2, ++first3) {
-            scalar_acc(std::invoke(std::forward<F1>(f1), *first1++), std::invoke(std::forward<F2>(f2), *first2++), *first3++);
+    auto constexpr eps{ std::numeric_limits<T>::epsilon() };
+
+    univariate_accumulator<wide> we;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            wide y_true = detail::load<wide, Aligned>(first1);
+            wide y_pred = detail::load<wide, Aligned>(first2);
+            we(y_pred - y_true * eve::log(y_pred) + eve::log_abs_gamma(T{1} + y_true));
+            detail::advance(s, first1, first2);
         }
-        return bivariate_statistics(scalar_acc);
-    }
+    }, first1, first2);
 
-    bivariate_accumulator<wide> acc;
-    for (size_t i = 0; i < m; i += s) {
-        acc(
-            detail::load<wide>(first1, std::forward<F1>(f1)),
-            detail::load<wide>(first2, std::forward<F2>(f2)),
-            wide(first3, first3 + s)
-        );
-        detail::advance(s, first1, first2, first3);
+    // use scalar accumulators for the remaining values
+    auto se = univariate_accumulator<T>::load_state(we.stats());
+    for(; first1 < last1; ++first1, ++first2) {
+        se(*first2 - *first1 * eve::log(*first2) + eve::log_abs_gamma(T{1} + *first1));
     }
+    return univariate_statistics(se).sum;
+}
 
-    if (m < n) {
-        auto [sw, sx, sy, sxx, syy, sxy] = acc.stats();
-        auto scalar_acc = bivariate_accumulator<T>::load_state(sx, sy, sw, sxx, syy, sxy);
-        for (; first1 < last1; ++first1, ++first2, ++first3) {
-            scalar_acc(std::invoke(std::forward<F1>(f1), *first1), std::invoke(std::forward<F2>(f2), *first2), *first3);
+/*!
+    \ingroup Metrics
+
+    \brief Negative log likelihood loss with Poisson distribution of target. The mean in each bin is multiplied by a weight before the Poisson likelihood is applied.
+
+    \f[
+        -\log\mathcal{L}_\text{poisson}(y, w \cdot \hat{y}) = \hat{y} - y \cdot \log(\hat{y}) + \ln(|\Gamma(y)|)
+    \f] where \f$\Gamma(y)\f$ is returned by <a href="https://jfalcou.github.io/eve/group__special_gae09a3d5ef50adfebd1d42611611cae5a.html#gae09a3d5ef50adfebd1d42611611cae5a">eve::gamma_p</a>.
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+inline auto poisson_neg_likelihood_loss(I first1, std::sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
+    using wide = eve::wide<T>;
+    auto constexpr s{ wide::size() };
+    auto const n{ std::distance(first1, last1) };
+    auto const m{ n - n % s };
+
+    auto constexpr eps{ std::numeric_limits<T>::epsilon() };
+
+    univariate_accumulator<wide> we;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            wide y_true = detail::load<wide, Aligned>(first1);
+            wide y_pred = eve::mul(detail::load<wide, Aligned>(first2), detail::load<wide, Aligned>(first3));
+            we(y_pred - y_true * eve::log(y_pred) + eve::log_abs_gamma(T{1} + y_true));
+            detail::advance(s, first1, first2, first3);
         }
-        return bivariate_statistics(scalar_acc);
+    }, first1, first2, first3);
+
+    // use scalar accumulators for the remaining values
+    auto se = univariate_accumulator<T>::load_state(we.stats());
+    for(; first1 < last1; ++first1, ++first2, ++first3) {
+        se(*first2 * *first3 - *first1 * eve::log(*first2 * *first3) + eve::log_abs_gamma(T{1} + *first1));
     }
-    return bivariate_statistics(acc);
+    return univariate_statistics(se).sum;
 }
-} // namespace bivariate
 
-namespace metrics {
 /*!
-    \defgroup Metrics Regression metrics
+    \ingroup Metrics
 
-    \brief Regression metrics (R2, MSE, MLSE, MAE).
+    \brief Tag types selecting the metrics computed by `evaluate`
+
+    A tag maps a batch of targets, predictions and residuals \f$e = y - \hat{y}\f$ (SIMD or scalar) to the `size`
+    values it needs to accumulate, and computes the metric from their statistics in `finalize`.
 */
+struct r2 {
+    static auto constexpr name{ "r2" };
+    static auto constexpr size{ 2UL };
+
+    template<typename V>
+    static auto values(V const& y_true, V const& /*y_pred*/, V const& e) noexcept -> std::array<V, size> {
+        return { eve::sqr(e), y_true };
+    }
+
+    static auto finalize(std::span<univariate_statistics const> stats) noexcept -> double {
+        auto const rss = stats[0].sum;
+        auto const tss = stats[1].ssr;
+        return tss < std::numeric_limits<double>::epsilon()
+            ? std::numeric_limits<double>::lowest()
+            : 1.0 - rss / tss;
+    }
+};
+
+//! \ingroup Metrics
+//! \brief Mean squared error tag (see `mean_squared_error`)
+struct mse {
+    static auto constexpr name{ "mse" };
+    static auto constexpr size{ 1UL };
+
+    template<typename V>
+    static auto values(V const& /*y_true*/, V const& /*y_pred*/, V const& e) noexcept -> std::array<V, size> {
+        return { eve::sqr(e) };
+    }
+
+    static auto finalize(std::span<univariate_statistics const> stats) noexcept -> double { return stats[0].mean; }
+};
+
+//! \ingroup Metrics
+//! \brief Mean squared logarithmic error tag (see `mean_squared_log_error`)
+struct msle {
+    static auto constexpr name{ "msle" };
+    static auto constexpr size{ 1UL };
+
+    template<typename V>
+    static auto values(V const& y_true, V const& y_pred, V const& /*e*/) noexcept -> std::array<V, size> {
+        return { eve::sqr(eve::log1p(y_true) - eve::log1p(y_pred)) };
+    }
+
+    static auto finalize(std::span<univariate_statistics const> stats) noexcept -> double { return stats[0].mean; }
+};
+
+//! \ingroup Metrics
+//! \brief Mean absolute error tag (see `mean_absolute_error`)
+struct mae {
+    static auto constexpr name{ "mae" };
+    static auto constexpr size{ 1UL };
+
+    template<typename V>
+    static auto values(V const& /*y_true*/, V const& /*y_pred*/, V const& e) noexcept -> std::array<V, size> {
+        return { eve::abs(e) };
+    }
+
+    static auto finalize(std::span<univariate_statistics const> stats) noexcept -> double { return stats[0].mean; }
+};
+
+//! \ingroup Metrics
+//! \brief Mean absolute percentage error tag (see `mean_absolute_percentage_error`)
+struct mape {
+    static auto constexpr name{ "mape" };
+    static auto constexpr size{ 1UL };
+
+    template<typename V>
+    static auto values(V const& y_true, V const& /*y_pred*/, V const& e) noexcept -> std::array<V, size> {
+        auto constexpr eps{ std::numeric_limits<eve::element_type_t<V>>::epsilon() };
+        return { eve::abs(e) / eve::max(eps, eve::abs(y_true)) };
+    }
+
+    static auto finalize(std::span<univariate_statistics const> stats) noexcept -> double { return stats[0].mean; }
+};
 
 /*!
     \ingroup Metrics
 
-    \brief Computes the coefficient of determination \f$R^2\f$
+    \brief Poisson negative log likelihood tag (see `poisson_neg_likelihood_loss`)
 
-    \tparam T The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats
+    When weights are given, the predictions are multiplied by the weights before the likelihood is applied.
+*/
+struct poisson {
+    static auto constexpr name{ "poisson" };
+    static auto constexpr size{ 1UL };
+
+    template<typename V>
+    static auto values(V const& y_true, V const& y_pred, V const& /*e*/) noexcept -> std::array<V, size> {
+        using T = eve::element_type_t<V>;
+        return { y_pred - y_true * eve::log(y_pred) + eve::log_abs_gamma(T{1} + y_true) };
+    }
 
-    \f{align}{
-        R^2(y, \hat{y}) &= 1 - \frac{\text{RSS}}{\text{TSS}}\text{, where}\\
-        \text{RSS} &= \sum_{i=1}^n \left( y - \hat{y} \right)^2\\
-        \text{TSS} &= \sum_{i=1}^n \left( y - \bar{y} \right)^2\\
-    \f}
+    template<typename V>
+    static auto values(V const& y_true, V const& y_pred, V const& e, V const& w) noexcept -> std::array<V, size> {
+        return values(y_true, y_pred * w, e);
+    }
+
+    // the losses are summed without sample weights
+    template<typename V>
+    static auto weights(V const& /*w*/) noexcept -> std::array<V, size> {
+        return { V{1} };
+    }
+
+    static auto finalize(std::span<univariate_statistics const> stats) noexcept -> double { return stats[0].sum; }
+};
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes several metrics in a single pass over the data
+
+    \tparam T       The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats
+    \tparam Metrics The metric tags (e.g. `r2`, `mse`, `mae`, `mape`, `poisson`)
+
+    The targets and predictions are read once and the residual is shared by all the metrics. The results are
+    returned in the order of the tags, for example:
+    ```cpp
+    auto [r2, mse] = metrics::evaluate<float, metrics::r2, metrics::mse>(y_true.begin(), y_true.end(), y_pred.begin());
+    ```
 */
-template<std::floating_point T, std::input_iterator I, std::input_iterator J>
-inline auto r2_score(I first1, std::sentinel_for<I> auto last1, J first2) noexcept -> double {
+template<std::floating_point T, typename... Metrics, std::input_iterator I, std::input_iterator J>
+requires (sizeof...(Metrics) > 0)
+inline auto evaluate(I first1, std::sentinel_for<I> auto last1, J first2) noexcept -> std::array<double, sizeof...(Metrics)> {
     using wide = eve::wide<T>;
+    using set = detail::metric_set<Metrics...>;
     auto constexpr s{ wide::size() };
     auto const n{ std::distance(first1, last1) };
     auto const m{ n - n % s };
 
-    univariate_accumulator<wide> wx;
-    univariate_accumulator<wide> wy;
-    for (auto i = 0; i < m; i += s) {
-        wide y_true{first1, first1+s};
-        wide y_pred{first2, first2+s};
-        wx(eve::sqr(y_true-y_pred));
-        wy(y_true);
-        detail::advance(s, first1, first2);
-    }
+    std::array<univariate_accumulator<wide>, set::size> acc;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            auto const v = set::values(detail::load<wide, Aligned>(first1), detail::load<wide, Aligned>(first2));
+            for (std::size_t k = 0; k < set::size; ++k) {
+                acc[k](v[k]);
+            }
+            detail::advance(s, first1, first2);
+        }
+    }, first1, first2);
 
     // use scalar accumulators for the remaining values
-    auto sx = univariate_accumulator<T>::load_state(wx.stats());
-    auto sy = univariate_accumulator<T>::load_state(wy.stats());
-
+    std::array<univariate_accumulator<T>, set::size> tail;
+    for (std::size_t k = 0; k < set::size; ++k) {
+        tail[k] = univariate_accumulator<T>::load_state(acc[k].stats());
+    }
     for(; first1 < last1; ++first1, ++first2) {
-        sx(eve::sqr(*first1 - *first2));
-        sy(*first1);
+        auto const v = set::values(static_cast<T>(*first1), static_cast<T>(*first2));
+        for (std::size_t k = 0; k < set::size; ++k) {
+            tail[k](v[k]);
+        }
     }
 
-    auto const rss = univariate_statistics(sx).sum;
-    auto const tss = univariate_statistics(sy).ssr;
-
-    return tss < std::numeric_limits<double>::epsilon()
-        ? std::numeric_limits<double>::lowest()
-        : 1.0 - rss / tss;
+    return set::finalize(tail);
 }
 
 /*!
     \ingroup Metrics
 
-    \brief Computes the weighted coefficient of determination \f$R^2\f$
+    \brief Computes several weighted metrics in a single pass over the data
 
-    \f{align}{
-        R^2(y, \hat{y}) &= 1 - \frac{\text{RSS}}{\text{TSS}}\text{, where}\\
-        \text{RSS} &= \sum_{i=1}^n w_i \left( y - \hat{y} \right)^2\\
-        \text{TSS} &= \sum_{i=1}^n w_i \left( y - \bar{y} \right)^2\\
-    \f}
+    \tparam T       The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats
+    \tparam Metrics The metric tags (e.g. `r2`, `mse`, `mae`, `mape`, `poisson`)
 */
-template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
-inline auto r2_score(I first1, std::sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
+template<std::floating_point T, typename... Metrics, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+requires (sizeof...(Metrics) > 0)
+inline auto evaluate(I first1, std::sentinel_for<I> auto last1, J first2, K first3) noexcept -> std::array<double, sizeof...(Metrics)> {
     using wide = eve::wide<T>;
+    using set = detail::metric_set<Metrics...>;
     auto constexpr s{ wide::size() };
     auto const n{ std::distance(first1, last1) };
     auto const m{ n - n % s };
 
-    univariate_accumulator<wide> wx;
-    univariate_accumulator<wide> wy;
-    for (auto i = 0; i < m; i += s) {
-        wide y_true{first1, first1+s};
-        wide y_pred{first2, first2+s};
-        wide weight{first3, first3+s};
-        wx(eve::sqr(y_true-y_pred), weight);
-        wy(y_true, weight);
-        detail::advance(s, first1, first2, first3);
-    }
+    std::array<univariate_accumulator<wide>, set::size> acc;
+    detail::with_alignment<wide>([&]<bool Aligned>(std::bool_constant<Aligned>) {
+        for (auto i = 0; i < m; i += s) {
+            wide const weight = detail::load<wide, Aligned>(first3);
+            auto const v = set::values(detail::load<wide, Aligned>(first1), detail::load<wide, Aligned>(first2), weight);
+            auto const ws = set::weights(weight);
+            for (std::size_t k = 0; k < set::size; ++k) {
+                acc[k](v[k], ws[k]);
+            }
+            detail::advance(s, first1, first2, first3);
+        }
+    }, first1, first2, first3);
 
     // use scalar accumulators for the remaining values
-    auto sx = univariate_accumulator<T>::load_state(wx.stats());
-    auto sy = univariate_accumulator<T>::load_state(wy.stats());
+    std::array<univariate_accumulator<T>, set::size> tail;
+    for (std::size_t k = 0; k < set::size; ++k) {
+        tail[k] = univariate_accumulator<T>::load_state(acc[k].stats());
+    }
+    for(; first1 < last1; ++first1, ++first2, ++first3) {
+        auto const weight = static_cast<T>(*first3);
+        auto const v = set::values(static_cast<T>(*first1), static_cast<T>(*first2), weight);
+        auto const ws = set::weights(weight);
+        for (std::size_t k = 0; k < set::size; ++k) {
+            tail[k](v[k], ws[k]);
+        }
+    }
+
+    return set::finalize(tail);
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes several metrics in a single pass over the data, skipping the pairs that contain NaNs
+
+    \tparam T       The scalar value type underlying the `eve::wide<T>` SIMD type used to compute the stats
+    \tparam Metrics The metric tags (e.g. `r2`, `mse`, `mae`, `mape`, `poisson`)
+
+    \param skipped Receives the number of skipped pairs
+*/
+template<std::floating_point T, typename... Metrics, std::input_iterator I, std::input_iterator J>
+requires (sizeof...(Metrics) > 0)
+inline auto evaluate(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, std::size_t& skipped) noexcept -> std::array<double, sizeof...(Metrics)> {
+    return detail::evaluate_selected<T, true, Metrics...>(first1, std::distance(first1, last1), first2, detail::none{}, detail::none{}, skipped);
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes several metrics in a single pass over the data, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, typename... Metrics, std::input_iterator I, std::input_iterator J>
+requires (sizeof...(Metrics) > 0)
+inline auto evaluate(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2) noexcept -> std::array<double, sizeof...(Metrics)> {
+    std::size_t skipped{0};
+    return evaluate<T, Metrics...>(skip_nan, first1, last1, first2, skipped);
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes several weighted metrics in a single pass over the data, skipping the pairs that contain NaNs
+
+    \param skipped Receives the number of skipped pairs
+*/
+template<std::floating_point T, typename... Metrics, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+requires (sizeof...(Metrics) > 0)
+inline auto evaluate(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, std::size_t& skipped) noexcept -> std::array<double, sizeof...(Metrics)> {
+    return detail::evaluate_selected<T, true, Metrics...>(first1, std::distance(first1, last1), first2, first3, detail::none{}, skipped);
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes several weighted metrics in a single pass over the data, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, typename... Metrics, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+requires (sizeof...(Metrics) > 0)
+inline auto evaluate(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3) noexcept -> std::array<double, sizeof...(Metrics)> {
+    std::size_t skipped{0};
+    return evaluate<T, Metrics...>(skip_nan, first1, last1, first2, first3, skipped);
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes several metrics over the pairs selected by a mask (values convertible to `bool`)
+
+    \param skipped Receives the number of pairs left out by the mask
+*/
+template<std::floating_point T, typename... Metrics, std::input_iterator I, std::input_iterator J, std::input_iterator M>
+requires (sizeof...(Metrics) > 0)
+inline auto evaluate_masked(I first1, std::sized_sentinel_for<I> auto last1, J first2, M mask, std::size_t& skipped) noexcept -> std::array<double, sizeof...(Metrics)> {
+    return detail::evaluate_selected<T, false, Metrics...>(first1, std::distance(first1, last1), first2, detail::none{}, mask, skipped);
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes several metrics over the pairs selected by a mask (values convertible to `bool`)
+*/
+template<std::floating_point T, typename... Metrics, std::input_iterator I, std::input_iterator J, std::input_iterator M>
+requires (sizeof...(Metrics) > 0)
+inline auto evaluate_masked(I first1, std::sized_sentinel_for<I> auto last1, J first2, M mask) noexcept -> std::array<double, sizeof...(Metrics)> {
+    std::size_t skipped{0};
+    return evaluate_masked<T, Metrics...>(first1, last1, first2, mask, skipped);
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes several weighted metrics over the pairs selected by a mask (values convertible to `bool`)
+
+    \param skipped Receives the number of pairs left out by the mask
+*/
+template<std::floating_point T, typename... Metrics, std::input_iterator I, std::input_iterator J, std::input_iterator K, std::input_iterator M>
+requires (sizeof...(Metrics) > 0)
+inline auto evaluate_masked(I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, M mask, std::size_t& skipped) noexcept -> std::array<double, sizeof...(Metrics)> {
+    return detail::evaluate_selected<T, false, Metrics...>(first1, std::distance(first1, last1), first2, first3, mask, skipped);
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes several weighted metrics over the pairs selected by a mask (values convertible to `bool`)
+*/
+template<std::floating_point T, typename... Metrics, std::input_iterator I, std::input_iterator J, std::input_iterator K, std::input_iterator M>
+requires (sizeof...(Metrics) > 0)
+inline auto evaluate_masked(I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, M mask) noexcept -> std::array<double, sizeof...(Metrics)> {
+    std::size_t skipped{0};
+    return evaluate_masked<T, Metrics...>(first1, last1, first2, first3, mask, skipped);
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes the coefficient of determination, skipping the pairs that contain NaNs
+
+    \param skipped Receives the number of skipped pairs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J>
+inline auto r2_score(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, std::size_t& skipped) noexcept -> double {
+    return evaluate<T, r2>(skip_nan, first1, last1, first2, skipped)[0];
+}
+
+/*!
+    \ingroup Metrics
+
+    \brief Computes the coefficient of determination, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J>
+inline auto r2_score(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2) noexcept -> double {
+    return evaluate<T, r2>(skip_nan, first1, last1, first2)[0];
+}
+
+/*!
+    \ingroup Metrics
 
-    for(; first1 < last1; ++first1, ++first2, ++first3) {
-        sx(eve::sqr(*first1 - *first2), *first3);
-        sy(*first1, *first3);
-    }
+    \brief Computes the weighted coefficient of determination, skipping the pairs that contain NaNs
 
-    auto const rss = univariate_statistics(sx).sum;
-    auto const tss = univariate_statistics(sy).ssr;
+    \param skipped Receives the number of skipped pairs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+inline auto r2_score(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, std::size_t& skipped) noexcept -> double {
+    return evaluate<T, r2>(skip_nan, first1, last1, first2, first3, skipped)[0];
+}
 
-    return tss < std::numeric_limits<double>::epsilon()
-        ? std::numeric_limits<double>::lowest()
-        : 1.0 - rss / tss;
+/*!
+    \ingroup Metrics
+
+    \brief Computes the weighted coefficient of determination, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+inline auto r2_score(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
+    return evaluate<T, r2>(skip_nan, first1, last1, first2, first3)[0];
 }
 
 /*!
     \ingroup Metrics
 
-    \brief Computes the mean squared error
+    \brief Computes the mean squared error, skipping the pairs that contain NaNs
 
-    \f[
-        \text{MSE}(y, \hat{y}) = \displaystyle \frac{1}{n} {\sum_{i=1}^n \left(y-\hat{y}\right)^2}
-    \f]
+    \param skipped Receives the number of skipped pairs
 */
 template<std::floating_point T, std::input_iterator I, std::input_iterator J>
-inline auto mean_squared_error(I first1, std::sentinel_for<I> auto last1, J first2) noexcept -> double {
-    using wide = eve::wide<T>;
-    auto constexpr s{ wide::size() };
-    auto const n{ std::distance(first1, last1) };
-    auto const m{ n - n % s };
+inline auto mean_squared_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, std::size_t& skipped) noexcept -> double {
+    return evaluate<T, mse>(skip_nan, first1, last1, first2, skipped)[0];
+}
 
-    univariate_accumulator<wide> we;
-    for (auto i = 0; i < m; i += s) {
-        wide y_true{first1, first1+s};
-        wide y_pred{first2, first2+s};
-        we(eve::sqr(y_true-y_pred));
-        detail::advance(s, first1, first2);
-    }
+/*!
+    \ingroup Metrics
 
-    // use scalar accumulators for the remaining values
-    auto se = univariate_accumulator<T>::load_state(we.stats());
-    for(; first1 < last1; ++first1, ++first2) {
-        se(eve::sqr(*first1 - *first2));
-    }
-    return univariate_statistics(se).mean;
+    \brief Computes the mean squared error, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J>
+inline auto mean_squared_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2) noexcept -> double {
+    return evaluate<T, mse>(skip_nan, first1, last1, first2)[0];
 }
 
 /*!
     \ingroup Metrics
 
-    \brief Computes the weighted mean squared error
+    \brief Computes the weighted mean squared error, skipping the pairs that contain NaNs
 
-    \f[
-        \text{MSE}(y, \hat{y}) = {\displaystyle \frac{1}{\sum_{i=1}^n w_i}} \sum_{i=1}^n w_i \left(y-\hat{y}\right)^2
-    \f]
+    \param skipped Receives the number of skipped pairs
 */
 template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
-inline auto mean_squared_error(I first1, std::sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
-    using wide = eve::wide<T>;
-    auto constexpr s{ wide::size() };
-    auto const n{ std::distance(first1, last1) };
-    auto const m{ n - n % s };
+inline auto mean_squared_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, std::size_t& skipped) noexcept -> double {
+    return evaluate<T, mse>(skip_nan, first1, last1, first2, first3, skipped)[0];
+}
 
-    univariate_accumulator<wide> we;
-    for (auto i = 0; i < m; i += s) {
-        wide y_true{first1, first1+s};
-        wide y_pred{first2, first2+s};
-        wide weight{first3, first3+s};
-        we(eve::sqr(y_true-y_pred), weight);
-        detail::advance(s, first1, first2, first3);
-    }
+/*!
+    \ingroup Metrics
 
-    // use scalar accumulators for the remaining values
-    auto se = univariate_accumulator<T>::load_state(we.stats());
-    for(; first1 < last1; ++first1, ++first2, ++first3) {
-        se(eve::sqr(*first1 - *first2), *first3);
-    }
-    return univariate_statistics(se).mean;
+    \brief Computes the weighted mean squared error, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+inline auto mean_squared_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
+    return evaluate<T, mse>(skip_nan, first1, last1, first2, first3)[0];
 }
 
 /*!
     \ingroup Metrics
 
-    \brief Computes the mean squared logarithmic error
+    \brief Computes the mean squared logarithmic error, skipping the pairs that contain NaNs
 
-    \f[
-        \text{MSLE}(y, \hat{y}) = \frac{1}{n} \sum_{i=1}^{n} (\log_e (1 + y_i) - \log_e (1 + \hat{y}_i) )^2
-    \f]
+    \param skipped Receives the number of skipped pairs
 */
 template<std::floating_point T, std::input_iterator I, std::input_iterator J>
-inline auto mean_squared_log_error(I first1, std::sentinel_for<I> auto last1, J first2) noexcept -> double {
-    using wide = eve::wide<T>;
-    auto constexpr s{ wide::size() };
-    auto const n{ std::distance(first1, last1) };
-    auto const m{ n - n % s };
+inline auto mean_squared_log_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, std::size_t& skipped) noexcept -> double {
+    return evaluate<T, msle>(skip_nan, first1, last1, first2, skipped)[0];
+}
 
-    univariate_accumulator<wide> we;
-    for (auto i = 0; i < m; i += s) {
-        wide y_true{first1, first1+s};
-        wide y_pred{first2, first2+s};
-        we(eve::sqr(eve::log1p(y_true)-eve::log1p(y_pred)));
-        detail::advance(s, first1, first2);
-    }
+/*!
+    \ingroup Metrics
 
-    // use scalar accumulators for the remaining values
-    auto se = univariate_accumulator<T>::load_state(we.stats());
-    for(; first1 < last1; ++first1, ++first2) {
-        se(eve::sqr(eve::log1p(*first1) - eve::log1p(*first2)));
-    }
-    return univariate_statistics(se).mean;
+    \brief Computes the mean squared logarithmic error, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J>
+inline auto mean_squared_log_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2) noexcept -> double {
+    return evaluate<T, msle>(skip_nan, first1, last1, first2)[0];
 }
 
 /*!
     \ingroup Metrics
 
-    \brief Computes the weighted mean squared logarithmic error
+    \brief Computes the weighted mean squared logarithmic error, skipping the pairs that contain NaNs
 
-    \f[
-        \text{MSLE}(y, \hat{y}) = \frac{1}{\sum_{i=1}^n w_i} \sum_{i=1}^{n} w_i (\log_e (1 + y_i) - \log_e (1 + \hat{y}_i) )^2
-    \f]
+    \param skipped Receives the number of skipped pairs
 */
 template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
-inline auto mean_squared_log_error(I first1, std::sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
-    using wide = eve::wide<T>;
-    auto constexpr s{ wide::size() };
-    auto const n{ std::distance(first1, last1) };
-    auto const m{ n - n % s };
+inline auto mean_squared_log_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, std::size_t& skipped) noexcept -> double {
+    return evaluate<T, msle>(skip_nan, first1, last1, first2, first3, skipped)[0];
+}
 
-    univariate_accumulator<wide> we;
-    for (auto i = 0; i < m; i += s) {
-        wide y_true{first1, first1+s};
-        wide y_pred{first2, first2+s};
-        wide weight{first3, first3+s};
-        we(eve::sqr(eve::log1p(y_true)-eve::log1p(y_pred)), weight);
-        detail::advance(s, first1, first2, first3);
-    }
+/*!
+    \ingroup Metrics
 
-    // use scalar accumulators for the remaining values
-    auto se = univariate_accumulator<T>::load_state(we.stats());
-    for(; first1 < last1; ++first1, ++first2, ++first3) {
-        se(eve::sqr(eve::log1p(*first1) - eve::log1p(*first2)), *first3);
-    }
-    return univariate_statistics(se).mean;
+    \brief Computes the weighted mean squared logarithmic error, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+inline auto mean_squared_log_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
+    return evaluate<T, msle>(skip_nan, first1, last1, first2, first3)[0];
 }
 
 /*!
     \ingroup Metrics
 
-    \brief Computes the mean absolute error
+    \brief Computes the mean absolute error, skipping the pairs that contain NaNs
 
-    \f[
-        \text{MAE}(y, \hat{y}) = \displaystyle \frac{1}{n} {\sum_{i=1}^n |y-\hat{y}|}
-    \f]
+    \param skipped Receives the number of skipped pairs
 */
 template<std::floating_point T, std::input_iterator I, std::input_iterator J>
-inline auto mean_absolute_error(I first1, std::sentinel_for<I> auto last1, J first2) noexcept -> double {
-    using wide = eve::wide<T>;
-    auto constexpr s{ wide::size() };
-    auto const n{ std::distance(first1, last1) };
-    auto const m{ n - n % s };
+inline auto mean_absolute_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, std::size_t& skipped) noexcept -> double {
+    return evaluate<T, mae>(skip_nan, first1, last1, first2, skipped)[0];
+}
 
-    univariate_accumulator<wide> we;
-    for (auto i = 0; i < m; i += s) {
-        wide y_true{first1, first1+s};
-        wide y_pred{first2, first2+s};
-        we(eve::abs(y_true-y_pred));
-        detail::advance(s, first1, first2);
-    }
+/*!
+    \ingroup Metrics
 
-    // use scalar accumulators for the remaining values
-    auto se = univariate_accumulator<T>::load_state(we.stats());
-    for(; first1 < last1; ++first1, ++first2) {
-        se(eve::abs(*first1 - *first2));
-    }
-    return univariate_statistics(se).mean;
+    \brief Computes the mean absolute error, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J>
+inline auto mean_absolute_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2) noexcept -> double {
+    return evaluate<T, mae>(skip_nan, first1, last1, first2)[0];
 }
 
 /*!
     \ingroup Metrics
 
-    \brief Weighted mean absolute error
+    \brief Computes the weighted mean absolute error, skipping the pairs that contain NaNs
 
-    \f[
-        \text{MAE}(y, \hat{y}) = \displaystyle \frac{1}{\sum_{i=1}^n w_i} \sum_{i=1}^n w_i |y-\hat{y}|
-    \f]
+    \param skipped Receives the number of skipped pairs
 */
 template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
-inline auto mean_absolute_error(I first1, std::sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
-    using wide = eve::wide<T>;
-    auto constexpr s{ wide::size() };
-    auto const n{ std::distance(first1, last1) };
-    auto const m{ n - n % s };
+inline auto mean_absolute_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, std::size_t& skipped) noexcept -> double {
+    return evaluate<T, mae>(skip_nan, first1, last1, first2, first3, skipped)[0];
+}
 
-    univariate_accumulator<wide> we;
-    for (auto i = 0; i < m; i += s) {
-        wide y_true{first1, first1+s};
-        wide y_pred{first2, first2+s};
-        wide weight{first3, first3+s};
-        we(eve::abs(y_true-y_pred), weight);
-        detail::advance(s, first1, first2, first3);
-    }
+/*!
+    \ingroup Metrics
 
-    // use scalar accumulators for the remaining values
-    auto se = univariate_accumulator<T>::load_state(we.stats());
-    for(; first1 < last1; ++first1, ++first2, ++first3) {
-        se(eve::abs(*first1 - *first2), *first3);
-    }
-    return univariate_statistics(se).mean;
+    \brief Computes the weighted mean absolute error, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+inline auto mean_absolute_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
+    return evaluate<T, mae>(skip_nan, first1, last1, first2, first3)[0];
 }
 
 /*!
     \ingroup Metrics
 
-    \brief Computes the mean absolute error
-
-    \tparam T
+    \brief Computes the mean absolute percentage error, skipping the pairs that contain NaNs
 
-    \f[
-        \text{MAPE}(y, \hat{y}) = \frac{1}{n} \sum_{i=1}^{n} \frac{{}\left| y_i - \hat{y}_i \right|}{\max(\epsilon, \left| y_i \right|)}
-    \f]
-    where \f$\epsilon\f$ = `std::numeric_limits<T>::epsilon()` is an arbitrarily small constant to prevent division by zero.
+    \param skipped Receives the number of skipped pairs
 */
 template<std::floating_point T, std::input_iterator I, std::input_iterator J>
-inline auto mean_absolute_percentage_error(I first1, std::sentinel_for<I> auto last1, J first2) noexcept -> double {
-    using wide = eve::wide<T>;
-    auto constexpr s{ wide::size() };
-    auto const n{ std::distance(first1, last1) };
-    auto const m{ n - n % s };
-
-    auto constexpr eps{ std::numeric_limits<T>::epsilon() };
+inline auto mean_absolute_percentage_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, std::size_t& skipped) noexcept -> double {
+    return evaluate<T, mape>(skip_nan, first1, last1, first2, skipped)[0];
+}
 
-    univariate_accumulator<wide> we;
-    for (auto i = 0; i < m; i += s) {
-        wide y_true{first1, first1+s};
-        wide y_pred{first2, first2+s};
-        we(eve::abs(y_true-y_pred) / eve::max(eps, eve::abs(y_true)));
-        detail::advance(s, first1, first2);
-    }
+/*!
+    \ingroup Metrics
 
-    // use scalar accumulators for the remaining values
-    auto se = univariate_accumulator<T>::load_state(we.stats());
-    for(; first1 < last1; ++first1, ++first2) {
-        se(eve::abs(*first1 - *first2) / eve::max(eps, eve::abs(*first1)));
-    }
-    return univariate_statistics(se).mean;
+    \brief Computes the mean absolute percentage error, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J>
+inline auto mean_absolute_percentage_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2) noexcept -> double {
+    return evaluate<T, mape>(skip_nan, first1, last1, first2)[0];
 }
 
 /*!
     \ingroup Metrics
 
-    \brief Weighted mean absolute percentage error
+    \brief Computes the weighted mean absolute percentage error, skipping the pairs that contain NaNs
 
-    \f[
-        \text{WMAPE}(y, \hat{y}) = \displaystyle \frac{1}{\sum_i^n w_i} \frac{\sum_{i=1}^n w_i |y-\hat{y}|}{\max(\epsilon, \left| y_i \right|)}
-    \f]
+    \param skipped Receives the number of skipped pairs
 */
 template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
-inline auto mean_absolute_percentage_error(I first1, std::sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
-    using wide = eve::wide<T>;
-    auto constexpr s{ wide::size() };
-    auto const n{ std::distance(first1, last1) };
-    auto const m{ n - n % s };
+inline auto mean_absolute_percentage_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, std::size_t& skipped) noexcept -> double {
+    return evaluate<T, mape>(skip_nan, first1, last1, first2, first3, skipped)[0];
+}
 
-    univariate_accumulator<wide> we;
-    for (auto i = 0; i < m; i += s) {
-        wide y_true{first1, first1+s};
-        wide y_pred{first2, first2+s};
-        wide weight{first3, first3+s};
-        we(eve::abs(y_true-y_pred), weight);
-        detail::advance(s, first1, first2, first3);
-    }
+/*!
+    \ingroup Metrics
 
-    // use scalar accumulators for the remaining values
-    auto se = univariate_accumulator<T>::load_state(we.stats());
-    for(; first1 < last1; ++first1, ++first2, ++first3) {
-        se(eve::abs(*first1 - *first2), *first3);
-    }
-    return univariate_statistics(se).mean;
+    \brief Computes the weighted mean absolute percentage error, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+inline auto mean_absolute_percentage_error(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
+    return evaluate<T, mape>(skip_nan, first1, last1, first2, first3)[0];
 }
 
 /*!
     \ingroup Metrics
 
-    \brief Negative log likelihood loss with Poisson distribution of target.
+    \brief Computes the Poisson negative log-likelihood loss, skipping the pairs that contain NaNs
 
-    \f[
-        -\log\mathcal{L}_\text{poisson}(y, \hat{y}) = \hat{y} - y \cdot \log(\hat{y}) + \ln(|\Gamma(y)|)
-    \f] where \f$\Gamma(y)\f$ is returned by <a href="https://jfalcou.github.io/eve/group__special_gae09a3d5ef50adfebd1d42611611cae5a.html#gae09a3d5ef50adfebd1d42611611cae5a">eve::gamma_p</a>.
+    \param skipped Receives the number of skipped pairs
 */
 template<std::floating_point T, std::input_iterator I, std::input_iterator J>
-inline auto poisson_neg_likelihood_loss(I first1, std::sentinel_for<I> auto last1, J first2) noexcept -> double {
-    using wide = eve::wide<T>;
-    auto constexpr s{ wide::size() };
-    auto const n{ std::distance(first1, last1) };
-    auto const m{ n - n % s };
-
-    auto constexpr eps{ std::numeric_limits<T>::epsilon() };
+inline auto poisson_neg_likelihood_loss(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, std::size_t& skipped) noexcept -> double {
+    return evaluate<T, poisson>(skip_nan, first1, last1, first2, skipped)[0];
+}
 
-    univariate_accumulator<wide> we;
-    for (auto i = 0; i < m; i += s) {
-        wide y_true{first1, first1+s};
-        wide y_pred{first2, first2+s};
-        we(y_pred - y_true * eve::log(y_pred) + eve::log_abs_gamma(T{1} + y_true));
-        detail::advance(s, first1, first2);
-    }
+/*!
+    \ingroup Metrics
 
-    // use scalar accumulators for the remaining values
-    auto se = univariate_accumulator<T>::load_state(we.stats());
-    for(; first1 < last1; ++first1, ++first2) {
-        se(*first2 - *first1 * eve::log(*first2) + eve::log_abs_gamma(T{1} + *first1));
-    }
-    return univariate_statistics(se).sum;
+    \brief Computes the Poisson negative log-likelihood loss, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J>
+inline auto poisson_neg_likelihood_loss(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2) noexcept -> double {
+    return evaluate<T, poisson>(skip_nan, first1, last1, first2)[0];
 }
 
 /*!
     \ingroup Metrics
 
-    \brief Negative log likelihood loss with Poisson distribution of target. The mean in each bin is multiplied by a weight before the Poisson likelihood is applied.
+    \brief Computes the weighted Poisson negative log-likelihood loss, skipping the pairs that contain NaNs
 
-    \f[
-        -\log\mathcal{L}_\text{poisson}(y, w \cdot \hat{y}) = \hat{y} - y \cdot \log(\hat{y}) + \ln(|\Gamma(y)|)
-    \f] where \f$\Gamma(y)\f$ is returned by <a href="https://jfalcou.github.io/eve/group__special_gae09a3d5ef50adfebd1d42611611cae5a.html#gae09a3d5ef50adfebd1d42611611cae5a">eve::gamma_p</a>.
+    \param skipped Receives the number of skipped pairs
 */
 template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
-inline auto poisson_neg_likelihood_loss(I first1, std::sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
-    using wide = eve::wide<T>;
-    auto constexpr s{ wide::size() };
-    auto const n{ std::distance(first1, last1) };
-    auto const m{ n - n % s };
-
-    auto constexpr eps{ std::numeric_limits<T>::epsilon() };
+inline auto poisson_neg_likelihood_loss(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3, std::size_t& skipped) noexcept -> double {
+    return evaluate<T, poisson>(skip_nan, first1, last1, first2, first3, skipped)[0];
+}
 
-    univariate_accumulator<wide> we;
-    for (auto i = 0; i < m; i += s) {
-        wide y_true{first1, first1+s};
-        wide y_pred = eve::mul(wide{first2, first2+s}, wide{first3, first3+s});
-        we(y_pred - y_true * eve::log(y_pred) + eve::log_abs_gamma(T{1} + y_true));
-        detail::advance(s, first1, first2, first3);
-    }
+/*!
+    \ingroup Metrics
 
-    // use scalar accumulators for the remaining values
-    auto se = univariate_accumulator<T>::load_state(we.stats());
-    for(; first1 < last1; ++first1, ++first2, ++first3) {
-        se(*first2 * *first3 - *first1 * eve::log(*first2 * *first3) + eve::log_abs_gamma(T{1} + *first1));
-    }
-    return univariate_statistics(se).sum;
+    \brief Computes the weighted Poisson negative log-likelihood loss, skipping the pairs that contain NaNs
+*/
+template<std::floating_point T, std::input_iterator I, std::input_iterator J, std::input_iterator K>
+inline auto poisson_neg_likelihood_loss(skip_nan_t /*unused*/, I first1, std::sized_sentinel_for<I> auto last1, J first2, K first3) noexcept -> double {
+    return evaluate<T, poisson>(skip_nan, first1, last1, first2, first3)[0];
 }
 } // namespace metrics
 
@@ -8,5 +8,5 @@ setup(
     author='Bogdan Burlacu',
     packages = ['vstat'],
     python_requires=">=3.8",
-    cmake_args=[f'-DCPM_USE_LOCAL_PACKAGES=1', '-Dvstat_BUILD_PYTHON=1']
+    cmake_args=[f'-DCPM_USE_LOCAL_PACKAGES=1', '-Dvstat_BUILD_PYTHON=1', '-Dvstat_BUILD_DISPATCH=1']
 )
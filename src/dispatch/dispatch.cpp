@@ -0,0 +1,360 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#include <vstat/bivariate.hpp>
+#include <vstat/dispatch.hpp>
+#include <vstat/univariate.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define VSTAT_DISPATCH_X86_64
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#include "kernels.hpp"
+
+namespace VSTAT_NAMESPACE::dispatch {
+namespace {
+    using detail::kernel_table;
+
+    auto constexpr levels{ std::array{ isa::generic, isa::sse4_2, isa::avx2, isa::avx512 } };
+
+    auto index(isa level) noexcept -> std::size_t { return static_cast<std::size_t>(level); }
+
+#if defined(VSTAT_DISPATCH_X86_64)
+    struct cpuid_registers {
+        std::uint32_t eax;
+        std::uint32_t ebx;
+        std::uint32_t ecx;
+        std::uint32_t edx;
+    };
+
+    auto cpuid(std::uint32_t leaf, std::uint32_t subleaf = 0) noexcept -> cpuid_registers
+    {
+        cpuid_registers r{};
+#if defined(_MSC_VER)
+        std::array<int, 4> v{};
+        __cpuidex(v.data(), static_cast<int>(leaf), static_cast<int>(subleaf));
+        r = { static_cast<std::uint32_t>(v[0]), static_cast<std::uint32_t>(v[1]), static_cast<std::uint32_t>(v[2]), static_cast<std::uint32_t>(v[3]) };
+#else
+        __cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+#endif
+        return r;
+    }
+
+    // the register states enabled by the operating system (XCR0)
+    auto xgetbv() noexcept -> std::uint64_t
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        std::uint32_t lo{};
+        std::uint32_t hi{};
+        __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        return (static_cast<std::uint64_t>(hi) << 32U) | lo;
+#endif
+    }
+
+    auto bits(std::uint32_t reg, std::initializer_list<unsigned> positions) noexcept -> bool
+    {
+        return std::all_of(positions.begin(), positions.end(), [&](auto p) { return (reg >> p) & 1U; });
+    }
+
+    // the feature sets of the x86-64 micro-architecture levels the modules are compiled for
+    auto cpu_supports(isa level) noexcept -> bool
+    {
+        auto const max_leaf = cpuid(0).eax;
+        auto const max_ext_leaf = cpuid(0x80000000).eax; // NOLINT
+        if (max_leaf < 7 || max_ext_leaf < 0x80000001) { // NOLINT
+            return level == isa::generic;
+        }
+        auto const l1 = cpuid(1);
+        auto const l7 = cpuid(7);
+        auto const ext = cpuid(0x80000001); // NOLINT
+
+        // SSE3, SSSE3, CX16, SSE4.1, SSE4.2, POPCNT and LAHF/SAHF
+        bool const v2 = bits(l1.ecx, { 0, 9, 13, 19, 20, 23 }) && bits(ext.ecx, { 0 }); // NOLINT
+        // OSXSAVE and the SSE and AVX states enabled by the OS
+        bool const avx_os = bits(l1.ecx, { 27 }) && (xgetbv() & 0x6U) == 0x6U; // NOLINT
+        // AVX, FMA, F16C, MOVBE, AVX2, BMI1, BMI2 and LZCNT
+        bool const v3 = v2 && avx_os && bits(l1.ecx, { 12, 22, 28, 29 }) && bits(l7.ebx, { 3, 5, 8 }) && bits(ext.ecx, { 5 }); // NOLINT
+        // AVX-512 F, DQ, CD, BW, VL and the opmask and ZMM states enabled by the OS
+        bool const v4 = v3 && bits(l7.ebx, { 16, 17, 28, 30, 31 }) && (xgetbv() & 0xE6U) == 0xE6U; // NOLINT
+
+        switch (level) {
+        case isa::generic: return true;
+        case isa::sse4_2: return v2;
+        case isa::avx2: return v3;
+        case isa::avx512: return v4;
+        }
+        return false;
+    }
+#else
+    auto cpu_supports(isa level) noexcept -> bool { return level == isa::generic; }
+#endif
+
+    // the directory of the binary (executable or shared library) containing the dispatcher
+    auto binary_directory() -> std::filesystem::path
+    {
+#if defined(_WIN32)
+        HMODULE handle{};
+        if (GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                reinterpret_cast<LPCSTR>(&binary_directory), &handle) == 0) { // NOLINT
+            return {};
+        }
+        std::array<char, MAX_PATH> path{};
+        auto const n = GetModuleFileNameA(handle, path.data(), static_cast<DWORD>(path.size()));
+        return std::filesystem::path(std::string(path.data(), n)).parent_path();
+#else
+        Dl_info info{};
+        if (dladdr(reinterpret_cast<void const*>(&binary_directory), &info) == 0 || info.dli_fname == nullptr) { // NOLINT
+            return {};
+        }
+        return std::filesystem::path(info.dli_fname).parent_path();
+#endif
+    }
+
+    auto search_path() -> std::vector<std::filesystem::path>
+    {
+        std::vector<std::filesystem::path> dirs;
+        if (auto const* env = std::getenv("VSTAT_KERNELS_PATH"); env != nullptr) { // NOLINT
+            dirs.emplace_back(env);
+        }
+        dirs.push_back(binary_directory());
+#if defined(VSTAT_KERNELS_INSTALL_DIR)
+        dirs.emplace_back(VSTAT_KERNELS_INSTALL_DIR);
+#endif
+#if defined(VSTAT_KERNELS_BUILD_DIR)
+        dirs.emplace_back(VSTAT_KERNELS_BUILD_DIR);
+#endif
+        return dirs;
+    }
+
+    // loads the module of the given level (modules are never unloaded)
+    auto load_module(isa level) -> kernel_table const*
+    {
+#if defined(VSTAT_KERNELS_MODULE_SUFFIX)
+        using entry_point = kernel_table const* (*)() noexcept;
+        auto const name = std::string("vstat_kernels_") + isa_name(level) + VSTAT_KERNELS_MODULE_SUFFIX;
+        for (auto const& dir : search_path()) {
+            auto const file = dir / name;
+            std::error_code ec;
+            if (!std::filesystem::exists(file, ec)) {
+                continue;
+            }
+#if defined(_WIN32)
+            auto* handle = LoadLibraryW(file.c_str());
+            auto* symbol = handle == nullptr ? nullptr : reinterpret_cast<void*>(GetProcAddress(handle, VSTAT_KERNELS_SYMBOL)); // NOLINT
+#else
+            auto* handle = dlopen(file.c_str(), RTLD_NOW | RTLD_LOCAL);
+            auto* symbol = handle == nullptr ? nullptr : dlsym(handle, VSTAT_KERNELS_SYMBOL);
+#endif
+            if (symbol == nullptr) {
+                continue;
+            }
+            auto const* table = reinterpret_cast<entry_point>(symbol)(); // NOLINT
+            if (table != nullptr && table->version == detail::abi_version) {
+                return table;
+            }
+        }
+#else
+        static_cast<void>(level);
+#endif
+        return nullptr;
+    }
+
+    // the kernels of each level (null if not supported by the CPU or not found)
+    struct registry {
+        std::array<kernel_table const*, levels.size()> tables{};
+        std::atomic<isa> active{ isa::generic };
+
+        registry()
+        {
+            tables[index(isa::generic)] = detail::builtin_kernels();
+            for (auto level : levels) {
+                if (level != isa::generic && cpu_supports(level)) {
+                    tables[index(level)] = load_module(level);
+                }
+            }
+            auto best = isa::generic;
+            for (auto level : levels) {
+                if (tables[index(level)] != nullptr) {
+                    best = level;
+                }
+            }
+            // an unknown or unavailable level in VSTAT_ISA is ignored
+            if (auto const* env = std::getenv("VSTAT_ISA"); env != nullptr) { // NOLINT
+                for (auto level : levels) {
+                    if (std::string_view{env} == isa_name(level) && tables[index(level)] != nullptr) {
+                        best = level;
+                    }
+                }
+            }
+            active = best;
+        }
+    };
+
+    auto instance() -> registry&
+    {
+        static registry r;
+        return r;
+    }
+
+    // the kernels are selected when the library is loaded
+    [[maybe_unused]] auto const& loaded{ instance() };
+
+    auto table() noexcept -> kernel_table const& { return *instance().tables[index(instance().active.load(std::memory_order_relaxed))]; }
+
+    template<typename T>
+    auto kernels() noexcept -> detail::kernels<T> const&
+    {
+        if constexpr (std::is_same_v<T, float>) {
+            return table().f32;
+        } else {
+            return table().f64;
+        }
+    }
+
+    auto statistics(detail::univariate_state const& s) noexcept -> univariate_statistics
+    {
+        univariate_statistics stats(univariate_accumulator<double>::load_state(s.sum_w, s.sum_x, s.sum_xx));
+        stats.min = s.min;
+        stats.max = s.max;
+        stats.argmin = s.argmin;
+        stats.argmax = s.argmax;
+        return stats;
+    }
+
+    auto statistics(detail::bivariate_state const& s) noexcept -> bivariate_statistics
+    {
+        return bivariate_statistics(bivariate_accumulator<double>::load_state(s.sum_x, s.sum_y, s.sum_w, s.sum_xx, s.sum_yy, s.sum_xy));
+    }
+
+    auto size(auto const* first, auto const* last) noexcept -> std::size_t { return static_cast<std::size_t>(last - first); }
+
+    template<typename T>
+    auto metric(detail::metric m, T const* first1, T const* last1, T const* first2, T const* weights) noexcept -> double
+    {
+        return kernels<T>().metrics[m](first1, first2, weights, size(first1, last1));
+    }
+} // namespace
+
+auto isa_name(isa level) noexcept -> char const*
+{
+    switch (level) {
+    case isa::generic: return "generic";
+    case isa::sse4_2: return "sse4_2";
+    case isa::avx2: return "avx2";
+    case isa::avx512: return "avx512";
+    }
+    return "unknown";
+}
+
+auto available(isa level) noexcept -> bool
+{
+    return index(level) < levels.size() && instance().tables[index(level)] != nullptr;
+}
+
+auto active_isa() noexcept -> isa
+{
+    return instance().active.load();
+}
+
+auto set_isa(isa level) noexcept -> bool
+{
+    if (!available(level)) {
+        return false;
+    }
+    instance().active = level;
+    return true;
+}
+
+namespace univariate {
+    template<std::floating_point T>
+    auto accumulate(T const* first, T const* last) noexcept -> univariate_statistics
+    {
+        return statistics(kernels<T>().univariate(first, nullptr, size(first, last)));
+    }
+
+    template<std::floating_point T>
+    auto accumulate(T const* first, T const* last, T const* weights) noexcept -> univariate_statistics
+    {
+        return statistics(kernels<T>().univariate(first, weights, size(first, last)));
+    }
+
+    template<std::floating_point T>
+    auto accumulate(with_extrema_t /*unused*/, T const* first, T const* last) noexcept -> univariate_statistics
+    {
+        return statistics(kernels<T>().univariate_extrema(first, size(first, last)));
+    }
+
+    template auto accumulate(float const*, float const*) noexcept -> univariate_statistics;
+    template auto accumulate(double const*, double const*) noexcept -> univariate_statistics;
+    template auto accumulate(float const*, float const*, float const*) noexcept -> univariate_statistics;
+    template auto accumulate(double const*, double const*, double const*) noexcept -> univariate_statistics;
+    template auto accumulate(with_extrema_t, float const*, float const*) noexcept -> univariate_statistics;
+    template auto accumulate(with_extrema_t, double const*, double const*) noexcept -> univariate_statistics;
+} // namespace univariate
+
+namespace bivariate {
+    template<std::floating_point T>
+    auto accumulate(T const* first1, T const* last1, T const* first2) noexcept -> bivariate_statistics
+    {
+        return statistics(kernels<T>().bivariate(first1, first2, nullptr, size(first1, last1)));
+    }
+
+    template<std::floating_point T>
+    auto accumulate(T const* first1, T const* last1, T const* first2, T const* weights) noexcept -> bivariate_statistics
+    {
+        return statistics(kernels<T>().bivariate(first1, first2, weights, size(first1, last1)));
+    }
+
+    template auto accumulate(float const*, float const*, float const*) noexcept -> bivariate_statistics;
+    template auto accumulate(double const*, double const*, double const*) noexcept -> bivariate_statistics;
+    template auto accumulate(float const*, float const*, float const*, float const*) noexcept -> bivariate_statistics;
+    template auto accumulate(double const*, double const*, double const*, double const*) noexcept -> bivariate_statistics;
+} // namespace bivariate
+
+namespace metrics {
+#define VSTAT_DISPATCH_METRIC(name, m)                                                                          \
+    template<std::floating_point T>                                                                            \
+    auto name(T const* first1, T const* last1, T const* first2, T const* weights) noexcept -> double           \
+    {                                                                                                          \
+        return metric(detail::m, first1, last1, first2, weights);                                              \
+    }                                                                                                          \
+    template auto name(float const*, float const*, float const*, float const*) noexcept -> double;             \
+    template auto name(double const*, double const*, double const*, double const*) noexcept -> double;
+
+    VSTAT_DISPATCH_METRIC(r2_score, r2)
+    VSTAT_DISPATCH_METRIC(mean_squared_error, mse)
+    VSTAT_DISPATCH_METRIC(mean_squared_log_error, msle)
+    VSTAT_DISPATCH_METRIC(mean_absolute_error, mae)
+    VSTAT_DISPATCH_METRIC(mean_absolute_percentage_error, mape)
+    VSTAT_DISPATCH_METRIC(poisson_neg_likelihood_loss, poisson)
+#undef VSTAT_DISPATCH_METRIC
+} // namespace metrics
+} // namespace VSTAT_NAMESPACE::dispatch
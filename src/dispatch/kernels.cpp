@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+// the kernels behind vstat/dispatch.hpp. this file is compiled into the dispatch library for its baseline and, with
+// VSTAT_KERNELS_MODULE defined, into one module per instruction set level, which exports only the kernel table.
+
+#include "kernels.hpp"
+
+#include <vstat/vstat.hpp>
+
+namespace {
+namespace vd = VSTAT_NAMESPACE::dispatch::detail;
+namespace uv = VSTAT_NAMESPACE::univariate;
+namespace bv = VSTAT_NAMESPACE::bivariate;
+namespace mt = VSTAT_NAMESPACE::metrics;
+
+template<typename T>
+auto univariate(T const* x, T const* w, std::size_t n) noexcept -> vd::univariate_state
+{
+    auto const s = w == nullptr ? uv::accumulate<T>(x, x + n) : uv::accumulate<T>(x, x + n, w);
+    return { s.count, s.sum, s.ssr, s.min, s.max, s.argmin, s.argmax };
+}
+
+template<typename T>
+auto univariate_extrema(T const* x, std::size_t n) noexcept -> vd::univariate_state
+{
+    auto const s = uv::accumulate<T>(VSTAT_NAMESPACE::with_extrema, x, x + n);
+    return { s.count, s.sum, s.ssr, s.min, s.max, s.argmin, s.argmax };
+}
+
+template<typename T>
+auto bivariate(T const* x, T const* y, T const* w, std::size_t n) noexcept -> vd::bivariate_state
+{
+    auto const s = w == nullptr ? bv::accumulate<T>(x, x + n, y) : bv::accumulate<T>(x, x + n, y, w);
+    return { s.count, s.sum_x, s.sum_y, s.ssr_x, s.ssr_y, s.sum_xy };
+}
+
+template<typename T, typename M>
+auto metric(T const* x, T const* y, T const* w, std::size_t n) noexcept -> double
+{
+    return w == nullptr ? mt::evaluate<T, M>(x, x + n, y)[0] : mt::evaluate<T, M>(x, x + n, y, w)[0];
+}
+
+template<typename T>
+constexpr auto make_kernels() noexcept -> vd::kernels<T>
+{
+    return { &univariate<T>, &univariate_extrema<T>, &bivariate<T>, {
+        &metric<T, mt::r2>, &metric<T, mt::mse>, &metric<T, mt::msle>, &metric<T, mt::mae>, &metric<T, mt::mape>, &metric<T, mt::poisson>
+    } };
+}
+
+constexpr vd::kernel_table table{ vd::abi_version, make_kernels<float>(), make_kernels<double>() };
+} // namespace
+
+#if defined(VSTAT_KERNELS_MODULE)
+#if defined(_WIN32)
+#define VSTAT_KERNELS_EXPORT __declspec(dllexport)
+#else
+#define VSTAT_KERNELS_EXPORT __attribute__((visibility("default")))
+#endif
+
+extern "C" VSTAT_KERNELS_EXPORT auto vstat_kernels() noexcept -> vd::kernel_table const*
+{
+    return &table;
+}
+#else
+auto VSTAT_NAMESPACE::dispatch::detail::builtin_kernels() noexcept -> kernel_table const*
+{
+    return &table;
+}
+#endif
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+#ifndef VSTAT_DISPATCH_KERNELS_HPP
+#define VSTAT_DISPATCH_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vstat/util.hpp>
+
+// the interface between the dispatcher and the kernel modules. the modules are compiled with different instruction
+// sets and loaded at runtime, so only plain data crosses the boundary (the statistics are assembled by the dispatcher).
+namespace VSTAT_NAMESPACE::dispatch::detail {
+    // incremented whenever the layout of the kernel table changes
+    inline constexpr std::uint32_t abi_version{ 1 };
+
+    // { sum_w, sum_x, sum_xx } and the extrema (if computed)
+    struct univariate_state {
+        double sum_w;
+        double sum_x;
+        double sum_xx;
+        double min;
+        double max;
+        std::int64_t argmin;
+        std::int64_t argmax;
+    };
+
+    struct bivariate_state {
+        double sum_w;
+        double sum_x;
+        double sum_y;
+        double sum_xx;
+        double sum_yy;
+        double sum_xy;
+    };
+
+    enum metric : std::size_t { r2, mse, msle, mae, mape, poisson, metric_count };
+
+    // the weights may be null (unweighted)
+    template<typename T>
+    struct kernels {
+        univariate_state (*univariate)(T const* x, T const* w, std::size_t n) noexcept;
+        univariate_state (*univariate_extrema)(T const* x, std::size_t n) noexcept;
+        bivariate_state (*bivariate)(T const* x, T const* y, T const* w, std::size_t n) noexcept;
+        double (*metrics[metric_count])(T const* x, T const* y, T const* w, std::size_t n) noexcept;
+    };
+
+    struct kernel_table {
+        std::uint32_t version;
+        kernels<float> f32;
+        kernels<double> f64;
+    };
+
+    // the kernels compiled into the dispatch library (for its own baseline)
+    auto builtin_kernels() noexcept -> kernel_table const*;
+} // namespace VSTAT_NAMESPACE::dispatch::detail
+
+// the name of the function returning the kernel table, exported by the modules
+#define VSTAT_KERNELS_SYMBOL "vstat_kernels"
+
+#endif
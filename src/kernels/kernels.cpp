@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2020-2024 Heal Research
+
+// the definitions and explicit instantiations of the functions declared in vstat/kernels.hpp, which forward to the
+// header-only methods
+
+#include <vstat/kernels.hpp>
+#include <vstat/vstat.hpp>
+
+namespace VSTAT_NAMESPACE::kernels {
+namespace univariate {
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(I first, I last) noexcept -> univariate_statistics
+    {
+        return VSTAT_NAMESPACE::univariate::accumulate<T>(first, last);
+    }
+
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(I first, I last, I weights) noexcept -> univariate_statistics
+    {
+        return VSTAT_NAMESPACE::univariate::accumulate<T>(first, last, weights);
+    }
+
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(skip_nan_t /*unused*/, I first, I last) noexcept -> univariate_statistics
+    {
+        return VSTAT_NAMESPACE::univariate::accumulate<T>(skip_nan, first, last);
+    }
+
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(skip_nan_t /*unused*/, I first, I last, I weights) noexcept -> univariate_statistics
+    {
+        return VSTAT_NAMESPACE::univariate::accumulate<T>(skip_nan, first, last, weights);
+    }
+
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(with_extrema_t /*unused*/, I first, I last) noexcept -> univariate_statistics
+    {
+        return VSTAT_NAMESPACE::univariate::accumulate<T>(with_extrema, first, last);
+    }
+} // namespace univariate
+
+namespace bivariate {
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(I first1, I last1, I first2) noexcept -> bivariate_statistics
+    {
+        return VSTAT_NAMESPACE::bivariate::accumulate<T>(first1, last1, first2);
+    }
+
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(I first1, I last1, I first2, I weights) noexcept -> bivariate_statistics
+    {
+        return VSTAT_NAMESPACE::bivariate::accumulate<T>(first1, last1, first2, weights);
+    }
+
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(skip_nan_t /*unused*/, I first1, I last1, I first2) noexcept -> bivariate_statistics
+    {
+        return VSTAT_NAMESPACE::bivariate::accumulate<T>(skip_nan, first1, last1, first2);
+    }
+
+    template<std::floating_point T, iterator<T> I>
+    auto accumulate(skip_nan_t /*unused*/, I first1, I last1, I first2, I weights) noexcept -> bivariate_statistics
+    {
+        return VSTAT_NAMESPACE::bivariate::accumulate<T>(skip_nan, first1, last1, first2, weights);
+    }
+} // namespace bivariate
+
+namespace metrics {
+#define VSTAT_KERNELS_DEFINE_METRIC(name)                                               \
+    template<std::floating_point T, iterator<T> I>                                     \
+    auto name(I first1, I last1, I first2) noexcept -> double                          \
+    {                                                                                  \
+        return VSTAT_NAMESPACE::metrics::name<T>(first1, last1, first2);               \
+    }                                                                                  \
+    template<std::floating_point T, iterator<T> I>                                     \
+    auto name(I first1, I last1, I first2, I weights) noexcept -> double               \
+    {                                                                                  \
+        return VSTAT_NAMESPACE::metrics::name<T>(first1, last1, first2, weights);      \
+    }
+
+    VSTAT_KERNELS_DEFINE_METRIC(r2_score)
+    VSTAT_KERNELS_DEFINE_METRIC(mean_squared_error)
+    VSTAT_KERNELS_DEFINE_METRIC(mean_squared_log_error)
+    VSTAT_KERNELS_DEFINE_METRIC(mean_absolute_error)
+    VSTAT_KERNELS_DEFINE_METRIC(mean_absolute_percentage_error)
+    VSTAT_KERNELS_DEFINE_METRIC(poisson_neg_likelihood_loss)
+#undef VSTAT_KERNELS_DEFINE_METRIC
+} // namespace metrics
+
+VSTAT_KERNELS_INSTANTIATE_ALL()
+} // namespace VSTAT_NAMESPACE::kernels
@@ -3,34 +3,700 @@
 
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
+#include <nanobind/stl/map.h>
+#include <nanobind/stl/optional.h>
+#include <nanobind/stl/pair.h>
+#include <nanobind/stl/string.h>
 #include <nanobind/stl/vector.h>
 
+#include <vstat/dispatch.hpp>
 #include <vstat/vstat.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <optional>
 #include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace detail {
+    namespace nb = nanobind;
+
     template<typename T>
     using array = nanobind::ndarray<T>;
 
-    // helpers
+    // true if the elements are stored contiguously in row-major order
+    template<typename T>
+    inline auto is_contiguous(array<T> const& x) -> bool {
+        std::int64_t stride{1};
+        for (auto i = x.ndim(); i-- > 0;) {
+            if (x.shape(i) != 1 && x.stride(i) != stride) {
+                return false;
+            }
+            stride *= static_cast<std::int64_t>(x.shape(i));
+        }
+        return true;
+    }
+
+    template<typename T>
+    inline auto is_contiguous(std::vector<T> const& /*unused*/) -> bool { return true; }
+
+    template<typename T>
+    inline auto ndim(array<T> const& x) -> std::size_t { return x.ndim(); }
+
+    template<typename T>
+    inline auto ndim(std::vector<T> const& /*unused*/) -> std::size_t { return 1; }
+
+    template<typename T>
+    inline auto stride(array<T> const& x) -> std::int64_t { return x.ndim() == 0 ? 1 : x.stride(0); }
+
+    template<typename T>
+    inline auto stride(std::vector<T> const& /*unused*/) -> std::int64_t { return 1; }
+
+    // invokes `func(n, first...)` with a begin iterator for each input, without copying the data. contiguous
+    // inputs are passed as pointers (allowing vector loads), one-dimensional strided inputs as strided iterators.
+    template<typename T, typename F, typename C, typename... Cs>
+    auto with_iterators(F&& func, C const& x, Cs const&... xs) {
+        auto const n = static_cast<std::ptrdiff_t>(x.size());
+        if (((static_cast<std::ptrdiff_t>(xs.size()) != n) || ...)) {
+            throw nb::value_error("the input arrays must have the same size");
+        }
+        if (is_contiguous(x) && (is_contiguous(xs) && ...)) {
+            return std::forward<F>(func)(n, static_cast<T const*>(x.data()), static_cast<T const*>(xs.data())...);
+        }
+        if (ndim(x) == 1 && ((ndim(xs) == 1) && ...)) {
+            return std::forward<F>(func)(n,
+                vstat::strided_iterator<T const>{x.data(), stride(x)},
+                vstat::strided_iterator<T const>{xs.data(), stride(xs)}...);
+        }
+        throw nb::value_error("non-contiguous multi-dimensional arrays are only supported along an axis");
+    }
+
+#if defined(VSTAT_DISPATCH)
+    inline constexpr bool dispatch_enabled{ true };
+#else
+    inline constexpr bool dispatch_enabled{ false };
+#endif
+
+    // contiguous inputs (passed as pointers) are processed by the kernels compiled for the instruction set of the
+    // cpu when the module is built with the dispatch library (see vstat/dispatch.hpp)
+    template<typename I>
+    inline constexpr bool dispatched{ dispatch_enabled && std::is_pointer_v<I> };
+
+    // calls `func(offset)` for each multi-index of `shape` (in row-major order) with the corresponding element offset
+    template<typename F>
+    inline auto for_each_offset(std::span<std::size_t const> shape, std::span<std::int64_t const> strides, F&& func) -> void {
+        if (std::ranges::find(shape, std::size_t{0}) != shape.end()) {
+            return;
+        }
+        std::vector<std::size_t> index(shape.size(), 0);
+        std::int64_t offset{0};
+        for (;;) {
+            func(offset);
+            auto d = shape.size();
+            for (; d > 0; --d) {
+                auto const i = d - 1;
+                if (++index[i] < shape[i]) {
+                    offset += strides[i];
+                    break;
+                }
+                offset -= strides[i] * static_cast<std::int64_t>(shape[i] - 1);
+                index[i] = 0;
+            }
+            if (d == 0) {
+                return;
+            }
+        }
+    }
+
+    template<typename T>
+    inline auto normalize_axis(array<T> const& x, std::int64_t axis) -> std::size_t {
+        auto const n = static_cast<std::int64_t>(x.ndim());
+        if (axis < -n || axis >= n) {
+            throw nb::value_error("axis is out of bounds for the array");
+        }
+        return static_cast<std::size_t>(axis < 0 ? axis + n : axis);
+    }
+
+    // the shape of the result of a reduction along `axis`
+    template<typename T>
+    inline auto reduced_shape(array<T> const& x, std::int64_t axis) -> std::vector<std::size_t> {
+        auto const a = normalize_axis(x, axis);
+        std::vector<std::size_t> shape;
+        for (std::size_t i = 0; i < x.ndim(); ++i) {
+            if (i != a) { shape.push_back(x.shape(i)); }
+        }
+        return shape;
+    }
+
+    // returns a numpy array of the given shape taking ownership of the values
+    inline auto to_numpy(std::vector<double>&& values, std::vector<std::size_t> const& shape) -> nb::ndarray<nb::numpy, double> {
+        auto* data = new std::vector<double>(std::move(values));
+        nb::capsule owner(data, [](void* p) noexcept { delete static_cast<std::vector<double>*>(p); });
+        return nb::ndarray<nb::numpy, double>(data->data(), shape.size(), shape.data(), owner);
+    }
+
+    // helpers (the accumulation is performed in the precision of the input data)
+    template<typename T>
+    inline auto univariate_accumulate(array<T> const& x, std::int64_t axis) -> std::vector<vstat::univariate_statistics>;
+
+    // accumulates a non-contiguous multi-dimensional array, including the extrema, in a single pass over the rows
+    // along the last axis. the rows are visited in row-major order, so merging the extrema of each row in turn
+    // offsets their positions to the flattened array.
+    template<typename T>
+    inline auto strided_accumulate(array<T> const& x) -> vstat::univariate_statistics {
+        auto const last = x.ndim() - 1;
+        std::vector<std::size_t> shape(last);
+        std::vector<std::int64_t> strides(last);
+        for (std::size_t i = 0; i < last; ++i) {
+            shape[i] = x.shape(i);
+            strides[i] = x.stride(i);
+        }
+        auto const n = static_cast<std::ptrdiff_t>(x.shape(last));
+        vstat::univariate_accumulator<double> acc;
+        vstat::extrema_accumulator<double> ext;
+        for_each_offset(shape, strides, [&](auto offset) {
+            vstat::strided_iterator<T const> it{x.data() + offset, x.stride(last)};
+            auto const s = vstat::univariate::accumulate<T>(vstat::with_extrema, it, it + n);
+            acc += vstat::univariate_accumulator<double>::load_state(s.count, s.sum, s.ssr);
+            ext += vstat::extrema_accumulator<double>::load_state(n, s.min, s.max, s.argmin, s.argmax);
+        });
+        return vstat::univariate_statistics(acc, ext);
+    }
+
+    template<typename T, typename C>
+    inline auto univariate_accumulate(C const& x) {
+        if constexpr (std::is_same_v<C, array<T>>) {
+            // reduce the rows of non-contiguous multi-dimensional arrays separately and merge the results
+            if (!is_contiguous(x) && x.ndim() > 1) {
+                return strided_accumulate<T>(x);
+            }
+        }
+        return with_iterators<T>([](auto n, auto x) {
+            if constexpr (dispatched<decltype(x)>) {
+                return vstat::dispatch::univariate::accumulate(vstat::with_extrema, x, x + n);
+            } else {
+                return vstat::univariate::accumulate<T>(vstat::with_extrema, x, x + n);
+            }
+        }, x);
+    }
+
+    template<typename T, typename C>
+    inline auto univariate_accumulate(C const& x, C const& w) {
+        return with_iterators<T>([](auto n, auto x, auto w) {
+            if constexpr (dispatched<decltype(x)>) {
+                return vstat::dispatch::univariate::accumulate(x, x + n, w);
+            } else {
+                return vstat::univariate::accumulate<T>(x, x + n, w);
+            }
+        }, x, w);
+    }
+
+    // reduces the array along `axis`. when the innermost remaining dimension is contiguous, the rows along `axis`
+    // are swept in memory order and all the elements of that dimension are computed at once (the lanes of the
+    // SIMD accumulators map to consecutive elements), otherwise each reduction is a (strided) pass of its own.
+    template<typename T>
+    inline auto univariate_accumulate(array<T> const& x, std::int64_t axis) -> std::vector<vstat::univariate_statistics> {
+        auto const a = normalize_axis(x, axis);
+        auto const rows = x.shape(a);
+        auto const row_stride = x.stride(a);
+
+        std::vector<std::size_t> shape;
+        std::vector<std::int64_t> strides;
+        for (std::size_t i = 0; i < x.ndim(); ++i) {
+            if (i != a) {
+                shape.push_back(x.shape(i));
+                strides.push_back(x.stride(i));
+            }
+        }
+
+        std::vector<vstat::univariate_statistics> stats;
+        T const* data = x.data();
+
+        if (!shape.empty() && strides.back() == 1) {
+            auto const cols = shape.back();
+            shape.pop_back();
+            strides.pop_back();
+            for_each_offset(shape, strides, [&](auto offset) {
+                auto const s = vstat::univariate::accumulate_columns(data + offset, rows, cols, row_stride);
+                stats.insert(stats.end(), s.begin(), s.end());
+            });
+        } else {
+            for_each_offset(shape, strides, [&](auto offset) {
+                auto const* first = data + offset;
+                auto const n = static_cast<std::ptrdiff_t>(rows);
+                if (row_stride == 1) {
+                    stats.push_back(vstat::univariate::accumulate<T>(first, first + n));
+                } else {
+                    vstat::strided_iterator<T const> it{first, row_stride};
+                    stats.push_back(vstat::univariate::accumulate<T>(it, it + n));
+                }
+            });
+        }
+        return stats;
+    }
+
+    template<typename T, typename C>
+    inline auto bivariate_accumulate(C const& x, C const& y) {
+        return with_iterators<T>([](auto n, auto x, auto y) {
+            if constexpr (dispatched<decltype(x)>) {
+                return vstat::dispatch::bivariate::accumulate(x, x + n, y);
+            } else {
+                return vstat::bivariate::accumulate<T>(x, x + n, y);
+            }
+        }, x, y);
+    }
+
+    template<typename T, typename C>
+    inline auto bivariate_accumulate(C const& x, C const& y, C const& w) {
+        return with_iterators<T>([](auto n, auto x, auto y, auto w) {
+            if constexpr (dispatched<decltype(x)>) {
+                return vstat::dispatch::bivariate::accumulate(x, x + n, y, w);
+            } else {
+                return vstat::bivariate::accumulate<T>(x, x + n, y, w);
+            }
+        }, x, y, w);
+    }
+
+    // streaming accumulators exposed to python. the whole SIMD vectors of each batch are consumed by the wide
+    // accumulator and the leftover values by the scalar one, so the state is never reduced between batches.
+    // both accumulators use double precision, float arrays are widened while they are loaded.
+    struct univariate_stream {
+        vstat::univariate_accumulator<eve::wide<double>> simd;
+        vstat::univariate_accumulator<double> scalar;
+
+        template<typename T, typename C>
+        auto update(C const& x) -> void {
+            with_iterators<T>([&](auto n, auto first) {
+                auto const last = first + n;
+                for (auto it = vstat::univariate::update(simd, first, last); it < last; ++it) {
+                    scalar(*it);
+                }
+            }, x);
+        }
+
+        template<typename T, typename C>
+        auto update(C const& x, C const& w) -> void {
+            with_iterators<T>([&](auto n, auto first1, auto first2) {
+                auto const last = first1 + n;
+                for (auto [it, jt] = vstat::univariate::update(simd, first1, last, first2); it < last; ++it, ++jt) {
+                    scalar(*it, *jt);
+                }
+            }, x, w);
+        }
+
+        auto merge(univariate_stream const& other) -> void {
+            simd += other.simd;
+            scalar += other.scalar;
+        }
+
+        [[nodiscard]] auto stats() const -> vstat::univariate_statistics {
+            auto acc = vstat::univariate_accumulator<double>::load_state(simd.stats());
+            acc += scalar;
+            return vstat::univariate_statistics(acc);
+        }
+    };
+
+    struct bivariate_stream {
+        vstat::bivariate_accumulator<eve::wide<double>> simd;
+        vstat::bivariate_accumulator<double> scalar;
+
+        template<typename T, typename C>
+        auto update(C const& x, C const& y) -> void {
+            with_iterators<T>([&](auto n, auto first1, auto first2) {
+                auto const last = first1 + n;
+                for (auto [it, jt] = vstat::bivariate::update(simd, first1, last, first2); it < last; ++it, ++jt) {
+                    scalar(*it, *jt);
+                }
+            }, x, y);
+        }
+
+        template<typename T, typename C>
+        auto update(C const& x, C const& y, C const& w) -> void {
+            with_iterators<T>([&](auto n, auto first1, auto first2, auto first3) {
+                auto const last = first1 + n;
+                auto [it, jt, kt] = vstat::bivariate::update(simd, first1, last, first2, first3);
+                for (; it < last; ++it, ++jt, ++kt) {
+                    scalar(*it, *jt, *kt);
+                }
+            }, x, y, w);
+        }
+
+        auto merge(bivariate_stream const& other) -> void {
+            simd += other.simd;
+            scalar += other.scalar;
+        }
+
+        [[nodiscard]] auto stats() const -> vstat::bivariate_statistics {
+            auto [sw, sx, sy, sxx, syy, sxy] = simd.stats();
+            auto acc = vstat::bivariate_accumulator<double>::load_state(sx, sy, sw, sxx, syy, sxy);
+            acc += scalar;
+            return vstat::bivariate_statistics(acc);
+        }
+    };
+
+    // serialized state of a streaming accumulator: the per-lane SIMD state followed by the scalar state
+    template<typename S>
+    auto to_bytes(S const& acc) -> nb::bytes {
+        std::vector<std::byte> buffer(vstat::serialized_size(acc.simd) + vstat::serialized_size(acc.scalar));
+        auto const n = vstat::serialize(acc.simd, buffer);
+        vstat::serialize(acc.scalar, std::span{buffer}.subspan(n));
+        return nb::bytes(reinterpret_cast<char const*>(buffer.data()), buffer.size()); // NOLINT
+    }
+
+    // merges a state produced by to_bytes, the accumulator is left unchanged if the data is not valid
+    template<typename S>
+    auto merge_bytes(S& acc, nb::bytes const& data) -> void {
+        std::span const bytes{ reinterpret_cast<std::byte const*>(data.c_str()), data.size() }; // NOLINT
+        auto tmp = acc;
+        auto const n = vstat::merge_serialized(tmp.simd, bytes);
+        auto const m = n == 0 ? 0 : vstat::merge_serialized(tmp.scalar, bytes.subspan(n));
+        if (m == 0 || n + m != bytes.size()) {
+            throw nb::value_error("invalid serialized accumulator state");
+        }
+        acc = tmp;
+    }
+
+    // binds the serialization methods and the pickle protocol of a streaming accumulator
+    template<typename S>
+    auto bind_serialization(nb::class_<S>& cls) -> void {
+        cls.def("to_bytes", &to_bytes<S>);
+        cls.def("merge_bytes", &merge_bytes<S>, nb::arg("data"));
+        cls.def("__getstate__", &to_bytes<S>);
+        cls.def("__setstate__", [](S& acc, nb::bytes const& data) {
+            new (&acc) S{};
+            merge_bytes(acc, data);
+        });
+    }
+
+    // the computations do not touch any python objects, so the GIL is released while they run
+    using release_gil = nb::call_guard<nb::gil_scoped_release>;
+
+    // binds the update methods of the streaming accumulators for arrays holding values of type T
+    template<typename T>
+    auto bind_updates(nb::class_<univariate_stream>& cls) -> void {
+        cls.def("update", [](univariate_stream& acc, array<T> const& x) {
+            acc.update<T>(x);
+        }, nb::arg("x"), release_gil());
+
+        cls.def("update", [](univariate_stream& acc, array<T> const& x, array<T> const& w) {
+            acc.update<T>(x, w);
+        }, nb::arg("x"), nb::arg("weights"), release_gil());
+    }
+
+    template<typename T>
+    auto bind_updates(nb::class_<vstat::histogram_accumulator<double>>& cls) -> void {
+        cls.def("update", [](vstat::histogram_accumulator<double>& hist, array<T> const& x) {
+            with_iterators<T>([&](auto n, auto first) { vstat::univariate::update(hist, first, first + n); }, x);
+        }, nb::arg("x"), release_gil());
+    }
+
+    template<typename T>
+    auto bind_updates(nb::class_<vstat::ewma_accumulator<double>>& cls) -> void {
+        cls.def("update", [](vstat::ewma_accumulator<double>& acc, array<T> const& x) {
+            with_iterators<T>([&](auto n, auto first) { vstat::univariate::update(acc, first, first + n); }, x);
+        }, nb::arg("x"), release_gil());
+
+        // returns the moving mean and variance after each sample
+        cls.def("series", [](vstat::ewma_accumulator<double>& acc, array<T> const& x) {
+            std::vector<double> mean(x.size());
+            std::vector<double> variance(x.size());
+            {
+                nb::gil_scoped_release release;
+                with_iterators<T>([&](auto n, auto first) { vstat::univariate::update(acc, first, first + n, mean.begin(), variance.begin()); }, x);
+            }
+            std::vector<std::size_t> const shape{ x.size() };
+            return std::make_pair(to_numpy(std::move(mean), shape), to_numpy(std::move(variance), shape));
+        }, nb::arg("x"));
+    }
+
     template<typename T>
-    inline auto univariate_accumulate(std::span<T const> x) {
-        return vstat::univariate::accumulate<float>(x.begin(), x.end());
+    auto bind_updates(nb::class_<bivariate_stream>& cls) -> void {
+        cls.def("update", [](bivariate_stream& acc, array<T> const& x, array<T> const& y) {
+            acc.update<T>(x, y);
+        }, nb::arg("x"), nb::arg("y"), release_gil());
+
+        cls.def("update", [](bivariate_stream& acc, array<T> const& x, array<T> const& y, array<T> const& w) {
+            acc.update<T>(x, y, w);
+        }, nb::arg("x"), nb::arg("y"), nb::arg("weights"), release_gil());
+    }
+
+    // binds a univariate statistic for the container type C
+    template<typename T, typename C, typename R>
+    auto bind_univariate(nb::module_& m, char const* name, R field) -> void {
+        m.def(name, [field](C const& x) {
+            return univariate_accumulate<T>(x).*field;
+        }, release_gil());
+
+        m.def(name, [field](C const& x, C const& w) {
+            return univariate_accumulate<T>(x, w).*field;
+        }, release_gil());
+
+        if constexpr (std::is_same_v<C, array<T>>) {
+            // the result array is created after the GIL is acquired again
+            m.def(name, [field](C const& x, std::int64_t axis) {
+                std::vector<double> values;
+                {
+                    nb::gil_scoped_release release;
+                    auto const stats = univariate_accumulate<T>(x, axis);
+                    values.reserve(stats.size());
+                    std::ranges::transform(stats, std::back_inserter(values), [&](auto const& s) { return s.*field; });
+                }
+                return to_numpy(std::move(values), reduced_shape(x, axis));
+            }, nb::arg("x"), nb::arg("axis"));
+        }
+    }
+
+    // binds a bivariate statistic for the container type C
+    template<typename T, typename C, typename R>
+    auto bind_bivariate(nb::module_& m, char const* name, R field) -> void {
+        m.def(name, [field](C const& x, C const& y) {
+            return bivariate_accumulate<T>(x, y).*field;
+        }, release_gil());
+
+        m.def(name, [field](C const& x, C const& y, C const& w) {
+            return bivariate_accumulate<T>(x, y, w).*field;
+        }, release_gil());
     }
 
+    // invokes the dispatched `kernel` (if any) for pointers and `metric` otherwise
+    template<typename F, typename G, typename I, typename... Is>
+    auto invoke_metric(F const& metric, G const& kernel, I first, Is... rest) {
+        if constexpr (dispatched<I> && !std::is_null_pointer_v<G>) {
+            return kernel(first, rest...);
+        } else {
+            return metric(first, rest...);
+        }
+    }
+
+    // binds a regression metric for the container type C. `metric` is invoked with iterators, the optional
+    // `kernel` with the pointers to contiguous inputs.
+    template<typename T, typename C, typename F, typename G = std::nullptr_t>
+    auto bind_metric(nb::module_& m, char const* name, F metric, G kernel = nullptr) -> void {
+        m.def(name, [metric, kernel](C const& x, C const& y) {
+            return with_iterators<T>([&](auto n, auto a, auto b) { return invoke_metric(metric, kernel, a, a + n, b); }, x, y);
+        }, release_gil());
+
+        m.def(name, [metric, kernel](C const& x, C const& y, C const& w) {
+            return with_iterators<T>([&](auto n, auto a, auto b, auto c) { return invoke_metric(metric, kernel, a, a + n, b, c); }, x, y, w);
+        }, release_gil());
+    }
+
+    // the rows of the two-dimensional array are the observations, the columns are the features
     template<typename T>
-    inline auto univariate_accumulate(std::span<T const> x, std::span<T const> w) {
-        return vstat::univariate::accumulate<float>(x.begin(), x.end(), w.begin());
+    inline auto multivariate_accumulate(array<T> const& x) -> vstat::multivariate_statistics {
+        if (x.ndim() != 2) {
+            throw nb::value_error("expected a two-dimensional array (one observation per row)");
+        }
+        return vstat::multivariate::accumulate(static_cast<T const*>(x.data()), x.shape(0), x.shape(1), x.stride(0), x.stride(1));
     }
 
     template<typename T>
-    inline auto bivariate_accumulate(std::span<T const> x, std::span<T const> y) {
-        return vstat::bivariate::accumulate<float>(x.begin(), x.end(), y.begin());
+    inline auto multivariate_accumulate(array<T> const& x, array<T> const& w) -> vstat::multivariate_statistics {
+        if (x.ndim() != 2 || w.ndim() != 1 || w.shape(0) != x.shape(0)) {
+            throw nb::value_error("expected a two-dimensional array and one weight per row");
+        }
+        // the weights are small compared to the data, strided weights are copied
+        std::vector<T> weights;
+        T const* pw = w.data();
+        if (w.stride(0) != 1) {
+            weights.resize(w.shape(0));
+            std::ranges::copy_n(vstat::strided_iterator<T const>{w.data(), w.stride(0)}, std::ssize(weights), weights.begin());
+            pw = weights.data();
+        }
+        return vstat::multivariate::accumulate(static_cast<T const*>(x.data()), pw, x.shape(0), x.shape(1), x.stride(0), x.stride(1));
     }
 
+    // computes the metrics in a single pass, the results are returned as a dictionary (by name)
+    template<typename T, typename... Metrics>
+    struct fused_metrics {
+        template<typename... Iters>
+        auto operator()(Iters... iters) const -> std::map<std::string, double> {
+            auto const values = vstat::metrics::evaluate<T, Metrics...>(iters...);
+            std::map<std::string, double> result;
+            std::size_t i{0};
+            ((result[Metrics::name] = values[i++]), ...);
+            return result;
+        }
+    };
+
+    // the statistics of the sliding windows over one-dimensional arrays, returned as two numpy arrays
     template<typename T>
-    inline auto bivariate_accumulate(std::span<T const> x, std::span<T const> y, std::span<T const> w) {
-        return vstat::bivariate::accumulate<float>(x.begin(), x.end(), y.begin(), w.begin());
+    inline auto rolling(array<T> const& x, std::size_t window) {
+        if (x.ndim() != 1 || window == 0) {
+            throw nb::value_error("expected a one-dimensional array and a positive window size");
+        }
+        std::vector<double> mean(x.size());
+        std::vector<double> variance(x.size());
+        {
+            nb::gil_scoped_release release;
+            with_iterators<T>([&](auto n, auto first) { vstat::univariate::rolling<T>(first, first + n, window, mean.begin(), variance.begin()); }, x);
+        }
+        std::vector<std::size_t> const shape{ x.size() };
+        return std::make_pair(to_numpy(std::move(mean), shape), to_numpy(std::move(variance), shape));
+    }
+
+    template<typename T>
+    inline auto rolling(array<T> const& x, array<T> const& y, std::size_t window) {
+        if (x.ndim() != 1 || y.ndim() != 1 || window == 0) {
+            throw nb::value_error("expected one-dimensional arrays and a positive window size");
+        }
+        std::vector<double> covariance(x.size());
+        std::vector<double> correlation(x.size());
+        {
+            nb::gil_scoped_release release;
+            with_iterators<T>([&](auto n, auto first1, auto first2) {
+                vstat::bivariate::rolling<T>(first1, first1 + n, first2, window, covariance.begin(), correlation.begin());
+            }, x, y);
+        }
+        std::vector<std::size_t> const shape{ x.size() };
+        return std::make_pair(to_numpy(std::move(covariance), shape), to_numpy(std::move(correlation), shape));
+    }
+
+    // the statistics of the groups given by integer keys, returned as numpy arrays (one entry per group). the number
+    // of groups defaults to the largest key + 1, strided keys are copied.
+    template<typename T>
+    inline auto grouped_accumulate(array<std::int64_t> const& keys, array<T> const& x, array<T> const* y, std::optional<std::size_t> groups)
+        -> std::map<std::string, nb::ndarray<nb::numpy, double>> {
+        if (keys.ndim() != 1 || x.ndim() != 1 || keys.size() != x.size() || (y != nullptr && (y->ndim() != 1 || y->size() != x.size()))) {
+            throw nb::value_error("expected one-dimensional arrays of the same size");
+        }
+        vstat::grouped_table table;
+        {
+            nb::gil_scoped_release release;
+            std::vector<std::int64_t> copy;
+            std::int64_t const* k = keys.data();
+            if (!is_contiguous(keys)) {
+                copy.resize(keys.size());
+                std::ranges::copy_n(vstat::strided_iterator<std::int64_t const>{keys.data(), keys.stride(0)}, std::ssize(copy), copy.begin());
+                k = copy.data();
+            }
+            auto const size = static_cast<std::ptrdiff_t>(keys.size());
+            auto const g = groups.value_or(size == 0 ? 0 : static_cast<std::size_t>(std::max<std::int64_t>(*std::max_element(k, k + size), -1) + 1));
+            if (y == nullptr) {
+                table = with_iterators<T>([&](auto n, auto first) { return vstat::grouped::accumulate<T>(first, first + n, k, g); }, x);
+            } else {
+                table = with_iterators<T>([&](auto n, auto first1, auto first2) { return vstat::grouped::accumulate<T>(first1, first1 + n, first2, k, g); }, x, *y);
+            }
+        }
+
+        std::vector<std::size_t> const shape{ table.size() };
+        auto values = [&](auto const& v) { return to_numpy(std::vector<double>(v), shape); };
+        auto derived = [&](auto const& stat) {
+            std::vector<double> v(table.size());
+            for (std::size_t g = 0; g < v.size(); ++g) { v[g] = stat(g); }
+            return to_numpy(std::move(v), shape);
+        };
+        std::map<std::string, nb::ndarray<nb::numpy, double>> result;
+        result["count"] = values(table.sum_w);
+        result["sum"] = values(table.sum_x);
+        result["ssr"] = values(table.sum_xx);
+        result["mean"] = derived([&](auto g) { return table.mean(g); });
+        result["variance"] = derived([&](auto g) { return table.variance(g); });
+        result["sample_variance"] = derived([&](auto g) { return table.sample_variance(g); });
+        if (table.bivariate()) {
+            result["sum_y"] = values(table.sum_y);
+            result["ssr_y"] = values(table.sum_yy);
+            result["mean_y"] = derived([&](auto g) { return table.mean_y(g); });
+            result["covariance"] = derived([&](auto g) { return table.covariance(g); });
+            result["correlation"] = derived([&](auto g) { return table.correlation(g); });
+        }
+        return result;
+    }
+
+    // binds all the methods for the container type C holding values of type T
+    template<typename T, typename C>
+    auto bind(nb::module_& m) -> void {
+        using vstat::univariate_statistics;
+        using vstat::bivariate_statistics;
+
+        // univariate methods
+        m.def("univariate_accumulate", [](C const& x) {
+            return univariate_accumulate<T>(x);
+        }, release_gil());
+
+        m.def("univariate_accumulate", [](C const& x, C const& w) {
+            return univariate_accumulate<T>(x, w);
+        }, release_gil());
+
+        if constexpr (std::is_same_v<C, array<T>>) {
+            m.def("univariate_accumulate", [](C const& x, std::int64_t axis) {
+                return univariate_accumulate<T>(x, axis);
+            }, nb::arg("x"), nb::arg("axis"), release_gil());
+        }
+
+        bind_univariate<T, C>(m, "mean", &univariate_statistics::mean);
+        bind_univariate<T, C>(m, "variance", &univariate_statistics::variance);
+        bind_univariate<T, C>(m, "sample_variance", &univariate_statistics::sample_variance);
+
+        // bivariate methods
+        m.def("bivariate_accumulate", [](C const& x, C const& y) {
+            return bivariate_accumulate<T>(x, y);
+        }, release_gil());
+
+        m.def("bivariate_accumulate", [](C const& x, C const& y, C const& w) {
+            return bivariate_accumulate<T>(x, y, w);
+        }, release_gil());
+
+        bind_bivariate<T, C>(m, "covariance", &bivariate_statistics::covariance);
+        bind_bivariate<T, C>(m, "sample_covariance", &bivariate_statistics::sample_covariance);
+        bind_bivariate<T, C>(m, "correlation", &bivariate_statistics::correlation);
+
+        if constexpr (std::is_same_v<C, array<T>>) {
+            m.def("multivariate_accumulate", [](C const& x) {
+                return multivariate_accumulate<T>(x);
+            }, release_gil());
+
+            m.def("multivariate_accumulate", [](C const& x, C const& w) {
+                return multivariate_accumulate<T>(x, w);
+            }, release_gil());
+
+            // grouped statistics, the keys are integers in [0, groups)
+            m.def("grouped_accumulate", [](array<std::int64_t> const& keys, C const& x, std::optional<std::size_t> groups) {
+                return grouped_accumulate<T>(keys, x, nullptr, groups);
+            }, nb::arg("keys"), nb::arg("x"), nb::arg("groups") = nb::none());
+
+            m.def("grouped_accumulate", [](array<std::int64_t> const& keys, C const& x, C const& y, std::optional<std::size_t> groups) {
+                return grouped_accumulate<T>(keys, x, &y, groups);
+            }, nb::arg("keys"), nb::arg("x"), nb::arg("y"), nb::arg("groups") = nb::none());
+
+            // rolling windows: (mean, variance) of one array, (covariance, correlation) of two arrays
+            m.def("rolling", [](C const& x, std::size_t window) {
+                return rolling<T>(x, window);
+            }, nb::arg("x"), nb::arg("window"));
+
+            m.def("rolling", [](C const& x, C const& y, std::size_t window) {
+                return rolling<T>(x, y, window);
+            }, nb::arg("x"), nb::arg("y"), nb::arg("window"));
+        }
+
+        // metrics
+        bind_metric<T, C>(m, "mean_absolute_error",
+            [](auto... args) { return vstat::metrics::mean_absolute_error<T>(args...); },
+            [](auto... args) { return vstat::dispatch::metrics::mean_absolute_error(args...); });
+        bind_metric<T, C>(m, "mean_absolute_percentage_error",
+            [](auto... args) { return vstat::metrics::mean_absolute_percentage_error<T>(args...); },
+            [](auto... args) { return vstat::dispatch::metrics::mean_absolute_percentage_error(args...); });
+        bind_metric<T, C>(m, "mean_squared_error",
+            [](auto... args) { return vstat::metrics::mean_squared_error<T>(args...); },
+            [](auto... args) { return vstat::dispatch::metrics::mean_squared_error(args...); });
+        bind_metric<T, C>(m, "mean_squared_log_error",
+            [](auto... args) { return vstat::metrics::mean_squared_log_error<T>(args...); },
+            [](auto... args) { return vstat::dispatch::metrics::mean_squared_log_error(args...); });
+        bind_metric<T, C>(m, "r2_score",
+            [](auto... args) { return vstat::metrics::r2_score<T>(args...); },
+            [](auto... args) { return vstat::dispatch::metrics::r2_score(args...); });
+        bind_metric<T, C>(m, "poisson_neg_likelihood_loss",
+            [](auto... args) { return vstat::metrics::poisson_neg_likelihood_loss<T>(args...); },
+            [](auto... args) { return vstat::dispatch::metrics::poisson_neg_likelihood_loss(args...); });
+
+        namespace mt = vstat::metrics;
+        bind_metric<T, C>(m, "evaluate", fused_metrics<T, mt::r2, mt::mse, mt::msle, mt::mae, mt::mape, mt::poisson>{});
     }
 } // namespace detail
 
@@ -44,7 +710,11 @@ NB_MODULE(vstat, m) { // NOLINT
         .def_ro("ssr", &vstat::univariate_statistics::ssr)
         .def_ro("mean", &vstat::univariate_statistics::mean)
         .def_ro("variance", &vstat::univariate_statistics::variance)
-        .def_ro("sample_variance", &vstat::univariate_statistics::sample_variance);
+        .def_ro("sample_variance", &vstat::univariate_statistics::sample_variance)
+        .def_ro("min", &vstat::univariate_statistics::min)
+        .def_ro("max", &vstat::univariate_statistics::max)
+        .def_ro("argmin", &vstat::univariate_statistics::argmin)
+        .def_ro("argmax", &vstat::univariate_statistics::argmax);
 
     nb::class_<vstat::bivariate_statistics>(m, "bivariate_statistics")
         .def_ro("count", &vstat::bivariate_statistics::count)
@@ -62,567 +732,97 @@ NB_MODULE(vstat, m) { // NOLINT
         .def_ro("covariance", &vstat::bivariate_statistics::covariance)
         .def_ro("sample_covariance", &vstat::bivariate_statistics::sample_covariance);
 
-    // single-precision (float)
-    // univariate methods
-    m.def("univariate_accumulate", [](detail::array<float> x) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()});
-    });
-
-    m.def("univariate_accumulate", [](std::vector<float> const& x) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()});
-    });
-
-    m.def("univariate_accumulate", [](detail::array<double> x) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()});
-    });
-
-    m.def("univariate_accumulate", [](std::vector<double> const& x) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()});
-    });
-
-    // mean
-    m.def("mean", [](detail::array<float> x) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()}).mean;
-    });
-
-    m.def("mean", [](detail::array<float> x, detail::array<float> w) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()}, {w.data(), w.size()});
-    });
-
-    m.def("mean", [](std::vector<float> const& x) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()}).mean;
-    });
-
-    m.def("mean", [](std::vector<float> const& x, std::vector<float> const& w) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()}, {w.data(), w.size()}).mean;
-    });
-
-    // variance
-    m.def("variance", [](detail::array<float> x) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()}).variance;
-    });
-
-    m.def("variance", [](detail::array<float> x, detail::array<float> w) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()}, {w.data(), w.size()});
-    });
-
-    m.def("variance", [](std::vector<float> const& x) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()}).variance;
-    });
-
-    m.def("variance", [](std::vector<float> const& x, std::vector<float> const& w) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()}, {w.data(), w.size()}).variance;
-    });
-
-    // sample variance
-    m.def("sample_variance", [](detail::array<float> x) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()}).sample_variance;
-    });
-
-    m.def("sample_variance", [](detail::array<float> x, detail::array<float> w) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()}, {w.data(), w.size()});
-    });
-
-    m.def("sample_variance", [](std::vector<float> const& x) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()}).sample_variance;
-    });
-
-    m.def("sample_variance", [](std::vector<float> const& x, std::vector<float> const& w) {
-        return detail::univariate_accumulate<float>({x.data(), x.size()}, {w.data(), w.size()}).sample_variance;
-    });
-
-    // bivariate methods
-    // covariance
-    m.def("covariance", [](detail::array<float> x, detail::array<float> y) {
-        return detail::bivariate_accumulate<float>({x.data(), x.size()}, {y.data(), y.size()}).covariance;
-    });
-
-    m.def("covariance", [](detail::array<float> x, detail::array<float> y, detail::array<float> w) {
-        return detail::bivariate_accumulate<float>({x.data(), x.size()}, {y.data(), y.size()}, {w.data(), w.size()}).covariance;
-    });
-
-    m.def("covariance", [](std::vector<float> const& x, std::vector<float> const& y) {
-        return detail::bivariate_accumulate<float>({x.data(), x.size()}, {y.data(), y.size()}).covariance;
-    });
-
-    m.def("covariance", [](std::vector<float> const& x, std::vector<float> const& y, std::vector<float> const& w) {
-        return detail::bivariate_accumulate<float>({x.data(), x.size()}, {y.data(), y.size()}, {w.data(), w.size()}).covariance;
-    });
-
-    m.def("sample_covariance", [](detail::array<float> x, detail::array<float> y) {
-        return detail::bivariate_accumulate<float>({x.data(), x.size()}, {y.data(), y.size()}).sample_covariance;
-    });
-
-    m.def("sample_covariance", [](detail::array<float> x, detail::array<float> y, detail::array<float> w) {
-        return detail::bivariate_accumulate<float>({x.data(), x.size()}, {y.data(), y.size()}, {w.data(), w.size()}).sample_covariance;
-    });
-
-    m.def("sample_covariance", [](std::vector<float> const& x, std::vector<float> const& y) {
-        return detail::bivariate_accumulate<float>({x.data(), x.size()}, {y.data(), y.size()}).sample_covariance;
-    });
-
-    m.def("sample_covariance", [](std::vector<float> const& x, std::vector<float> const& y, std::vector<float> const& w) {
-        return detail::bivariate_accumulate<float>({x.data(), x.size()}, {y.data(), y.size()}, {w.data(), w.size()}).sample_covariance;
-    });
-
-    m.def("correlation", [](detail::array<float> x, detail::array<float> y) {
-        return detail::bivariate_accumulate<float>({x.data(), x.size()}, {y.data(), y.size()}).correlation;
-    });
-
-    m.def("correlation", [](detail::array<float> x, detail::array<float> y, detail::array<float> w) {
-        return detail::bivariate_accumulate<float>({x.data(), x.size()}, {y.data(), y.size()}, {w.data(), w.size()}).correlation;
-    });
-
-    m.def("correlation", [](std::vector<float> const& x, std::vector<float> const& y) {
-        return detail::bivariate_accumulate<float>({x.data(), x.size()}, {y.data(), y.size()}).correlation;
-    });
-
-    m.def("correlation", [](std::vector<float> const& x, std::vector<float> const& y, std::vector<float> const& w) {
-        return detail::bivariate_accumulate<float>({x.data(), x.size()}, {y.data(), y.size()}, {w.data(), w.size()}).correlation;
-    });
-
-    // metrics
-    // mean absolute error
-    m.def("mean_absolute_error", [](detail::array<float> x, detail::array<float> y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_absolute_error<float>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_absolute_error", [](detail::array<float> x, detail::array<float> y, detail::array<float> w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_absolute_error<float>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    m.def("mean_absolute_error", [](std::vector<float> const& x, std::vector<float> const& y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_absolute_error<float>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_absolute_error", [](std::vector<float> const& x, std::vector<float> const& y, std::vector<float> const& w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_absolute_error<float>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    // mean absolute percentage error
-    m.def("mean_absolute_percentage_error", [](detail::array<float> x, detail::array<float> y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_absolute_percentage_error<float>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_absolute_percentage_error", [](detail::array<float> x, detail::array<float> y, detail::array<float> w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_absolute_percentage_error<float>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    m.def("mean_absolute_percentage_error", [](std::vector<float> const& x, std::vector<float> const& y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_absolute_percentage_error<float>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_absolute_percentage_error", [](std::vector<float> const& x, std::vector<float> const& y, std::vector<float> const& w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_absolute_percentage_error<float>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    // mean squared error
-    m.def("mean_squared_error", [](detail::array<float> x, detail::array<float> y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_squared_error<float>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_squared_error", [](detail::array<float> x, detail::array<float> y, detail::array<float> w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_squared_error<float>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    m.def("mean_squared_error", [](std::vector<float> const& x, std::vector<float> const& y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_squared_error<float>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_squared_error", [](std::vector<float> const& x, std::vector<float> const& y, std::vector<float> const& w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_squared_error<float>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    // mean squared log error
-    m.def("mean_squared_log_error", [](detail::array<float> x, detail::array<float> y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_squared_log_error<float>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_squared_log_error", [](detail::array<float> x, detail::array<float> y, detail::array<float> w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_squared_log_error<float>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    m.def("mean_squared_log_error", [](std::vector<float> const& x, std::vector<float> const& y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_squared_log_error<float>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_squared_log_error", [](std::vector<float> const& x, std::vector<float> const& y, std::vector<float> const& w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_squared_log_error<float>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    // r2 score
-    m.def("r2_score", [](detail::array<float> x, detail::array<float> y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::r2_score<float>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("r2_score", [](detail::array<float> x, detail::array<float> y, detail::array<float> w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::r2_score<float>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    m.def("r2_score", [](std::vector<float> const& x, std::vector<float> const& y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::r2_score<float>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("r2_score", [](std::vector<float> const& x, std::vector<float> const& y, std::vector<float> const& w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::r2_score<float>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    // poisson loss
-    m.def("poisson_neg_likelihood_loss", [](detail::array<float> x, detail::array<float> y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::poisson_neg_likelihood_loss<float>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("poisson_neg_likelihood_loss", [](detail::array<float> x, detail::array<float> y, detail::array<float> w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::poisson_neg_likelihood_loss<float>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    m.def("poisson_neg_likelihood_loss", [](std::vector<float> const& x, std::vector<float> const& y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::poisson_neg_likelihood_loss<float>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("poisson_neg_likelihood_loss", [](std::vector<float> const& x, std::vector<float> const& y, std::vector<float> const& w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::poisson_neg_likelihood_loss<float>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    // double-precision (double)
-    // univariate methods
-    m.def("univariate_accumulate", [](detail::array<double> x) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()});
-    });
-
-    m.def("univariate_accumulate", [](std::vector<double> const& x) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()});
-    });
-
-    m.def("univariate_accumulate", [](detail::array<double> x) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()});
-    });
-
-    m.def("univariate_accumulate", [](std::vector<double> const& x) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()});
-    });
-
-    // mean
-    m.def("mean", [](detail::array<double> x) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()}).mean;
-    });
-
-    m.def("mean", [](detail::array<double> x, detail::array<double> w) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()}, {w.data(), w.size()});
-    });
-
-    m.def("mean", [](std::vector<double> const& x) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()}).mean;
-    });
-
-    m.def("mean", [](std::vector<double> const& x, std::vector<double> const& w) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()}, {w.data(), w.size()}).mean;
-    });
-
-    // variance
-    m.def("variance", [](detail::array<double> x) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()}).variance;
-    });
-
-    m.def("variance", [](detail::array<double> x, detail::array<double> w) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()}, {w.data(), w.size()});
-    });
-
-    m.def("variance", [](std::vector<double> const& x) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()}).variance;
-    });
-
-    m.def("variance", [](std::vector<double> const& x, std::vector<double> const& w) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()}, {w.data(), w.size()}).variance;
-    });
-
-    // sample variance
-    m.def("sample_variance", [](detail::array<double> x) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()}).sample_variance;
-    });
-
-    m.def("sample_variance", [](detail::array<double> x, detail::array<double> w) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()}, {w.data(), w.size()});
-    });
-
-    m.def("sample_variance", [](std::vector<double> const& x) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()}).sample_variance;
-    });
-
-    m.def("sample_variance", [](std::vector<double> const& x, std::vector<double> const& w) {
-        return detail::univariate_accumulate<double>({x.data(), x.size()}, {w.data(), w.size()}).sample_variance;
-    });
-
-    // bivariate methods
-    // covariance
-    m.def("covariance", [](detail::array<double> x, detail::array<double> y) {
-        return detail::bivariate_accumulate<double>({x.data(), x.size()}, {y.data(), y.size()}).covariance;
-    });
-
-    m.def("covariance", [](detail::array<double> x, detail::array<double> y, detail::array<double> w) {
-        return detail::bivariate_accumulate<double>({x.data(), x.size()}, {y.data(), y.size()}, {w.data(), w.size()}).covariance;
-    });
-
-    m.def("covariance", [](std::vector<double> const& x, std::vector<double> const& y) {
-        return detail::bivariate_accumulate<double>({x.data(), x.size()}, {y.data(), y.size()}).covariance;
-    });
-
-    m.def("covariance", [](std::vector<double> const& x, std::vector<double> const& y, std::vector<double> const& w) {
-        return detail::bivariate_accumulate<double>({x.data(), x.size()}, {y.data(), y.size()}, {w.data(), w.size()}).covariance;
-    });
-
-    m.def("sample_covariance", [](detail::array<double> x, detail::array<double> y) {
-        return detail::bivariate_accumulate<double>({x.data(), x.size()}, {y.data(), y.size()}).sample_covariance;
-    });
-
-    m.def("sample_covariance", [](detail::array<double> x, detail::array<double> y, detail::array<double> w) {
-        return detail::bivariate_accumulate<double>({x.data(), x.size()}, {y.data(), y.size()}, {w.data(), w.size()}).sample_covariance;
-    });
-
-    m.def("sample_covariance", [](std::vector<double> const& x, std::vector<double> const& y) {
-        return detail::bivariate_accumulate<double>({x.data(), x.size()}, {y.data(), y.size()}).sample_covariance;
-    });
-
-    m.def("sample_covariance", [](std::vector<double> const& x, std::vector<double> const& y, std::vector<double> const& w) {
-        return detail::bivariate_accumulate<double>({x.data(), x.size()}, {y.data(), y.size()}, {w.data(), w.size()}).sample_covariance;
-    });
-
-    m.def("correlation", [](detail::array<double> x, detail::array<double> y) {
-        return detail::bivariate_accumulate<double>({x.data(), x.size()}, {y.data(), y.size()}).correlation;
-    });
-
-    m.def("correlation", [](detail::array<double> x, detail::array<double> y, detail::array<double> w) {
-        return detail::bivariate_accumulate<double>({x.data(), x.size()}, {y.data(), y.size()}, {w.data(), w.size()}).correlation;
-    });
-
-    m.def("correlation", [](std::vector<double> const& x, std::vector<double> const& y) {
-        return detail::bivariate_accumulate<double>({x.data(), x.size()}, {y.data(), y.size()}).correlation;
-    });
-
-    m.def("correlation", [](std::vector<double> const& x, std::vector<double> const& y, std::vector<double> const& w) {
-        return detail::bivariate_accumulate<double>({x.data(), x.size()}, {y.data(), y.size()}, {w.data(), w.size()}).correlation;
-    });
-
-    // metrics
-    // mean absolute error
-    m.def("mean_absolute_error", [](detail::array<double> x, detail::array<double> y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_absolute_error<double>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_absolute_error", [](detail::array<double> x, detail::array<double> y, detail::array<double> w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_absolute_error<double>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    m.def("mean_absolute_error", [](std::vector<double> const& x, std::vector<double> const& y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_absolute_error<double>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_absolute_error", [](std::vector<double> const& x, std::vector<double> const& y, std::vector<double> const& w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_absolute_error<double>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    // mean absolute percentage error
-    m.def("mean_absolute_percentage_error", [](detail::array<double> x, detail::array<double> y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_absolute_percentage_error<double>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_absolute_percentage_error", [](detail::array<double> x, detail::array<double> y, detail::array<double> w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_absolute_percentage_error<double>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    m.def("mean_absolute_percentage_error", [](std::vector<double> const& x, std::vector<double> const& y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_absolute_percentage_error<double>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_absolute_percentage_error", [](std::vector<double> const& x, std::vector<double> const& y, std::vector<double> const& w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_absolute_percentage_error<double>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    // mean squared error
-    m.def("mean_squared_error", [](detail::array<double> x, detail::array<double> y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_squared_error<double>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_squared_error", [](detail::array<double> x, detail::array<double> y, detail::array<double> w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_squared_error<double>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    m.def("mean_squared_error", [](std::vector<double> const& x, std::vector<double> const& y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_squared_error<double>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_squared_error", [](std::vector<double> const& x, std::vector<double> const& y, std::vector<double> const& w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_squared_error<double>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    // mean squared log error
-    m.def("mean_squared_log_error", [](detail::array<double> x, detail::array<double> y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_squared_log_error<double>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_squared_log_error", [](detail::array<double> x, detail::array<double> y, detail::array<double> w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_squared_log_error<double>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    m.def("mean_squared_log_error", [](std::vector<double> const& x, std::vector<double> const& y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::mean_squared_log_error<double>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("mean_squared_log_error", [](std::vector<double> const& x, std::vector<double> const& y, std::vector<double> const& w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::mean_squared_log_error<double>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    // r2 score
-    m.def("r2_score", [](detail::array<double> x, detail::array<double> y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::r2_score<double>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("r2_score", [](detail::array<double> x, detail::array<double> y, detail::array<double> w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::r2_score<double>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    m.def("r2_score", [](std::vector<double> const& x, std::vector<double> const& y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::r2_score<double>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("r2_score", [](std::vector<double> const& x, std::vector<double> const& y, std::vector<double> const& w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::r2_score<double>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    // poisson loss
-    m.def("poisson_neg_likelihood_loss", [](detail::array<double> x, detail::array<double> y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::poisson_neg_likelihood_loss<double>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("poisson_neg_likelihood_loss", [](detail::array<double> x, detail::array<double> y, detail::array<double> w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::poisson_neg_likelihood_loss<double>(a.begin(), a.end(), b.begin(), c.begin());
-    });
-
-    m.def("poisson_neg_likelihood_loss", [](std::vector<double> const& x, std::vector<double> const& y) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        return vstat::metrics::poisson_neg_likelihood_loss<double>(a.begin(), a.end(), b.begin());
-    });
-
-    m.def("poisson_neg_likelihood_loss", [](std::vector<double> const& x, std::vector<double> const& y, std::vector<double> const& w) {
-        std::span a{x.data(), x.size()};
-        std::span b{y.data(), y.size()};
-        std::span c{w.data(), w.size()};
-        return vstat::metrics::poisson_neg_likelihood_loss<double>(a.begin(), a.end(), b.begin(), c.begin());
-    });
+    // the vectors and matrices are returned as numpy arrays (copies)
+    using vstat::multivariate_statistics;
+    auto vector = [](auto field) {
+        return [field](multivariate_statistics const& s) { return detail::to_numpy(std::vector<double>(s.*field), { s.dim }); };
+    };
+    auto matrix = [](auto field) {
+        return [field](multivariate_statistics const& s) { return detail::to_numpy(std::vector<double>(s.*field), { s.dim, s.dim }); };
+    };
+
+    nb::class_<multivariate_statistics>(m, "multivariate_statistics")
+        .def_ro("count", &multivariate_statistics::count)
+        .def_prop_ro("sum", vector(&multivariate_statistics::sum))
+        .def_prop_ro("mean", vector(&multivariate_statistics::mean))
+        .def_prop_ro("covariance", matrix(&multivariate_statistics::covariance))
+        .def_prop_ro("sample_covariance", matrix(&multivariate_statistics::sample_covariance))
+        .def_prop_ro("correlation", matrix(&multivariate_statistics::correlation));
+
+    // streaming accumulators, updated with batches of float or double values
+    auto ua = nb::class_<detail::univariate_stream>(m, "univariate_accumulator")
+        .def(nb::init<>())
+        .def("merge", [](detail::univariate_stream& a, detail::univariate_stream const& b) { a.merge(b); }, nb::arg("other"), detail::release_gil())
+        .def("stats", &detail::univariate_stream::stats, detail::release_gil());
+    detail::bind_updates<float>(ua);
+    detail::bind_updates<double>(ua);
+    detail::bind_serialization(ua);
+
+    auto ba = nb::class_<detail::bivariate_stream>(m, "bivariate_accumulator")
+        .def(nb::init<>())
+        .def("merge", [](detail::bivariate_stream& a, detail::bivariate_stream const& b) { a.merge(b); }, nb::arg("other"), detail::release_gil())
+        .def("stats", &detail::bivariate_stream::stats, detail::release_gil());
+    detail::bind_updates<float>(ba);
+    detail::bind_updates<double>(ba);
+    detail::bind_serialization(ba);
+
+    // histograms with uniform or logarithmic bins, updated with batches of float or double values
+    using histogram = vstat::histogram_accumulator<double>;
+    auto counts = [](histogram const& h) {
+        auto const c = h.counts();
+        return detail::to_numpy(std::vector<double>(c.begin(), c.end()), { c.size() });
+    };
+    auto ha = nb::class_<histogram>(m, "histogram")
+        .def("__init__", [](histogram* h, double min, double max, std::size_t bins, bool log) {
+            if (!(min < max) || bins == 0 || (log && !(min > 0))) {
+                throw nb::value_error("invalid bin layout");
+            }
+            new (h) histogram(log ? vstat::histogram_bins::log(min, max, bins) : vstat::histogram_bins::uniform(min, max, bins));
+        }, nb::arg("min"), nb::arg("max"), nb::arg("bins"), nb::arg("log") = false)
+        .def("merge", [](histogram& a, histogram const& b) {
+            if (!(a.bins() == b.bins())) {
+                throw nb::value_error("the histograms have different bin layouts");
+            }
+            a.merge(b);
+        }, nb::arg("other"), detail::release_gil())
+        .def_prop_ro("counts", counts)
+        .def_prop_ro("edges", [](histogram const& h) { return detail::to_numpy(h.bins().edges(), { h.bins().count + 1 }); })
+        .def_prop_ro("underflow", &histogram::underflow)
+        .def_prop_ro("overflow", &histogram::overflow)
+        .def_prop_ro("nan_count", &histogram::nan_count)
+        .def_prop_ro("total", &histogram::total);
+    detail::bind_updates<float>(ha);
+    detail::bind_updates<double>(ha);
+
+    // exponentially weighted moving mean and variance, with a smoothing factor or a half-life (in samples)
+    using ewma = vstat::ewma_accumulator<double>;
+    auto ea = nb::class_<ewma>(m, "ewma")
+        .def("__init__", [](ewma* acc, std::optional<double> alpha, std::optional<double> half_life) {
+            if (alpha.has_value() == half_life.has_value()) {
+                throw nb::value_error("exactly one of alpha and half_life must be given");
+            }
+            if (alpha ? !(*alpha > 0 && *alpha <= 1) : !(*half_life > 0)) {
+                throw nb::value_error("alpha must be in (0, 1] and half_life must be positive");
+            }
+            new (acc) ewma(alpha ? ewma(*alpha) : ewma::from_half_life(*half_life));
+        }, nb::arg("alpha") = nb::none(), nb::arg("half_life") = nb::none())
+        .def_prop_ro("alpha", &ewma::alpha)
+        .def_prop_ro("count", &ewma::count)
+        .def_prop_ro("mean", &ewma::mean)
+        .def_prop_ro("variance", &ewma::variance);
+    detail::bind_updates<float>(ea);
+    detail::bind_updates<double>(ea);
+
+#if defined(VSTAT_DISPATCH)
+    // the instruction set level of the kernels selected at runtime
+    m.def("isa", []() { return std::string(vstat::dispatch::isa_name(vstat::dispatch::active_isa())); });
+#endif
+
+    // the array overloads are registered first, so that numpy arrays are never
+    // matched against (and copied into) the std::vector overloads
+    detail::bind<float, detail::array<float>>(m);
+    detail::bind<double, detail::array<double>>(m);
+
+    detail::bind<float, std::vector<float>>(m);
+    detail::bind<double, std::vector<double>>(m);
 }
@@ -0,0 +1,48 @@
+# SPDX-License-Identifier: MIT
+# SPDX-FileCopyrightText: Copyright 2019-2024 Heal Research
+
+# Measures how the vstat python bindings scale with the number of concurrent python threads.
+# The bindings release the GIL while computing, so the throughput should grow with the thread count.
+#
+# usage: python test/python/benchmark_threads.py [size] [repeats]
+
+import os
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+import vstat
+
+
+def run(arrays, threads, repeats):
+    def work(x):
+        for _ in range(repeats):
+            vstat.variance(x)
+
+    with ThreadPoolExecutor(max_workers=threads) as pool:
+        start = time.perf_counter()
+        list(pool.map(work, arrays[:threads]))
+        return time.perf_counter() - start
+
+
+def main():
+    size = int(sys.argv[1]) if len(sys.argv) > 1 else 10_000_000
+    repeats = int(sys.argv[2]) if len(sys.argv) > 2 else 10
+    cores = os.cpu_count() or 1
+
+    rng = np.random.default_rng(1234)
+    for dtype in (np.float32, np.float64):
+        arrays = [rng.uniform(-1, 1, size).astype(dtype) for _ in range(cores)]
+        base = None
+        threads = 1
+        while threads <= cores:
+            elapsed = run(arrays, threads, repeats)
+            throughput = threads * repeats * size / elapsed
+            base = base or throughput
+            print(f'{np.dtype(dtype).name};{threads} threads;{throughput / 1e9:.3f} Gelem/s;speedup {throughput / base:.2f}')
+            threads *= 2
+
+
+if __name__ == '__main__':
+    main()
@@ -7,13 +7,29 @@
 #define ANKERL_NANOBENCH_IMPLEMENT
 #include "nanobench.h"
 
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <random>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include <eve/module/algo.hpp>
 
+#include "vstat/csv.hpp"
+#include "vstat/mapped.hpp"
 #include "vstat/vstat.hpp"
+#if defined(VSTAT_DISPATCH)
+#include "vstat/dispatch.hpp"
+#endif
+#if defined(VSTAT_PRECOMPILED_KERNELS)
+#include "vstat/kernels.hpp"
+#endif
 #include "stat_other.hpp"
 
 namespace nb = ankerl::nanobench;
@@ -21,6 +37,7 @@ namespace dt = doctest;
 
 namespace uv = vstat::univariate;
 namespace bv = vstat::bivariate;
+namespace gr = vstat::grouped;
 
 namespace VSTAT_NAMESPACE::test {
 namespace util {
@@ -300,20 +317,2038 @@ namespace util {
         }
     }
 
-    TEST_CASE("benchmarks" * dt::test_suite("[performance]")) {
+    TEST_CASE("merge" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        auto test_merge = [&]<typename T = double>(int n, T eps) {
+            using wide = eve::wide<T>;
+            auto constexpr s{ wide::size() };
+
+            auto x = util::generate<T>(rng, n);
+            auto y = util::generate<T>(rng, n);
+            auto const h = n / 2;
+
+            // scalar accumulators over two halves of the data
+            univariate_accumulator<T> ua;
+            univariate_accumulator<T> ub;
+            bivariate_accumulator<T> ba;
+            bivariate_accumulator<T> bb;
+            for (auto i = 0; i < n; ++i) {
+                i < h ? ua(x[i]) : ub(x[i]);
+                i < h ? ba(x[i], y[i]) : bb(x[i], y[i]);
+            }
+            ua += ub;
+            ba += bb;
+
+            auto const u = uv::accumulate<T>(x.begin(), x.end());
+            auto const b = bv::accumulate<T>(x.begin(), x.end(), y.begin());
+            REQUIRE(equal<T>(univariate_statistics(ua).variance, u.variance, eps));
+            REQUIRE(equal<T>(bivariate_statistics(ba).covariance, b.covariance, eps));
+
+            // SIMD accumulators are merged lane-wise
+            univariate_accumulator<wide> wa;
+            univariate_accumulator<wide> wb;
+            auto const m = n - n % (2 * s);
+            for (auto i = 0; i < m; i += 2 * s) {
+                wa(x.data() + i);
+                wb(x.data() + i + s);
+            }
+            wa.merge(wb);
+            if (m > 0) {
+                auto const w = uv::accumulate<T>(x.begin(), x.begin() + m);
+                REQUIRE(equal<T>(univariate_statistics(wa).variance, w.variance, eps));
+            }
+
+            // merging an empty accumulator is a no-op
+            univariate_accumulator<T> empty;
+            auto const before = univariate_statistics(ua).ssr;
+            ua += empty;
+            empty += ua;
+            REQUIRE(univariate_statistics(ua).ssr == before);
+            REQUIRE(equal<T>(univariate_statistics(empty).variance, u.variance, eps));
+        };
+
+        SUBCASE("double") {
+            double const eps{1e-6};
+            SUBCASE("small") { test_merge(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_merge(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_merge(count_large, eps); } // NOLINT
+        }
+
+        SUBCASE("float") {
+            float const eps{1e-5};
+            SUBCASE("small") { test_merge.operator()<float>(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_merge.operator()<float>(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_merge.operator()<float>(count_large, eps); } // NOLINT
+        }
+    }
+
+    TEST_CASE("blocked" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        auto test_blocked = [&]<typename T = double>(int n, T eps) {
+            auto x = util::generate<T>(rng, n, T{-1}, T{1});
+            auto y = util::generate<T>(rng, n, T{-1}, T{1});
+            auto w = util::generate<T>(rng, n);
+
+            auto const u1 = uv::accumulate<T>(x.begin(), x.end());
+            auto const u2 = uv::accumulate_blocked<T>(x.begin(), x.end());
+            REQUIRE(equal<T>(u1.mean, u2.mean, eps));
+            REQUIRE(equal<T>(u1.variance, u2.variance, eps));
+
+            auto const w1 = uv::accumulate<T>(x.begin(), x.end(), w.begin());
+            auto const w2 = uv::accumulate_blocked<T>(x.begin(), x.end(), w.begin());
+            REQUIRE(equal<T>(w1.mean, w2.mean, eps));
+            REQUIRE(equal<T>(w1.variance, w2.variance, eps));
+
+            auto const b1 = bv::accumulate<T>(x.begin(), x.end(), y.begin());
+            auto const b2 = bv::accumulate_blocked<T>(x.begin(), x.end(), y.begin());
+            REQUIRE(equal<T>(b1.covariance, b2.covariance, eps));
+            REQUIRE(equal<T>(b1.correlation, b2.correlation, eps));
+        };
+
+        SUBCASE("double") {
+            double const eps{1e-6};
+            SUBCASE("small") { test_blocked(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_blocked(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_blocked(count_large, eps); } // NOLINT
+        }
+
+        SUBCASE("float") {
+            float const eps{1e-5};
+            SUBCASE("small") { test_blocked.operator()<float>(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_blocked.operator()<float>(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_blocked.operator()<float>(count_large, eps); } // NOLINT
+        }
+    }
+
+    TEST_CASE("strided" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        auto test_strided = [&]<typename T = double>(int rows, int cols, T eps) {
+            auto x = util::generate<T>(rng, rows * cols, T{-1}, T{1});
+            vstat::parallel_policy const policy{ .threads = 4, .min_chunk_size = 64 };
+
+            auto const serial = uv::accumulate_columns(x.data(), rows, cols, cols);
+            auto const parallel = uv::accumulate_columns(policy, x.data(), rows, cols, cols);
+            REQUIRE(serial.size() == static_cast<std::size_t>(cols));
+            REQUIRE(parallel.size() == static_cast<std::size_t>(cols));
+
+            for (auto j = 0; j < cols; ++j) {
+                // a column is a strided view of the row-major matrix
+                vstat::strided_iterator<T const> first{ x.data() + j, cols };
+                auto const stats = uv::accumulate<T>(first, first + rows);
+
+                std::vector<T> column(rows);
+                std::copy(first, first + rows, column.begin());
+                auto const m = static_cast<T>(stat_other::boost::mean(column));
+                auto const v = static_cast<T>(stat_other::boost::variance(column));
+
+                REQUIRE(equal<T>(stats.mean, m, eps));
+                REQUIRE(equal<T>(stats.variance, v, eps));
+                REQUIRE(equal<T>(serial[j].mean, m, eps));
+                REQUIRE(equal<T>(serial[j].variance, v, eps));
+                REQUIRE(equal<T>(parallel[j].mean, m, eps));
+                REQUIRE(equal<T>(parallel[j].variance, v, eps));
+            }
+
+            // a negative row stride walks the matrix bottom-up
+            auto const reversed = uv::accumulate_columns(x.data() + (rows - 1) * cols, rows, cols, -cols);
+            for (auto j = 0; j < cols; ++j) {
+                REQUIRE(equal<T>(reversed[j].mean, serial[j].mean, eps));
+                REQUIRE(equal<T>(reversed[j].variance, serial[j].variance, eps));
+            }
+        };
+
+        SUBCASE("double") {
+            double const eps{1e-6};
+            SUBCASE("narrow") { test_strided(count_medium, 3, eps); } // NOLINT
+            SUBCASE("wide") { test_strided(count_small * 100, 37, eps); } // NOLINT
+        }
+
+        SUBCASE("float") {
+            float const eps{1e-4};
+            SUBCASE("narrow") { test_strided.operator()<float>(count_medium, 3, eps); } // NOLINT
+            SUBCASE("wide") { test_strided.operator()<float>(count_small * 100, 37, eps); } // NOLINT
+        }
+    }
+
+    TEST_CASE("evaluate" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+        namespace mt = vstat::metrics;
+
+        auto test_evaluate = [&]<typename T = double>(int n, T eps) {
+            auto x = util::generate<T>(rng, n, T{0.1}, T{2});
+            auto y = util::generate<T>(rng, n, T{0.1}, T{2});
+            auto w = util::generate<T>(rng, n);
+
+            auto const [r2, mse, msle, mae, mape, poisson] = mt::evaluate<T, mt::r2, mt::mse, mt::msle, mt::mae, mt::mape, mt::poisson>(x.begin(), x.end(), y.begin());
+            REQUIRE(equal<double>(r2, mt::r2_score<T>(x.begin(), x.end(), y.begin()), eps));
+            REQUIRE(equal<double>(mse, mt::mean_squared_error<T>(x.begin(), x.end(), y.begin()), eps));
+            REQUIRE(equal<double>(msle, mt::mean_squared_log_error<T>(x.begin(), x.end(), y.begin()), eps));
+            REQUIRE(equal<double>(mae, mt::mean_absolute_error<T>(x.begin(), x.end(), y.begin()), eps));
+            REQUIRE(equal<double>(mape, mt::mean_absolute_percentage_error<T>(x.begin(), x.end(), y.begin()), eps));
+            REQUIRE(equal<double>(poisson, mt::poisson_neg_likelihood_loss<T>(x.begin(), x.end(), y.begin()), eps * n));
+
+            auto const [wr2, wmse, wmsle, wmae, wmape, wpoisson] = mt::evaluate<T, mt::r2, mt::mse, mt::msle, mt::mae, mt::mape, mt::poisson>(x.begin(), x.end(), y.begin(), w.begin());
+            REQUIRE(equal<double>(wr2, mt::r2_score<T>(x.begin(), x.end(), y.begin(), w.begin()), eps));
+            REQUIRE(equal<double>(wmse, mt::mean_squared_error<T>(x.begin(), x.end(), y.begin(), w.begin()), eps));
+            REQUIRE(equal<double>(wmsle, mt::mean_squared_log_error<T>(x.begin(), x.end(), y.begin(), w.begin()), eps));
+            REQUIRE(equal<double>(wmae, mt::mean_absolute_error<T>(x.begin(), x.end(), y.begin(), w.begin()), eps));
+            REQUIRE(equal<double>(wmape, mt::mean_absolute_percentage_error<T>(x.begin(), x.end(), y.begin(), w.begin()), eps));
+            REQUIRE(equal<double>(wpoisson, mt::poisson_neg_likelihood_loss<T>(x.begin(), x.end(), y.begin(), w.begin()), eps * n));
+        };
+
+        SUBCASE("double") {
+            double const eps{1e-6};
+            SUBCASE("small") { test_evaluate(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_evaluate(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_evaluate(count_large, eps); } // NOLINT
+        }
+
+        SUBCASE("float") {
+            float const eps{1e-4};
+            SUBCASE("small") { test_evaluate.operator()<float>(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_evaluate.operator()<float>(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_evaluate.operator()<float>(count_large, eps); } // NOLINT
+        }
+    }
+
+    TEST_CASE("multivariate" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+        namespace mv = vstat::multivariate;
+
+        auto test_multivariate = [&]<typename T = double>(int rows, int dim, T eps) {
+            auto x = util::generate<T>(rng, rows * dim, T{-1}, T{1});
+            auto w = util::generate<T>(rng, rows);
+            vstat::parallel_policy const policy{ .threads = 4, .min_chunk_size = 64 };
+
+            auto const stats = mv::accumulate(x.data(), rows, dim, dim);
+            auto const weighted = mv::accumulate(x.data(), w.data(), rows, dim, dim);
+            auto const parallel = mv::accumulate(policy, x.data(), rows, dim, dim);
+
+            // feed one observation at a time into two accumulators and merge them
+            vstat::multivariate_accumulator<T> a(dim);
+            vstat::multivariate_accumulator<T> b(dim);
+            for (auto r = 0; r < rows; ++r) {
+                std::span<T const> row{ x.data() + r * dim, static_cast<std::size_t>(dim) };
+                (r < rows / 3 ? a : b)(row);
+            }
+            a += b;
+            vstat::multivariate_statistics const merged(a);
+
+            REQUIRE(stats.count == rows);
+            for (auto i = 0; i < dim; ++i) {
+                vstat::strided_iterator<T const> xi{ x.data() + i, dim };
+                for (auto j = 0; j < dim; ++j) {
+                    vstat::strided_iterator<T const> xj{ x.data() + j, dim };
+                    auto const b1 = bv::accumulate<T>(xi, xi + rows, xj);
+                    auto const b2 = bv::accumulate<T>(xi, xi + rows, xj, w.begin());
+                    auto const k = i * dim + j;
+
+                    REQUIRE(equal<double>(stats.covariance[k], b1.covariance, eps));
+                    REQUIRE(equal<double>(stats.correlation[k], b1.correlation, eps));
+                    REQUIRE(equal<double>(weighted.covariance[k], b2.covariance, eps));
+                    REQUIRE(equal<double>(parallel.covariance[k], b1.covariance, eps));
+                    REQUIRE(equal<double>(merged.covariance[k], b1.covariance, eps));
+                }
+                REQUIRE(equal<double>(stats.mean[i], uv::accumulate<T>(xi, xi + rows).mean, eps));
+            }
+        };
+
+        SUBCASE("double") {
+            double const eps{1e-6};
+            SUBCASE("small") { test_multivariate(count_small, 3, eps); } // NOLINT
+            SUBCASE("medium") { test_multivariate(count_medium, 7, eps); } // NOLINT
+            SUBCASE("large") { test_multivariate(count_large / 10, 13, eps); } // NOLINT
+        }
+
+        SUBCASE("float") {
+            float const eps{1e-4};
+            SUBCASE("small") { test_multivariate.operator()<float>(count_small, 3, eps); } // NOLINT
+            SUBCASE("medium") { test_multivariate.operator()<float>(count_medium, 7, eps); } // NOLINT
+            SUBCASE("large") { test_multivariate.operator()<float>(count_large / 10, 13, eps); } // NOLINT
+        }
+    }
+
+    TEST_CASE("update" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        auto test_update = [&]<typename T = double>(int n, T eps) {
+            auto x = util::generate<T>(rng, n, T{-1}, T{1});
+            auto y = util::generate<T>(rng, n, T{-1}, T{1});
+            auto w = util::generate<T>(rng, n);
+
+            // the batches are accumulated in double precision, regardless of the input type
+            using wide = eve::wide<double>;
+            vstat::univariate_accumulator<wide> uw;
+            vstat::univariate_accumulator<double> us;
+            vstat::univariate_accumulator<wide> ww;
+            vstat::univariate_accumulator<double> ws;
+            vstat::bivariate_accumulator<wide> bw;
+            vstat::bivariate_accumulator<double> bs;
+
+            for (auto i = 0; i < n;) {
+                auto const b = std::min(n - i, 1 + i % 37);
+                auto const x0 = x.begin() + i;
+                auto const y0 = y.begin() + i;
+                auto const w0 = w.begin() + i;
+
+                for (auto it = uv::update(uw, x0, x0 + b); it < x0 + b; ++it) {
+                    us(*it);
+                }
+                for (auto [it, jt] = uv::update(ww, x0, x0 + b, w0); it < x0 + b; ++it, ++jt) {
+                    ws(*it, *jt);
+                }
+                for (auto [it, jt] = bv::update(bw, x0, x0 + b, y0); it < x0 + b; ++it, ++jt) {
+                    bs(*it, *jt);
+                }
+                i += b;
+            }
+
+            auto u = vstat::univariate_accumulator<double>::load_state(uw.stats());
+            u += us;
+            auto uw2 = vstat::univariate_accumulator<double>::load_state(ww.stats());
+            uw2 += ws;
+            auto const [sw, sx, sy, sxx, syy, sxy] = bw.stats();
+            auto b = vstat::bivariate_accumulator<double>::load_state(sx, sy, sw, sxx, syy, sxy);
+            b += bs;
+
+            auto const u1 = uv::accumulate<T>(x.begin(), x.end());
+            auto const w1 = uv::accumulate<T>(x.begin(), x.end(), w.begin());
+            auto const b1 = bv::accumulate<T>(x.begin(), x.end(), y.begin());
+            REQUIRE(equal<double>(vstat::univariate_statistics(u).mean, u1.mean, eps));
+            REQUIRE(equal<double>(vstat::univariate_statistics(u).variance, u1.variance, eps));
+            REQUIRE(equal<double>(vstat::univariate_statistics(uw2).mean, w1.mean, eps));
+            REQUIRE(equal<double>(vstat::univariate_statistics(uw2).variance, w1.variance, eps));
+            REQUIRE(equal<double>(vstat::bivariate_statistics(b).covariance, b1.covariance, eps));
+            REQUIRE(equal<double>(vstat::bivariate_statistics(b).correlation, b1.correlation, eps));
+        };
+
+        SUBCASE("double") {
+            double const eps{1e-6};
+            SUBCASE("small") { test_update(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_update(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_update(count_large, eps); } // NOLINT
+        }
+
+        SUBCASE("float") {
+            float const eps{1e-5};
+            SUBCASE("small") { test_update.operator()<float>(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_update.operator()<float>(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_update.operator()<float>(count_large, eps); } // NOLINT
+        }
+    }
+
+    TEST_CASE("serialize" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        auto test_serialize = [&]<typename T = double>(T eps) {
+            using wide = eve::wide<T>;
+            auto constexpr s{ wide::size() };
+            auto const n = count_medium - count_medium % (2 * s);
+
+            auto x = util::generate<T>(rng, n);
+            auto y = util::generate<T>(rng, n);
+            auto const u = uv::accumulate<T>(x.begin(), x.end());
+            auto const b = bv::accumulate<T>(x.begin(), x.end(), y.begin());
+
+            univariate_accumulator<wide> wa;
+            univariate_accumulator<wide> wb;
+            bivariate_accumulator<wide> ba;
+            for (std::ptrdiff_t i = 0; i < n; i += s) {
+                (i < n / 2 ? wa : wb)(x.data() + i);
+                ba(x.data() + i, y.data() + i);
+            }
+
+            // the per-lane state round-trips exactly
+            std::vector<std::byte> buffer(serialized_size(wa));
+            REQUIRE(serialize(wa, buffer) == buffer.size());
+            univariate_accumulator<wide> wc;
+            REQUIRE(merge_serialized(wc, buffer) == buffer.size());
+            auto const [sw0, sx0, sxx0] = wa.state();
+            auto const [sw1, sx1, sxx1] = wc.state();
+            REQUIRE(eve::all(sw0 == sw1 && sx0 == sx1 && sxx0 == sxx1));
+
+            // concatenated partials are merged one after the other
+            buffer.resize(serialized_size(wa) + serialized_size(wb, true));
+            auto const k = serialize(wa, buffer);
+            serialize_reduced(wb, std::span{buffer}.subspan(k));
+            univariate_accumulator<wide> wd;
+            std::span<std::byte const> bytes{buffer};
+            while (!bytes.empty()) {
+                auto const consumed = merge_serialized(wd, bytes);
+                REQUIRE(consumed > 0);
+                bytes = bytes.subspan(consumed);
+            }
+            REQUIRE(equal<T>(univariate_statistics(wd).variance, u.variance, eps));
+
+            // SIMD state into a scalar accumulator of another precision
+            univariate_accumulator<double> sd;
+            merge_serialized(sd, std::span{buffer}.first(k));
+            merge_serialized(sd, std::span{buffer}.subspan(k));
+            REQUIRE(equal<double>(univariate_statistics(sd).variance, u.variance, eps));
+
+            std::vector<std::byte> bbuf(serialized_size(ba));
+            serialize(ba, bbuf);
+            bivariate_accumulator<T> bs;
+            REQUIRE(merge_serialized(bs, bbuf) == bbuf.size());
+            REQUIRE(equal<T>(bivariate_statistics(bs).covariance, b.covariance, eps));
+            REQUIRE(equal<T>(bivariate_statistics(bs).correlation, b.correlation, eps));
+
+            // invalid data is rejected and leaves the accumulator unchanged
+            univariate_accumulator<T> e;
+            REQUIRE(merge_serialized(e, bbuf) == 0);                                // wrong kind
+            REQUIRE(merge_serialized(e, std::span{buffer}.first(k - 1)) == 0);      // truncated
+            buffer[0] = std::byte{0};
+            REQUIRE(merge_serialized(e, buffer) == 0);                              // bad magic
+            REQUIRE(univariate_statistics(e).count == 0);
+        };
+
+        SUBCASE("double") { test_serialize(1e-6); } // NOLINT
+        SUBCASE("float") { test_serialize.operator()<float>(1e-5F); } // NOLINT
+
+        SUBCASE("format") {
+            univariate_accumulator<double> acc;
+            acc(1.0);
+            acc(3.0);
+            std::array<std::byte, 16 + 3 * sizeof(double)> buffer{};
+            REQUIRE(serialize(acc, buffer) == buffer.size());
+            // header: magic, version 1, univariate, float64, 1 lane, 3 fields
+            std::array<unsigned, 12> const header{ 'V', 'S', 'T', 'A', 1, 0, 1, 2, 1, 0, 3, 0 };
+            for (auto i = 0UL; i < header.size(); ++i) {
+                REQUIRE(std::to_integer<unsigned>(buffer[i]) == header[i]);
+            }
+            // sum_w = 2.0 = 0x4000000000000000, stored little-endian
+            REQUIRE(std::to_integer<unsigned>(buffer[16 + 7]) == 0x40);
+            REQUIRE(std::to_integer<unsigned>(buffer[16]) == 0);
+        }
+    }
+
+    TEST_CASE("compensated" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+        using wide = eve::wide<float>;
+
+        // enough values for the float sums of every lane to lose several digits
+        auto constexpr n{ 1 << 22 };
+        auto x = util::generate<float>(rng, n, 100.F, 101.F);
+        auto y = util::generate<float>(rng, n, -1.F, 1.F);
+        auto const u = uv::accumulate<double>(x.begin(), x.end(), [](auto v) { return static_cast<double>(v); });
+        auto const b = bv::accumulate<double>(x.begin(), x.end(), y.begin(), [](auto v) { return static_cast<double>(v); }, [](auto v) { return static_cast<double>(v); });
+
+        auto relative = [](double a, double b) { return std::abs(a - b) / std::abs(b); };
+
+        univariate_accumulator<wide> plain;
+        univariate_accumulator<wide, compensated_summation> ca;
+        univariate_accumulator<wide, compensated_summation> cb;
+        bivariate_accumulator<wide, compensated_summation> bc;
+        univariate_accumulator<float, compensated_summation> scalar;
+        for (auto i = 0; i < n; i += wide::size()) {
+            plain(x.data() + i);
+            (i < n / 2 ? ca : cb)(x.data() + i);
+            bc(x.data() + i, y.data() + i);
+        }
+        for (auto v : x) { scalar(v); }
+        ca += cb;
+
+        auto const p = univariate_statistics(plain);
+        auto const c = univariate_statistics(ca);
+        auto const s = univariate_statistics(scalar);
+        REQUIRE(c.count == n);
+        REQUIRE(s.count == n);
+        REQUIRE(relative(c.mean, u.mean) < 1e-7);
+        REQUIRE(relative(c.variance, u.variance) < 1e-6);
+        REQUIRE(relative(s.mean, u.mean) < 1e-7);
+        REQUIRE(relative(s.variance, u.variance) < 1e-6);
+        REQUIRE(relative(c.variance, u.variance) < relative(p.variance, u.variance));
+
+        auto const bs = bivariate_statistics(bc);
+        REQUIRE(bs.count == n);
+        REQUIRE(relative(bs.mean_x, b.mean_x) < 1e-7);
+        REQUIRE(relative(bs.covariance, b.covariance) < 1e-4);
+        REQUIRE(relative(bs.correlation, b.correlation) < 1e-4);
+        REQUIRE(relative(bs.variance_y, b.variance_y) < 1e-5);
+
+        // the streaming update accepts compensated accumulators
+        univariate_accumulator<wide, compensated_summation> cu;
+        auto it = uv::update(cu, x.begin(), x.end());
+        REQUIRE(it == x.end());
+        REQUIRE(relative(univariate_statistics(cu).variance, u.variance) < 1e-6);
+    }
+
+    TEST_CASE("mixed precision" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        auto const n = count_medium + 3;
+        auto xf = util::generate<float>(rng, n, -100.F, 100.F);
+        auto wf = util::generate<float>(rng, n);
+        std::vector<std::int16_t> xs(n);
+        std::vector<std::int32_t> xi(n);
+        std::uniform_int_distribution<int> dist(-30'000, 30'000);
+        std::generate(xs.begin(), xs.end(), [&]() { return static_cast<std::int16_t>(dist(rng)); });
+        std::generate(xi.begin(), xi.end(), [&]() { return dist(rng); });
+
+        // the projection forces the lane by lane path, which must give the same results as the converting loads
+        auto widen = [](auto v) { return static_cast<double>(v); };
+        auto check = [&](auto const& x) {
+            auto const a = uv::accumulate<double>(x.begin(), x.end());
+            auto const b = uv::accumulate<double>(x.begin(), x.end(), widen);
+            REQUIRE(a.mean == b.mean);
+            REQUIRE(a.variance == b.variance);
+
+            auto const c = uv::accumulate_blocked<double>(x.begin(), x.end());
+            auto const d = uv::accumulate_blocked<double>(x.begin(), x.end(), widen);
+            REQUIRE(c.variance == d.variance);
+
+            auto const e = bv::accumulate<double>(x.begin(), x.end(), xf.begin());
+            auto const f = bv::accumulate<double>(x.begin(), x.end(), xf.begin(), widen, widen);
+            REQUIRE(e.correlation == f.correlation);
+        };
+        check(xf);
+        check(xs);
+        check(xi);
+
+        // narrow values and weights
+        auto const a = uv::accumulate<double>(xs.begin(), xs.end(), wf.begin());
+        std::vector<double> xd(xs.begin(), xs.end());
+        std::vector<double> wd(wf.begin(), wf.end());
+        auto const b = uv::accumulate<double>(xd.begin(), xd.end(), wd.begin());
+        REQUIRE(a.mean == b.mean);
+        REQUIRE(a.variance == b.variance);
+
+        // int16 values accumulated in single precision
+        auto const s = uv::accumulate<float>(xs.begin(), xs.end());
+        REQUIRE(equal(s.mean, uv::accumulate<double>(xd.begin(), xd.end()).mean, 1e-2));
+    }
+
+    TEST_CASE("skip nan" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+        auto constexpr nan{ std::numeric_limits<double>::quiet_NaN() };
+
+        auto test_skip_nan = [&]<typename T = double>(int n, T eps) {
+            auto x = util::generate<T>(rng, n);
+            auto y = util::generate<T>(rng, n);
+            auto w = util::generate<T>(rng, n);
+            std::vector<std::uint8_t> mask(n);
+            std::bernoulli_distribution hole(0.1);
+            for (auto i = 0; i < n; ++i) {
+                if (hole(rng)) { x[i] = nan; }
+                if (hole(rng)) { y[i] = nan; }
+                if (hole(rng)) { w[i] = nan; }
+                mask[i] = hole(rng) ? 0 : 1;
+            }
+
+            // reference results over the filtered data
+            auto filter = [&](auto&& keep) {
+                std::vector<T> fx;
+                std::vector<T> fy;
+                std::vector<T> fw;
+                for (auto i = 0; i < n; ++i) {
+                    if (keep(i)) { fx.push_back(x[i]); fy.push_back(y[i]); fw.push_back(w[i]); }
+                }
+                return std::tuple{ fx, fy, fw };
+            };
+            auto isnan = [](auto v) { return std::isnan(v); };
+
+            auto [ux, uy, uw] = filter([&](auto i) { return !isnan(x[i]); });
+            auto const u = uv::accumulate<T>(skip_nan, x.begin(), x.end());
+            REQUIRE(u.count == ux.size());
+            REQUIRE(u.skipped == n - ux.size());
+            REQUIRE(equal<T>(u.variance, uv::accumulate<T>(ux.begin(), ux.end()).variance, eps));
+
+            auto [wx, wy, ww] = filter([&](auto i) { return !isnan(x[i]) && !isnan(w[i]); });
+            auto const uw2 = uv::accumulate<T>(skip_nan, x.begin(), x.end(), w.begin());
+            REQUIRE(uw2.skipped == n - wx.size());
+            REQUIRE(equal<T>(uw2.mean, uv::accumulate<T>(wx.begin(), wx.end(), ww.begin()).mean, eps));
+            REQUIRE(equal<T>(uw2.variance, uv::accumulate<T>(wx.begin(), wx.end(), ww.begin()).variance, eps));
+
+            // pairwise-complete observations
+            auto [bx, by, bw] = filter([&](auto i) { return !isnan(x[i]) && !isnan(y[i]); });
+            auto const b = bv::accumulate<T>(skip_nan, x.begin(), x.end(), y.begin());
+            auto const rb = bv::accumulate<T>(bx.begin(), bx.end(), by.begin());
+            REQUIRE(b.skipped == n - bx.size());
+            REQUIRE(equal<T>(b.count, rb.count, eps));
+            REQUIRE(equal<T>(b.covariance, rb.covariance, eps));
+            REQUIRE(equal<T>(b.correlation, rb.correlation, eps));
+
+            auto [cx, cy, cw] = filter([&](auto i) { return !isnan(x[i]) && !isnan(y[i]) && !isnan(w[i]); });
+            auto const c = bv::accumulate<T>(skip_nan, x.begin(), x.end(), y.begin(), w.begin());
+            REQUIRE(c.skipped == n - cx.size());
+            REQUIRE(equal<T>(c.covariance, bv::accumulate<T>(cx.begin(), cx.end(), cy.begin(), cw.begin()).covariance, eps));
+
+            // masks, the masked methods do not look for NaNs so they are masked out as well
+            std::vector<bool> keep(n);
+            std::vector<std::uint8_t> keep8(n);
+            for (auto i = 0; i < n; ++i) {
+                keep[i] = mask[i] != 0 && !isnan(x[i]) && !isnan(w[i]);
+                keep8[i] = keep[i] ? 1 : 0;
+            }
+            auto [kx, ky, kw] = filter([&](auto i) { return keep[i]; });
+            auto const mk = uv::accumulate_masked<T>(x.begin(), x.end(), keep.begin());
+            REQUIRE(mk.count == kx.size());
+            REQUIRE(mk.skipped == n - kx.size());
+            REQUIRE(equal<T>(mk.variance, uv::accumulate<T>(kx.begin(), kx.end()).variance, eps));
+            REQUIRE(uv::accumulate_masked<T>(x.begin(), x.end(), keep8.begin()).variance == mk.variance);
+            auto const mw = uv::accumulate_masked<T>(x.begin(), x.end(), w.begin(), keep.begin());
+            REQUIRE(equal<T>(mw.mean, uv::accumulate<T>(kx.begin(), kx.end(), kw.begin()).mean, eps));
+            auto const bm = bv::accumulate_masked<T>(x.begin(), x.end(), w.begin(), keep.begin());
+            REQUIRE(equal<T>(bm.covariance, bv::accumulate<T>(kx.begin(), kx.end(), kw.begin()).covariance, eps));
+
+            // metrics
+            auto const [r2, mse] = metrics::evaluate<T, metrics::r2, metrics::mse>(skip_nan, x.begin(), x.end(), y.begin());
+            REQUIRE(equal<T>(r2, metrics::r2_score<T>(bx.begin(), bx.end(), by.begin()), eps));
+            REQUIRE(equal<T>(mse, metrics::mean_squared_error<T>(skip_nan, x.begin(), x.end(), y.begin()), eps));
+            REQUIRE(equal<T>(mse, metrics::mean_squared_error<T>(bx.begin(), bx.end(), by.begin()), eps));
+            REQUIRE(equal<T>(metrics::mean_absolute_error<T>(skip_nan, x.begin(), x.end(), y.begin(), w.begin()),
+                             metrics::mean_absolute_error<T>(cx.begin(), cx.end(), cy.begin(), cw.begin()), eps));
+            auto const [mae] = metrics::evaluate_masked<T, metrics::mae>(x.begin(), x.end(), w.begin(), keep.begin());
+            REQUIRE(equal<T>(mae, metrics::mean_absolute_error<T>(kx.begin(), kx.end(), kw.begin()), eps));
+
+            // the number of skipped pairs
+            std::size_t skipped{0};
+            auto const [r2s, mses] = metrics::evaluate<T, metrics::r2, metrics::mse>(skip_nan, x.begin(), x.end(), y.begin(), skipped);
+            REQUIRE(skipped == n - bx.size());
+            REQUIRE(mses == mse);
+            REQUIRE(metrics::mean_absolute_error<T>(skip_nan, x.begin(), x.end(), y.begin(), w.begin(), skipped) == metrics::mean_absolute_error<T>(skip_nan, x.begin(), x.end(), y.begin(), w.begin()));
+            REQUIRE(skipped == n - cx.size());
+            metrics::evaluate_masked<T, metrics::mae>(x.begin(), x.end(), w.begin(), keep.begin(), skipped);
+            REQUIRE(skipped == n - kx.size());
+            metrics::evaluate_masked<T, metrics::mae>(x.begin(), x.end(), y.begin(), w.begin(), keep.begin(), skipped);
+            REQUIRE(skipped == n - kx.size());
+            metrics::poisson_neg_likelihood_loss<T>(skip_nan, x.begin(), x.end(), y.begin(), skipped);
+            REQUIRE(skipped == n - bx.size());
+
+            // without NaNs the weighted metrics match the regular overloads
+            auto const gx = util::generate<T>(rng, n, T{0.1}, T{2});
+            auto const gy = util::generate<T>(rng, n, T{0.1}, T{2});
+            auto const gw = util::generate<T>(rng, n);
+            auto same = [&](auto&& metric, T tolerance) {
+                REQUIRE(equal<T>(metric(skip_nan, gx.begin(), gx.end(), gy.begin(), gw.begin()), metric(gx.begin(), gx.end(), gy.begin(), gw.begin()), tolerance));
+            };
+            same([](auto... args) { return metrics::r2_score<T>(args...); }, eps);
+            same([](auto... args) { return metrics::mean_squared_error<T>(args...); }, eps);
+            same([](auto... args) { return metrics::mean_squared_log_error<T>(args...); }, eps);
+            same([](auto... args) { return metrics::mean_absolute_error<T>(args...); }, eps);
+            same([](auto... args) { return metrics::mean_absolute_percentage_error<T>(args...); }, eps);
+            same([](auto... args) { return metrics::poisson_neg_likelihood_loss<T>(args...); }, eps * n);
+
+            // all the values are NaN
+            std::vector<T> z(n, nan);
+            auto const e = uv::accumulate<T>(skip_nan, z.begin(), z.end());
+            REQUIRE(e.count == 0);
+            REQUIRE(e.skipped == n);
+        };
+
+        SUBCASE("double") {
+            double const eps{1e-6};
+            SUBCASE("small") { test_skip_nan(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_skip_nan(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_skip_nan(count_large, eps); } // NOLINT
+        }
+
+        SUBCASE("float") {
+            float const eps{1e-4};
+            SUBCASE("small") { test_skip_nan.operator()<float>(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_skip_nan.operator()<float>(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_skip_nan.operator()<float>(count_large, eps); } // NOLINT
+        }
+    }
+
+    TEST_CASE("moments" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        // two-pass reference { mean, variance, skewness, kurtosis }
+        auto reference = [](auto const& x) {
+            auto const n = static_cast<double>(x.size());
+            double mean{0};
+            for (auto v : x) { mean += v; }
+            mean /= n;
+            double m2{0};
+            double m3{0};
+            double m4{0};
+            for (auto v : x) {
+                auto const d = v - mean;
+                m2 += d * d;
+                m3 += d * d * d;
+                m4 += d * d * d * d;
+            }
+            return std::array{ mean, m2 / n, std::sqrt(n) * m3 / std::pow(m2, 1.5), n * m4 / (m2 * m2) - 3 };
+        };
+
+        auto test_moments = [&]<typename T = double>(int n, T eps) {
+            // a skewed distribution with a non-zero excess kurtosis
+            auto x = util::generate<T>(rng, n);
+            std::transform(x.begin(), x.end(), x.begin(), [](auto v) { return 10 + v * v * v; });
+
+            auto const r = reference(x);
+            auto const m = uv::accumulate_moments<T>(x.begin(), x.end());
+            REQUIRE(m.count == n);
+            REQUIRE(equal<double>(m.mean, r[0], eps));
+            REQUIRE(equal<double>(m.variance, r[1], eps));
+            REQUIRE(equal<double>(m.skewness, r[2], eps));
+            REQUIRE(equal<double>(m.kurtosis, r[3], eps));
+
+            // the mean and variance agree with the regular accumulator
+            auto const u = uv::accumulate<T>(x.begin(), x.end());
+            REQUIRE(equal<double>(m.variance, u.variance, eps));
+            REQUIRE(equal<double>(m.sample_variance, u.sample_variance, eps));
+
+            // integer weights are equivalent to repeated values
+            std::vector<T> w(n);
+            std::vector<T> xr;
+            std::uniform_int_distribution<int> dist(0, 3);
+            for (auto i = 0; i < n; ++i) {
+                w[i] = static_cast<T>(dist(rng));
+                xr.insert(xr.end(), static_cast<std::size_t>(w[i]), x[i]);
+            }
+            auto const mw = uv::accumulate_moments<T>(x.begin(), x.end(), w.begin());
+            auto const mr = uv::accumulate_moments<T>(xr.begin(), xr.end());
+            REQUIRE(equal<double>(mw.count, mr.count, eps));
+            REQUIRE(equal<double>(mw.mean, mr.mean, eps));
+            REQUIRE(equal<double>(mw.variance, mr.variance, eps));
+            REQUIRE(equal<double>(mw.skewness, mr.skewness, eps));
+            REQUIRE(equal<double>(mw.kurtosis, mr.kurtosis, eps));
+
+            // merging partial accumulators gives the same result as a single pass
+            moments_accumulator<T> a;
+            moments_accumulator<T> b;
+            moments_accumulator<T> empty;
+            for (auto i = 0; i < n; ++i) { (i < n / 3 ? a : b)(x[i]); }
+            a += empty;
+            empty += b;
+            a += empty;
+            auto const s = moments_statistics(a);
+            REQUIRE(equal<double>(s.skewness, r[2], eps));
+            REQUIRE(equal<double>(s.kurtosis, r[3], eps));
+
+            vstat::parallel_policy const policy{ .threads = 4, .min_chunk_size = 64 };
+            auto const p = uv::accumulate_moments<T>(policy, x.begin(), x.end());
+            REQUIRE(p.count == n);
+            REQUIRE(equal<double>(p.skewness, r[2], eps));
+            REQUIRE(equal<double>(p.kurtosis, r[3], eps));
+        };
+
+        SUBCASE("double") {
+            double const eps{1e-6};
+            SUBCASE("small") { test_moments(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_moments(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_moments(count_large, eps); } // NOLINT
+        }
+
+        SUBCASE("float") {
+            float const eps{1e-3};
+            SUBCASE("small") { test_moments.operator()<float>(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_moments.operator()<float>(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_moments.operator()<float>(count_large, eps); } // NOLINT
+        }
+    }
+
+    TEST_CASE("extrema" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        auto test_extrema = [&]<typename T = double>(int n, T eps) {
+            auto x = util::generate<T>(rng, n);
+            auto const lo = std::ranges::min_element(x);
+            auto const hi = std::ranges::max_element(x);
+
+            auto const s = uv::accumulate<T>(with_extrema, x.begin(), x.end());
+            auto const u = uv::accumulate<T>(x.begin(), x.end());
+            REQUIRE(s.min == *lo);
+            REQUIRE(s.max == *hi);
+            REQUIRE(s.argmin == std::distance(x.begin(), lo));
+            REQUIRE(s.argmax == std::distance(x.begin(), hi));
+            REQUIRE(equal<T>(s.variance, u.variance, eps));
+            REQUIRE(std::isnan(u.min));
+            REQUIRE(u.argmin == -1);
+
+            // ties are resolved to the first position, NaNs are ignored
+            x[n - 1] = *lo;
+            x[n / 2] = *hi;
+            x[0] = std::numeric_limits<T>::quiet_NaN();
+            auto const lo2 = std::min_element(x.begin() + 1, x.end());
+            auto const hi2 = std::max_element(x.begin() + 1, x.end());
+            auto const t = uv::accumulate<T>(with_extrema, x.begin(), x.end());
+            REQUIRE(t.min == *lo2);
+            REQUIRE(t.max == *hi2);
+            REQUIRE(t.argmin == std::distance(x.begin(), lo2));
+            REQUIRE(t.argmax == std::distance(x.begin(), hi2));
+
+            vstat::parallel_policy const policy{ .threads = 4, .min_chunk_size = 64 };
+            auto const p = uv::accumulate<T>(policy, with_extrema, x.begin(), x.end());
+            REQUIRE(p.min == t.min);
+            REQUIRE(p.max == t.max);
+            REQUIRE(p.argmin == t.argmin);
+            REQUIRE(p.argmax == t.argmax);
+
+            // merging accumulators concatenates the sequences
+            extrema_accumulator<T> a;
+            extrema_accumulator<T> b;
+            for (auto i = 0; i < n; ++i) { (i < n / 3 ? a : b)(x[i]); }
+            a += b;
+            auto const [count, mn, mx, argmin, argmax] = a.stats();
+            REQUIRE(count == n);
+            REQUIRE(argmin == t.argmin);
+            REQUIRE(argmax == t.argmax);
+
+            // all NaN
+            std::vector<T> z(n, std::numeric_limits<T>::quiet_NaN());
+            auto const e = uv::accumulate<T>(with_extrema, z.begin(), z.end());
+            REQUIRE(std::isnan(e.min));
+            REQUIRE(e.argmax == -1);
+
+            // fewer values than SIMD lanes (only the scalar tail is used)
+            auto const k = std::min<std::ptrdiff_t>(n - 1, std::max<std::ptrdiff_t>(1, eve::wide<T>::size() - 1));
+            auto const lo3 = std::min_element(x.begin() + 1, x.begin() + k + 1);
+            auto const hi3 = std::max_element(x.begin() + 1, x.begin() + k + 1);
+            auto const r = uv::accumulate<T>(with_extrema, x.begin() + 1, x.begin() + k + 1);
+            REQUIRE(r.min == *lo3);
+            REQUIRE(r.max == *hi3);
+            REQUIRE(r.argmin == std::distance(x.begin() + 1, lo3));
+            REQUIRE(r.argmax == std::distance(x.begin() + 1, hi3));
+
+            // the leading blocks and chunks are all NaN
+            std::fill(x.begin(), x.begin() + n / 2, std::numeric_limits<T>::quiet_NaN());
+            auto const lo4 = std::min_element(x.begin() + n / 2, x.end());
+            auto const hi4 = std::max_element(x.begin() + n / 2, x.end());
+            for (auto const& q : { uv::accumulate<T>(with_extrema, x.begin(), x.end()), uv::accumulate<T>(policy, with_extrema, x.begin(), x.end()) }) {
+                REQUIRE(q.min == *lo4);
+                REQUIRE(q.max == *hi4);
+                REQUIRE(q.argmin == std::distance(x.begin(), lo4));
+                REQUIRE(q.argmax == std::distance(x.begin(), hi4));
+            }
+
+            // all the values are infinite
+            for (auto const v : { std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity() }) {
+                std::vector<T> inf(n, v);
+                auto const q = uv::accumulate<T>(with_extrema, inf.begin(), inf.end());
+                REQUIRE(q.min == v);
+                REQUIRE(q.max == v);
+                REQUIRE(q.argmin == 0);
+                REQUIRE(q.argmax == 0);
+            }
+        };
+
+        SUBCASE("double") {
+            double const eps{1e-6};
+            SUBCASE("small") { test_extrema(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_extrema(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_extrema(count_large, eps); } // NOLINT
+        }
+
+        SUBCASE("float") {
+            float const eps{1e-5};
+            SUBCASE("small") { test_extrema.operator()<float>(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_extrema.operator()<float>(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_extrema.operator()<float>(count_large, eps); } // NOLINT
+        }
+    }
+
+    TEST_CASE("quantile sketch" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        // the exact quantile with the definition of the sketch (the smallest value with rank >= q * n)
+        auto exact = [](auto x, double q) {
+            auto const n = static_cast<std::ptrdiff_t>(x.size());
+            auto const i = std::clamp<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(std::ceil(q * static_cast<double>(n))) - 1, 0, n - 1);
+            std::nth_element(x.begin(), x.begin() + i, x.end());
+            return static_cast<double>(x[i]);
+        };
+        auto constexpr qs = std::array{ 0.0, 0.01, 0.25, 0.5, 0.75, 0.95, 0.99, 1.0 };
+
+        auto test_sketch = [&]<typename T = double>(int n) {
+            auto x = util::generate<T>(rng, n, T{0}, T{100});
+
+            quantile_sketch<T> sketch;
+            auto const stats = uv::accumulate<T>(sketch, x.begin(), x.end());
+            REQUIRE(sketch.count() == n);
+            REQUIRE(equal<T>(stats.mean, uv::accumulate<T>(x.begin(), x.end()).mean, T{1e-3}));
+
+            // the rank of the estimate is within the error bound of the sketch (exact below its capacity)
+            auto const tolerance = n <= static_cast<int>(quantile_sketch<T>::default_k) ? 0.0 : 0.02;
+            auto const estimates = sketch.quantiles(qs);
+            std::vector<T> sorted(x);
+            std::ranges::sort(sorted);
+            for (std::size_t i = 0; i < qs.size(); ++i) {
+                if (tolerance == 0) {
+                    REQUIRE(estimates[i] == exact(x, qs[i]));
+                } else {
+                    auto const r = static_cast<double>(std::ranges::upper_bound(sorted, static_cast<T>(estimates[i])) - sorted.begin()) / n;
+                    REQUIRE(std::abs(r - qs[i]) < tolerance);
+                }
+            }
+            REQUIRE(sketch.quantile(0) == sorted.front());
+            REQUIRE(sketch.quantile(1) == sorted.back());
+            auto const median_rank = static_cast<double>(std::ranges::upper_bound(sorted, T{50}) - sorted.begin()) / n;
+            REQUIRE(std::abs(sketch.rank(50) - median_rank) <= tolerance);
+
+            // merging sketches of the parts
+            quantile_sketch<T> a;
+            quantile_sketch<T> b;
+            uv::accumulate<T>(a, x.begin(), x.begin() + n / 3);
+            uv::accumulate<T>(b, x.begin() + n / 3, x.end());
+            a += b;
+            REQUIRE(a.count() == n);
+            REQUIRE(std::abs(a.rank(a.quantile(0.95)) - 0.95) < 0.02 + 1.0 / n);
+
+            // serialization round trip
+            std::vector<std::byte> buffer(serialized_size(sketch));
+            REQUIRE(serialize(sketch, buffer) == buffer.size());
+            quantile_sketch<T> restored;
+            REQUIRE(merge_serialized(restored, buffer) == buffer.size());
+            REQUIRE(restored.count() == sketch.count());
+            REQUIRE(restored.quantiles(qs) == estimates);
+            REQUIRE(merge_serialized(restored, std::span<std::byte const>(buffer).first(buffer.size() - 1)) == 0);
+            REQUIRE(restored.count() == sketch.count());
+
+            // the memory is bounded
+            std::size_t items{0};
+            for (auto const& level : sketch.levels()) { items += level.size(); }
+            REQUIRE(items <= 5 * quantile_sketch<T>::default_k);
+
+            // NaNs are ignored
+            quantile_sketch<T> c;
+            x[0] = std::numeric_limits<T>::quiet_NaN();
+            uv::accumulate<T>(c, x.begin(), x.end());
+            REQUIRE(c.count() == n - 1);
+        };
+
+        SUBCASE("double") {
+            SUBCASE("small") { test_sketch(count_small); } // NOLINT
+            SUBCASE("medium") { test_sketch(count_medium); } // NOLINT
+            SUBCASE("large") { test_sketch(count_large); } // NOLINT
+        }
+
+        SUBCASE("float") {
+            SUBCASE("small") { test_sketch.operator()<float>(count_small); } // NOLINT
+            SUBCASE("medium") { test_sketch.operator()<float>(count_medium); } // NOLINT
+            SUBCASE("large") { test_sketch.operator()<float>(count_large); } // NOLINT
+        }
+    }
+
+    TEST_CASE("histogram" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        // the reference assigns the values by a binary search over the bin edges
+        auto reference = []<typename T>(std::vector<T> const& x, histogram_bins const& bins) {
+            auto const edges = bins.edges();
+            std::vector<std::uint64_t> counts(bins.count + 3, 0); // bins, underflow, overflow, NaN
+            for (auto v : x) {
+                auto const d = static_cast<double>(v);
+                if (std::isnan(d)) {
+                    ++counts[bins.count + 2];
+                } else if (d < edges.front()) {
+                    ++counts[bins.count];
+                } else if (d > edges.back()) {
+                    ++counts[bins.count + 1];
+                } else {
+                    auto const b = std::ranges::upper_bound(edges, d) - edges.begin() - 1;
+                    ++counts[std::min<std::size_t>(b, bins.count - 1)];
+                }
+            }
+            return counts;
+        };
+
+        auto test_histogram = [&]<typename T = double>(int n, histogram_bins const& bins) {
+            auto x = util::generate<T>(rng, n, T{-10}, T{110});
+            x[0] = std::numeric_limits<T>::quiet_NaN();
+            x[1] = static_cast<T>(bins.max);
+            x[2] = static_cast<T>(bins.min);
+            x[3] = -std::numeric_limits<T>::infinity();
+            x[4] = std::numeric_limits<T>::infinity();
+
+            histogram_accumulator<T> hist(bins);
+            auto const stats = uv::accumulate<T>(hist, x.begin(), x.end());
+            REQUIRE(std::isnan(stats.mean));
+            REQUIRE(hist.total() == n);
+
+            auto const expected = reference(x, bins);
+            auto const counts = hist.counts();
+            REQUIRE(hist.nan_count() == expected[bins.count + 2]);
+            // values on a bin edge may fall into the neighbouring bin due to rounding
+            std::uint64_t diff{0};
+            for (std::size_t b = 0; b < bins.count; ++b) {
+                diff += counts[b] > expected[b] ? counts[b] - expected[b] : expected[b] - counts[b];
+            }
+            diff += hist.underflow() > expected[bins.count] ? hist.underflow() - expected[bins.count] : expected[bins.count] - hist.underflow();
+            diff += hist.overflow() > expected[bins.count + 1] ? hist.overflow() - expected[bins.count + 1] : expected[bins.count + 1] - hist.overflow();
+            REQUIRE(diff <= 2 * static_cast<std::uint64_t>(n / 10'000 + 1));
+
+            // the upper edge belongs to the last bin
+            histogram_accumulator<T> edges(bins);
+            edges(static_cast<T>(bins.max));
+            edges(static_cast<T>(bins.min));
+            REQUIRE(edges.counts().back() == 1);
+            REQUIRE(edges.counts().front() == 1);
+
+            // merging the histograms of the parts, also across threads
+            histogram_accumulator<T> a(bins);
+            histogram_accumulator<T> b(bins);
+            uv::accumulate<T>(a, x.begin(), x.begin() + n / 3);
+            uv::accumulate<T>(b, x.begin() + n / 3, x.end());
+            a += b;
+            REQUIRE(a.counts() == counts);
+            REQUIRE(a.underflow() == hist.underflow());
+            REQUIRE(a.overflow() == hist.overflow());
+
+            histogram_accumulator<T> p(bins);
+            uv::accumulate<T>(parallel_policy{ .threads = 4, .min_chunk_size = 1000 }, p, x.begin(), x.end());
+            REQUIRE(p.counts() == counts);
+            REQUIRE(p.nan_count() == 1);
+        };
+
+        auto const uniform = histogram_bins::uniform(0, 100, 16);
+        auto const log = histogram_bins::log(1, 100, 20);
+
+        SUBCASE("double") {
+            SUBCASE("small") { test_histogram(count_small, uniform); test_histogram(count_small, log); } // NOLINT
+            SUBCASE("medium") { test_histogram(count_medium, uniform); test_histogram(count_medium, log); } // NOLINT
+            SUBCASE("large") { test_histogram(count_large, uniform); test_histogram(count_large, log); } // NOLINT
+        }
+
+        SUBCASE("float") {
+            SUBCASE("small") { test_histogram.operator()<float>(count_small, uniform); test_histogram.operator()<float>(count_small, log); } // NOLINT
+            SUBCASE("medium") { test_histogram.operator()<float>(count_medium, uniform); test_histogram.operator()<float>(count_medium, log); } // NOLINT
+            SUBCASE("large") { test_histogram.operator()<float>(count_large, uniform); test_histogram.operator()<float>(count_large, log); } // NOLINT
+        }
+    }
+
+    TEST_CASE("ewma" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        auto test_ewma = [&]<typename T = double>(int n, double alpha, T eps) {
+            // a random walk, so that the mean drifts away from the first sample
+            auto x = util::generate<T>(rng, n, T{-1}, T{1});
+            for (auto i = 1; i < n; ++i) { x[i] += x[i - 1]; }
+
+            // the scalar recurrence in double precision
+            std::vector<double> mean(n);
+            std::vector<double> variance(n);
+            double mu{x[0]};
+            double var{0};
+            for (auto i = 0; i < n; ++i) {
+                auto const d = static_cast<double>(x[i]) - mu;
+                mu += alpha * d;
+                var = (1 - alpha) * (var + alpha * d * d);
+                mean[i] = mu;
+                variance[i] = var;
+            }
+
+            ewma_accumulator<T> acc(alpha);
+            uv::update(acc, x.begin(), x.end());
+            REQUIRE(acc.count() == n);
+            REQUIRE(equal(acc.mean(), mu, static_cast<double>(eps)));
+            REQUIRE(equal(acc.variance(), var, static_cast<double>(eps)));
+
+            // the series, written in two batches to check the continuation
+            std::vector<T> m(n);
+            std::vector<T> v(n);
+            ewma_accumulator<T> series(alpha);
+            auto [mo, vo] = uv::update(series, x.begin(), x.begin() + n / 3, m.begin(), v.begin());
+            uv::update(series, x.begin() + n / 3, x.end(), mo, vo);
+            for (auto i = 0; i < n; ++i) {
+                REQUIRE(equal<double>(m[i], mean[i], eps));
+                REQUIRE(equal<double>(v[i], variance[i], eps));
+            }
+            REQUIRE(equal(series.mean(), acc.mean(), static_cast<double>(eps)));
+
+            // the scalar updates give the same result
+            ewma_accumulator<T> scalar(alpha);
+            for (auto v : x) { scalar(v); }
+            REQUIRE(equal(scalar.mean(), mu, static_cast<double>(eps)));
+            REQUIRE(equal(scalar.variance(), var, static_cast<double>(eps)));
+
+            // the state can be restored
+            auto restored = ewma_accumulator<T>::load_state(alpha, acc.count(), static_cast<T>(acc.mean()), static_cast<T>(acc.variance()));
+            restored(x.back());
+            acc(x.back());
+            REQUIRE(equal(restored.mean(), acc.mean(), static_cast<double>(eps)));
+        };
+
+        SUBCASE("half life") {
+            auto acc = ewma_accumulator<double>::from_half_life(10);
+            REQUIRE(equal(std::pow(1 - acc.alpha(), 10), 0.5, 1e-12));
+            REQUIRE(std::isnan(acc.mean()));
+        }
+
+        SUBCASE("double") {
+            for (auto alpha : { 0.01, 0.3, 1.0 }) {
+                test_ewma(count_small, alpha, 1e-9);
+                test_ewma(count_medium, alpha, 1e-9);
+                test_ewma(count_large, alpha, 1e-9);
+            }
+        }
+
+        SUBCASE("float") {
+            for (auto alpha : { 0.01, 0.3 }) {
+                test_ewma.operator()<float>(count_small, alpha, 1e-2F);
+                test_ewma.operator()<float>(count_medium, alpha, 1e-1F);
+            }
+        }
+    }
+
+    TEST_CASE("rolling" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        auto test_rolling = [&]<typename T = double>(int n, int window, T eps) {
+            // an offset series, so that the cancellation in the updates is visible
+            auto x = util::generate<T>(rng, n, T{1000}, T{1010});
+            auto y = util::generate<T>(rng, n, T{-1}, T{1});
+            for (auto i = 0; i < n; ++i) { y[i] += x[i] / 1000; }
+
+            std::vector<T> mean(n);
+            std::vector<T> variance(n);
+            std::vector<T> covariance(n);
+            std::vector<T> correlation(n);
+            auto [m, v] = uv::rolling<T>(x.begin(), x.end(), window, mean.begin(), variance.begin());
+            REQUIRE(m == mean.end());
+            REQUIRE(v == variance.end());
+            bv::rolling<T>(x.begin(), x.end(), y.begin(), window, covariance.begin(), correlation.begin());
+
+            auto const w = std::min(window, n + 1);
+            for (auto i = 0; i < w - 1 && i < n; ++i) {
+                REQUIRE(std::isnan(mean[i]));
+                REQUIRE(std::isnan(covariance[i]));
+            }
+            for (auto i = window - 1; i < n; ++i) {
+                // the window ending at i, computed from scratch
+                auto const u = uv::accumulate<double>(x.begin() + (i + 1 - window), x.begin() + i + 1, [](auto v) { return static_cast<double>(v); });
+                auto const b = bv::accumulate<double>(x.begin() + (i + 1 - window), x.begin() + i + 1, y.begin() + (i + 1 - window),
+                    [](auto v) { return static_cast<double>(v); }, [](auto v) { return static_cast<double>(v); });
+                REQUIRE(equal<double>(mean[i], u.mean, eps * 1000));
+                REQUIRE(equal<double>(variance[i], u.variance, eps));
+                REQUIRE(equal<double>(covariance[i], b.covariance, eps));
+                if (window > 1) { REQUIRE(equal<double>(correlation[i], b.correlation, eps * 100)); }
+            }
+        };
+
+        SUBCASE("double") {
+            for (auto window : { 1, 3, 10, 100 }) {
+                test_rolling(count_small, window, 1e-9);
+                test_rolling(count_medium, window, 1e-9);
+                test_rolling(count_large, window, 1e-9);
+            }
+        }
+
+        SUBCASE("float") {
+            for (auto window : { 3, 10, 100 }) {
+                test_rolling.operator()<float>(count_medium, window, 1e-1F);
+            }
+        }
+
+        SUBCASE("nan") {
+            auto x = util::generate<double>(rng, count_medium);
+            x[500] = std::numeric_limits<double>::quiet_NaN();
+            std::vector<double> mean(x.size());
+            std::vector<double> variance(x.size());
+            uv::rolling<double>(x.begin(), x.end(), 10, mean.begin(), variance.begin());
+            for (auto i = 9; i < count_medium; ++i) {
+                REQUIRE(std::isnan(mean[i]) == (i >= 500 && i < 510));
+            }
+            REQUIRE(equal(mean.back(), uv::accumulate<double>(x.end() - 10, x.end()).mean, 1e-12));
+        }
+    }
+
+    TEST_CASE("grouped" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        auto test_grouped = [&]<typename T = double>(int n, std::size_t groups, bool sorted, T eps) {
+            auto x = util::generate<T>(rng, n, T{-10}, T{10});
+            auto y = util::generate<T>(rng, n, T{-10}, T{10});
+            std::uniform_int_distribution<std::int64_t> dist(-1, static_cast<std::int64_t>(groups)); // includes invalid keys
+            std::vector<std::int64_t> keys(n);
+            std::ranges::generate(keys, [&]() { return dist(rng); });
+            if (sorted) { std::ranges::sort(keys); }
+
+            auto const table = gr::accumulate<T>(x.begin(), x.end(), keys.begin(), groups);
+            auto const pairs = gr::accumulate<T>(x.begin(), x.end(), y.begin(), keys.begin(), groups);
+            auto const parallel = gr::accumulate<T>(parallel_policy{ .threads = 4, .min_chunk_size = 100 }, x.begin(), x.end(), keys.begin(), groups);
+            REQUIRE(table.size() == groups);
+            REQUIRE(!table.bivariate());
+            REQUIRE(pairs.bivariate());
+
+            // the values of each group, accumulated separately
+            std::vector<std::vector<T>> xs(groups);
+            std::vector<std::vector<T>> ys(groups);
+            std::size_t skipped{0};
+            for (auto i = 0; i < n; ++i) {
+                if (keys[i] < 0 || keys[i] >= static_cast<std::int64_t>(groups)) { ++skipped; continue; }
+                xs[keys[i]].push_back(x[i]);
+                ys[keys[i]].push_back(y[i]);
+            }
+            REQUIRE(table.skipped == skipped);
+            REQUIRE(pairs.skipped == skipped);
+            REQUIRE(parallel.skipped == skipped);
+
+            for (std::size_t g = 0; g < groups; ++g) {
+                REQUIRE(table.sum_w[g] == static_cast<double>(xs[g].size()));
+                REQUIRE(parallel.sum_w[g] == static_cast<double>(xs[g].size()));
+                if (xs[g].empty()) {
+                    REQUIRE(std::isnan(table.mean(g)));
+                    continue;
+                }
+                auto const u = uv::accumulate<T>(xs[g].begin(), xs[g].end());
+                auto const b = bv::accumulate<T>(xs[g].begin(), xs[g].end(), ys[g].begin());
+                REQUIRE(equal<double>(table.mean(g), u.mean, eps));
+                REQUIRE(equal<double>(table.variance(g), u.variance, eps));
+                REQUIRE(equal<double>(parallel.mean(g), u.mean, eps));
+                REQUIRE(equal<double>(parallel.variance(g), u.variance, eps));
+                REQUIRE(equal<double>(pairs.variance(g), u.variance, eps));
+                REQUIRE(equal<double>(pairs.covariance(g), b.covariance, eps));
+                REQUIRE(equal<double>(pairs.correlation(g), b.correlation, eps));
+            }
+        };
+
+        SUBCASE("double") {
+            for (auto sorted : { true, false }) {
+                test_grouped(count_small, 3, sorted, 1e-9);
+                test_grouped(count_medium, 10, sorted, 1e-9);
+                test_grouped(count_large, 10, sorted, 1e-9);
+                test_grouped(count_large, 1000, sorted, 1e-9);
+            }
+        }
+
+        SUBCASE("float") {
+            for (auto sorted : { true, false }) {
+                test_grouped.operator()<float>(count_medium, 10, sorted, 1e-2F);
+                test_grouped.operator()<float>(count_large, 1000, sorted, 1e-2F);
+            }
+        }
+    }
+
+#if defined(VSTAT_DISPATCH)
+    TEST_CASE("dispatch" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+        namespace vd = vstat::dispatch;
+        namespace mt = vstat::metrics;
+
+        auto test_dispatch = [&]<typename T = double>(int n, T eps) {
+            auto x = util::generate<T>(rng, n, T{1}, T{2});
+            auto y = util::generate<T>(rng, n, T{1}, T{2});
+            auto w = util::generate<T>(rng, n);
+            auto const* px = x.data();
+            auto const* py = y.data();
+            auto const* pw = w.data();
+
+            auto const active = vd::active_isa();
+            REQUIRE(vd::available(vd::isa::generic));
+            for (auto level : { vd::isa::generic, vd::isa::sse4_2, vd::isa::avx2, vd::isa::avx512 }) {
+                if (!vd::set_isa(level)) {
+                    continue;
+                }
+                std::string const name{ vd::isa_name(level) };
+                CAPTURE(name);
+                REQUIRE(equal<T>(vd::univariate::accumulate(px, px + n).variance, uv::accumulate<T>(px, px + n).variance, eps));
+                REQUIRE(equal<T>(vd::univariate::accumulate(px, px + n, pw).variance, uv::accumulate<T>(px, px + n, pw).variance, eps));
+
+                auto const e = vd::univariate::accumulate(vstat::with_extrema, px, px + n);
+                auto const f = uv::accumulate<T>(vstat::with_extrema, px, px + n);
+                REQUIRE(e.min == f.min);
+                REQUIRE(e.argmax == f.argmax);
+
+                REQUIRE(equal<T>(vd::bivariate::accumulate(px, px + n, py).correlation, bv::accumulate<T>(px, px + n, py).correlation, eps));
+                REQUIRE(equal<T>(vd::bivariate::accumulate(px, px + n, py, pw).covariance, bv::accumulate<T>(px, px + n, py, pw).covariance, eps));
+
+                REQUIRE(equal<T>(vd::metrics::r2_score(px, px + n, py), mt::r2_score<T>(px, px + n, py), eps));
+                REQUIRE(equal<T>(vd::metrics::mean_squared_log_error(px, px + n, py, pw), mt::mean_squared_log_error<T>(px, px + n, py, pw), eps));
+                REQUIRE(equal<T>(vd::metrics::poisson_neg_likelihood_loss(px, px + n, py), mt::poisson_neg_likelihood_loss<T>(px, px + n, py), eps));
+
+                // the weighted metrics match the header-only functions (the Poisson predictions are scaled by the weights)
+                REQUIRE(equal<T>(vd::metrics::r2_score(px, px + n, py, pw), mt::r2_score<T>(px, px + n, py, pw), eps));
+                REQUIRE(equal<T>(vd::metrics::mean_squared_error(px, px + n, py, pw), mt::mean_squared_error<T>(px, px + n, py, pw), eps));
+                REQUIRE(equal<T>(vd::metrics::mean_absolute_error(px, px + n, py, pw), mt::mean_absolute_error<T>(px, px + n, py, pw), eps));
+                REQUIRE(equal<T>(vd::metrics::mean_absolute_percentage_error(px, px + n, py, pw), mt::mean_absolute_percentage_error<T>(px, px + n, py, pw), eps));
+                REQUIRE(equal<T>(vd::metrics::poisson_neg_likelihood_loss(px, px + n, py, pw), mt::poisson_neg_likelihood_loss<T>(px, px + n, py, pw), eps * n));
+            }
+            REQUIRE(vd::set_isa(active));
+        };
+
+        SUBCASE("double") {
+            test_dispatch(count_medium, 1e-6);
+        }
+
+        SUBCASE("float") {
+            test_dispatch.operator()<float>(count_medium, 1e-4F);
+        }
+    }
+#endif
+
+#if defined(VSTAT_PRECOMPILED_KERNELS)
+    TEST_CASE("kernels" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+        namespace vk = vstat::kernels;
+        namespace mt = vstat::metrics;
+
+        auto test_kernels = [&]<typename T = double>(int n, T eps) {
+            auto x = util::generate<T>(rng, n, T{1}, T{2});
+            auto y = util::generate<T>(rng, n, T{1}, T{2});
+            auto w = util::generate<T>(rng, n);
+            x[n / 2] = std::numeric_limits<T>::quiet_NaN();
+            std::span<T const> const sx{x};
+            std::span<T const> const sy{y};
+            std::span<T const> const sw{w};
+
+            // the kernels must match the header-only methods for pointers and span iterators alike
+            auto const u1 = uv::accumulate<T>(vstat::skip_nan, x.begin(), x.end(), w.begin());
+            REQUIRE(equal<T>(vk::univariate::accumulate<T>(vstat::skip_nan, x.data(), x.data() + n, w.data()).variance, u1.variance, eps));
+            REQUIRE(equal<T>(vk::univariate::accumulate<T>(vstat::skip_nan, sx.begin(), sx.end(), sw.begin()).variance, u1.variance, eps));
+            REQUIRE(std::isnan(vk::univariate::accumulate<T>(sx.begin(), sx.end()).mean));
+
+            auto const e = vk::univariate::accumulate<T>(vstat::with_extrema, sy.begin(), sy.end());
+            auto const f = uv::accumulate<T>(vstat::with_extrema, y.begin(), y.end());
+            REQUIRE(e.max == f.max);
+            REQUIRE(e.argmin == f.argmin);
+
+            auto const b1 = bv::accumulate<T>(vstat::skip_nan, x.begin(), x.end(), y.begin(), w.begin());
+            REQUIRE(equal<T>(vk::bivariate::accumulate<T>(vstat::skip_nan, sx.begin(), sx.end(), sy.begin(), sw.begin()).correlation, b1.correlation, eps));
+            REQUIRE(equal<T>(vk::bivariate::accumulate<T>(y.data(), y.data() + n, w.data()).covariance, bv::accumulate<T>(y.begin(), y.end(), w.begin()).covariance, eps));
+
+            REQUIRE(equal<T>(vk::metrics::r2_score<T>(sy.begin(), sy.end(), sw.begin()), mt::r2_score<T>(y.begin(), y.end(), w.begin()), eps));
+            REQUIRE(equal<T>(vk::metrics::mean_absolute_error<T>(w.data(), w.data() + n, y.data(), y.data()), mt::mean_absolute_error<T>(w.begin(), w.end(), y.begin(), y.begin()), eps));
+        };
+
+        SUBCASE("double") {
+            test_kernels(count_medium, 1e-6);
+        }
+
+        SUBCASE("float") {
+            test_kernels.operator()<float>(count_medium, 1e-4F);
+        }
+    }
+#endif
+
+    TEST_CASE("csv" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        auto test_csv = [&]<typename T = double>(int n, T eps) {
+            auto x = util::generate<T>(rng, n);
+            auto y = util::generate<T>(rng, n, T{-1}, T{1});
+
+            // every 7th x is missing and every 5th y is not a number, the text column is never parsed as a value
+            std::vector<T> xs;
+            std::vector<T> xp;
+            std::vector<T> yp;
+            std::ostringstream text;
+            text << std::setprecision(std::numeric_limits<T>::max_digits10);
+            text << "\"id\",\"x, \"\"raw\"\"\",y,label\r\n";
+            for (auto i = 0; i < n; ++i) {
+                text << i << ',';
+                if (i % 7 != 0) {
+                    text << ' ' << x[i] << ' ';
+                    xs.push_back(x[i]);
+                }
+                text << ',';
+                if (i % 5 == 0) {
+                    text << "n/a";
+                } else {
+                    text << '+' << y[i];
+                }
+                text << ",\"a,b\"" << (i % 2 == 0 ? "\r\n" : "\n");
+                if (i % 7 != 0 && i % 5 != 0) {
+                    xp.push_back(x[i]);
+                    yp.push_back(y[i]);
+                }
+                if (i == n / 2) {
+                    text << "\n"; // empty lines are ignored
+                }
+            }
+            auto const data = text.str();
+
+            auto const sx = uv::accumulate<T>(xs.begin(), xs.end());
+            auto const sxy = bv::accumulate<T>(xp.begin(), xp.end(), yp.begin());
+
+            // small blocks, so that the lines span several blocks
+            for (auto block_size : { std::size_t{1}, std::size_t{64}, std::size_t{1} << 22U }) {
+                CAPTURE(block_size);
+                vstat::csv_options const options{ .block_size = block_size };
+
+                std::istringstream in1(data);
+                std::vector<std::string> const columns{ "x, \"raw\"" };
+                std::vector<std::pair<std::string, std::string>> const pairs{ { "x, \"raw\"", "y" } };
+                auto const r1 = vstat::csv::accumulate<T>(in1, columns, pairs, options);
+                std::vector<std::string> const names{ "id", "x, \"raw\"", "y", "label" };
+                REQUIRE(r1.names == names);
+                REQUIRE(r1.rows == static_cast<std::size_t>(n));
+                REQUIRE(r1.univariate.size() == 1);
+                REQUIRE(r1.univariate[0].count == static_cast<double>(xs.size()));
+                REQUIRE(r1.univariate[0].skipped == n - xs.size());
+                REQUIRE(equal<T>(r1.univariate[0].mean, sx.mean, eps));
+                REQUIRE(equal<T>(r1.univariate[0].variance, sx.variance, eps));
+                REQUIRE(r1.bivariate[0].count == static_cast<double>(xp.size()));
+                REQUIRE(equal<T>(r1.bivariate[0].covariance, sxy.covariance, eps));
+                REQUIRE(equal<T>(r1.bivariate[0].correlation, sxy.correlation, eps));
+
+                std::istringstream in2(data);
+                auto const r2 = vstat::csv::accumulate<T>(in2, options);
+                REQUIRE(r2.univariate.size() == 4);
+                REQUIRE(r2.univariate[0].count == n);
+                REQUIRE(equal<T>(r2.univariate[1].variance, sx.variance, eps));
+                REQUIRE(r2.univariate[3].count == 0);
+                REQUIRE(r2.univariate[3].skipped == static_cast<std::size_t>(n));
+            }
+
+            // without a header and with another delimiter, the first line holds values
+            std::istringstream in3("1;2\n3;4\n5");
+            std::vector<std::size_t> const columns{ 1, 0 };
+            auto const r3 = vstat::csv::accumulate<T>(in3, columns, {}, { .delimiter = ';', .header = false });
+            REQUIRE(r3.names.empty());
+            REQUIRE(r3.rows == 3);
+            REQUIRE(r3.univariate[0].count == 2);
+            REQUIRE(r3.univariate[0].mean == 3);
+            REQUIRE(r3.univariate[0].skipped == 1);
+            REQUIRE(r3.univariate[1].mean == 3);
+
+            std::istringstream in4(data);
+            std::vector<std::string> const unknown{ "z" };
+            REQUIRE_THROWS_AS(vstat::csv::accumulate<T>(in4, unknown), std::invalid_argument);
+        };
+
+        SUBCASE("double") {
+            test_csv(count_medium, 1e-6);
+        }
+
+        SUBCASE("float") {
+            test_csv.operator()<float>(count_medium, 1e-4F);
+        }
+    }
+
+    TEST_CASE("mapped" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+        auto const path = std::filesystem::temp_directory_path() / "vstat_test_mapped.bin";
+
+        auto test_mapped = [&]<typename T = double>(int rows, T eps) {
+            // a header of 16 bytes followed by two columns in column-major order
+            auto x = util::generate<T>(rng, rows);
+            auto y = util::generate<T>(rng, rows);
+            {
+                std::ofstream out(path, std::ios::binary);
+                std::array<char, 16> const header{};
+                out.write(header.data(), header.size());
+                out.write(reinterpret_cast<char const*>(x.data()), static_cast<std::streamsize>(rows * sizeof(T))); // NOLINT
+                out.write(reinterpret_cast<char const*>(y.data()), static_cast<std::streamsize>(rows * sizeof(T))); // NOLINT
+            }
+
+            vstat::mapped_file const file(path);
+            REQUIRE(file.size() == 16 + 2 * rows * sizeof(T));
+            REQUIRE(file.values<T>(16).size() == 2 * static_cast<std::size_t>(rows));
+
+            auto const cx = file.column<T>(0, rows, 16);
+            auto const cy = file.column<T>(1, rows, 16);
+            REQUIRE(std::equal(cx.begin(), cx.end(), x.begin()));
+            REQUIRE(std::equal(cy.begin(), cy.end(), y.begin()));
+
+            vstat::parallel_policy const policy{ .threads = 4, .min_chunk_size = 1024 };
+            auto const s1 = uv::accumulate<T>(x.begin(), x.end());
+            REQUIRE(s1.variance == uv::accumulate<T>(cx.begin(), cx.end()).variance);
+            REQUIRE(equal<T>(s1.variance, uv::accumulate<T>(policy, cx.begin(), cx.end()).variance, eps));
+
+            auto const s2 = bv::accumulate<T>(x.begin(), x.end(), y.begin());
+            REQUIRE(equal<T>(s2.covariance, bv::accumulate<T>(policy, cx.begin(), cx.end(), cy.begin()).covariance, eps));
+
+            // the mapping outlives the move and the hints do not change the contents
+            vstat::mapped_file moved{ vstat::mapped_file(path, { .sequential = false, .huge_pages = false, .populate = true }) };
+            REQUIRE(std::equal(file.bytes().begin(), file.bytes().end(), moved.bytes().begin(), moved.bytes().end()));
+        };
+
+        SUBCASE("double") {
+            test_mapped(4 * count_large, 1e-6); // larger than a huge page
+        }
+
+        SUBCASE("float") {
+            test_mapped.operator()<float>(count_large, 1e-4F);
+        }
+
+        SUBCASE("empty") {
+            std::ofstream{ path, std::ios::binary };
+            vstat::mapped_file const file(path);
+            REQUIRE(file.empty());
+            REQUIRE(file.values<double>().empty());
+        }
+
+        SUBCASE("missing") {
+            std::filesystem::remove(path);
+            REQUIRE_THROWS_AS(vstat::mapped_file{ path }, std::system_error);
+        }
+        std::filesystem::remove(path);
+    }
+
+    TEST_CASE("parallel" * dt::test_suite("[correctness]")) {
+        std::default_random_engine rng{1234};
+
+        auto test_parallel = [&]<typename T = double>(int n, T eps) {
+            auto x = util::generate<T>(rng, n);
+            auto y = util::generate<T>(rng, n);
+            auto w = util::generate<T>(rng, n);
+
+            vstat::parallel_policy const policy{ .threads = 4, .min_chunk_size = 64 };
+
+            auto const s1 = uv::accumulate<T>(x.begin(), x.end());
+            auto const p1 = uv::accumulate<T>(policy, x.begin(), x.end());
+            REQUIRE(equal<T>(s1.variance, p1.variance, eps));
+
+            auto const s2 = uv::accumulate<T>(x.begin(), x.end(), w.begin());
+            auto const p2 = uv::accumulate<T>(policy, x.begin(), x.end(), w.begin());
+            REQUIRE(equal<T>(s2.variance, p2.variance, eps));
+
+            auto const s3 = bv::accumulate<T>(x.begin(), x.end(), y.begin());
+            auto const p3 = bv::accumulate<T>(policy, x.begin(), x.end(), y.begin());
+            REQUIRE(equal<T>(s3.covariance, p3.covariance, eps));
+
+            auto const s4 = bv::accumulate<T>(x.begin(), x.end(), y.begin(), w.begin());
+            auto const p4 = bv::accumulate<T>(policy, x.begin(), x.end(), y.begin(), w.begin());
+            REQUIRE(equal<T>(s4.covariance, p4.covariance, eps));
+
+            // the result must not depend on the thread schedule
+            auto const q1 = uv::accumulate<T>(policy, x.begin(), x.end());
+            REQUIRE(p1.ssr == q1.ssr);
+        };
+
+        SUBCASE("double") {
+            double const eps{1e-6};
+            SUBCASE("small") { test_parallel(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_parallel(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_parallel(count_large, eps); } // NOLINT
+        }
+
+        SUBCASE("float") {
+            float const eps{1e-5};
+            SUBCASE("small") { test_parallel.operator()<float>(count_small, eps); } // NOLINT
+            SUBCASE("medium") { test_parallel.operator()<float>(count_medium, eps); } // NOLINT
+            SUBCASE("large") { test_parallel.operator()<float>(count_large, eps); } // NOLINT
+        }
+    }
+
+    TEST_CASE("parallel benchmarks" * dt::test_suite("[performance]")) {
         std::random_device rng{};
 
+        auto const n{1 << 24};
+        auto xf = util::generate<float>(rng, n);
+        auto yf = util::generate<float>(rng, n);
+
         nb::Bench bench;
-        auto const n{1000};
-        for (auto s = n; s <= 1'024'000; s *= 2) {
-            // mean & weighted mean
+        bench.batch(n).unit("element").minEpochIterations(5);
+        double m{0.0};
+
+        for (auto t = 1U; t <= std::thread::hardware_concurrency(); t *= 2) {
+            vstat::parallel_policy const policy{ .threads = t };
+            bench.run("vstat;variance;float;" + std::to_string(t) + " threads", [&]() {
+                m += uv::accumulate<float>(policy, xf.begin(), xf.end()).variance;
+            });
+
+            bench.run("vstat;covariance;float;" + std::to_string(t) + " threads", [&]() {
+                m += bv::accumulate<float>(policy, xf.begin(), xf.end(), yf.begin()).covariance;
+            });
+        }
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("blocked benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+
+        nb::Bench bench;
+        bench.unit("element");
+        double m{0.0};
+
+        for (auto n : { 1'000, 100'000, 10'000'000 }) {
             auto xd = util::generate<double>(rng, n);
             auto yd = util::generate<double>(rng, n);
-            auto wd = util::generate<double>(rng, n);
+            auto xf = util::generate<float>(rng, n);
+            auto yf = util::generate<float>(rng, n);
+            bench.batch(n);
+
+            bench.run("vstat;variance;float;" + std::to_string(n), [&]() {
+                m += uv::accumulate<float>(xf.begin(), xf.end()).variance;
+            });
+
+            bench.run("vstat;variance (blocked);float;" + std::to_string(n), [&]() {
+                m += uv::accumulate_blocked<float>(xf.begin(), xf.end()).variance;
+            });
 
+            bench.run("vstat;variance;double;" + std::to_string(n), [&]() {
+                m += uv::accumulate<double>(xd.begin(), xd.end()).variance;
+            });
+
+            bench.run("vstat;variance (blocked);double;" + std::to_string(n), [&]() {
+                m += uv::accumulate_blocked<double>(xd.begin(), xd.end()).variance;
+            });
+
+            bench.run("vstat;covariance;float;" + std::to_string(n), [&]() {
+                m += bv::accumulate<float>(xf.begin(), xf.end(), yf.begin()).covariance;
+            });
+
+            bench.run("vstat;covariance (blocked);float;" + std::to_string(n), [&]() {
+                m += bv::accumulate_blocked<float>(xf.begin(), xf.end(), yf.begin()).covariance;
+            });
+
+            bench.run("vstat;covariance;double;" + std::to_string(n), [&]() {
+                m += bv::accumulate<double>(xd.begin(), xd.end(), yd.begin()).covariance;
+            });
+
+            bench.run("vstat;covariance (blocked);double;" + std::to_string(n), [&]() {
+                m += bv::accumulate_blocked<double>(xd.begin(), xd.end(), yd.begin()).covariance;
+            });
+        }
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("evaluate benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+        namespace mt = vstat::metrics;
+
+        nb::Bench bench;
+        bench.unit("element");
+        double m{0.0};
+
+        auto separate = [&]<typename T>(std::vector<T> const& x, std::vector<T> const& y) {
+            return mt::r2_score<T>(x.begin(), x.end(), y.begin())
+                + mt::mean_squared_error<T>(x.begin(), x.end(), y.begin())
+                + mt::mean_absolute_error<T>(x.begin(), x.end(), y.begin())
+                + mt::mean_absolute_percentage_error<T>(x.begin(), x.end(), y.begin())
+                + mt::poisson_neg_likelihood_loss<T>(x.begin(), x.end(), y.begin());
+        };
+
+        auto fused = [&]<typename T>(std::vector<T> const& x, std::vector<T> const& y) {
+            auto const r = mt::evaluate<T, mt::r2, mt::mse, mt::mae, mt::mape, mt::poisson>(x.begin(), x.end(), y.begin());
+            return std::accumulate(r.begin(), r.end(), 0.0);
+        };
+
+        for (auto n : { 1'000, 100'000, 10'000'000 }) {
+            auto xd = util::generate<double>(rng, n);
+            auto yd = util::generate<double>(rng, n);
             auto xf = util::generate<float>(rng, n);
             auto yf = util::generate<float>(rng, n);
-            auto wf = util::generate<float>(rng, n);
+            bench.batch(n);
+
+            bench.run("vstat;metrics (separate);float;" + std::to_string(n), [&]() { m += separate(xf, yf); });
+            bench.run("vstat;metrics (fused);float;" + std::to_string(n), [&]() { m += fused(xf, yf); });
+            bench.run("vstat;metrics (separate);double;" + std::to_string(n), [&]() { m += separate(xd, yd); });
+            bench.run("vstat;metrics (fused);double;" + std::to_string(n), [&]() { m += fused(xd, yd); });
+        }
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("multivariate benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+        namespace mv = vstat::multivariate;
+
+        nb::Bench bench;
+        bench.unit("element");
+        double m{0.0};
+
+        auto constexpr rows{ 100'000 };
+        for (auto dim : { 16, 64, 256 }) {
+            auto xd = util::generate<double>(rng, rows * dim);
+            auto xf = util::generate<float>(rng, rows * dim);
+            bench.batch(rows * dim);
+
+            bench.run("vstat;covariance matrix;float;" + std::to_string(dim), [&]() {
+                m += mv::accumulate(xf.data(), rows, dim, dim).covariance.back();
+            });
+
+            bench.run("vstat;covariance matrix;double;" + std::to_string(dim), [&]() {
+                m += mv::accumulate(xd.data(), rows, dim, dim).covariance.back();
+            });
+
+            // the same matrix computed with one bivariate pass per pair of columns
+            if (dim <= 64) {
+                bench.run("vstat;covariance matrix (pairwise);float;" + std::to_string(dim), [&]() {
+                    for (auto i = 0; i < dim; ++i) {
+                        vstat::strided_iterator<float const> xi{ xf.data() + i, dim };
+                        for (auto j = i; j < dim; ++j) {
+                            vstat::strided_iterator<float const> xj{ xf.data() + j, dim };
+                            m += bv::accumulate<float>(xi, xi + rows, xj).covariance;
+                        }
+                    }
+                });
+            }
+        }
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("serialize benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+
+        nb::Bench bench;
+        bench.unit("partial");
+        std::size_t m{0};
+
+        auto run = [&]<typename T>(std::string const& type) {
+            using wide = eve::wide<T>;
+            auto x = util::generate<T>(rng, count_medium);
+            univariate_accumulator<wide> ua;
+            bivariate_accumulator<wide> ba;
+            for (auto i = 0; i + wide::size() <= count_medium; i += wide::size()) {
+                ua(x.data() + i);
+                ba(x.data() + i, x.data() + i);
+            }
+
+            std::vector<std::byte> buffer(serialized_size(ba));
+            bench.run("vstat;serialize+merge;univariate;" + type, [&]() {
+                univariate_accumulator<wide> acc;
+                m += merge_serialized(acc, std::span{buffer}.first(serialize(ua, buffer)));
+            });
+            bench.run("vstat;serialize+merge (reduced);univariate;" + type, [&]() {
+                univariate_accumulator<wide> acc;
+                m += merge_serialized(acc, std::span{buffer}.first(serialize_reduced(ua, buffer)));
+            });
+            bench.run("vstat;serialize+merge;bivariate;" + type, [&]() {
+                bivariate_accumulator<wide> acc;
+                m += merge_serialized(acc, std::span{buffer}.first(serialize(ba, buffer)));
+            });
+            bench.run("vstat;serialize+merge (reduced);bivariate;" + type, [&]() {
+                bivariate_accumulator<wide> acc;
+                m += merge_serialized(acc, std::span{buffer}.first(serialize_reduced(ba, buffer)));
+            });
+        };
+        run.operator()<float>("float");
+        run.operator()<double>("double");
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("compensated benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+
+        nb::Bench bench;
+        bench.unit("element");
+        double m{0.0};
+
+        auto constexpr n{ 10'000'000 };
+        auto xf = util::generate<float>(rng, n, 100.F, 101.F);
+        std::vector<double> xd(xf.begin(), xf.end());
+        auto const ref = uv::accumulate<double>(xd.begin(), xd.end());
+        bench.batch(n);
+
+        auto run = [&]<typename W, typename S = plain_summation>(std::string const& name, auto const& x) {
+            univariate_statistics stats{ univariate_accumulator<double>{} };
+            bench.run("vstat;update;" + name, [&]() {
+                univariate_accumulator<W, S> acc;
+                uv::update(acc, x.begin(), x.end());
+                stats = univariate_statistics(acc);
+                m += stats.variance;
+            });
+            std::cout << name << ": mean error " << std::abs(stats.mean - ref.mean) / ref.mean
+                      << ", variance error " << std::abs(stats.variance - ref.variance) / ref.variance << "\n";
+        };
+        run.operator()<eve::wide<float>>("float", xf);
+        run.operator()<eve::wide<float>, compensated_summation>("float (compensated)", xf);
+        run.operator()<eve::wide<double>>("double", xd);
+        run.operator()<eve::wide<double>, compensated_summation>("double (compensated)", xd);
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("mixed precision benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+
+        nb::Bench bench;
+        bench.unit("element");
+        double m{0.0};
+
+        auto constexpr n{ 1'000'000 };
+        auto xf = util::generate<float>(rng, n);
+        std::vector<std::int16_t> xs(n);
+        std::uniform_int_distribution<int> dist(-30'000, 30'000);
+        std::generate(xs.begin(), xs.end(), [&]() { return static_cast<std::int16_t>(dist(rng)); });
+        auto widen = [](auto v) { return static_cast<double>(v); };
+        bench.batch(n);
+
+        bench.run("vstat;float;float", [&]() { m += uv::accumulate<float>(xf.begin(), xf.end()).variance; });
+        bench.run("vstat;float;double (converting load)", [&]() { m += uv::accumulate<double>(xf.begin(), xf.end()).variance; });
+        bench.run("vstat;float;double (gather)", [&]() { m += uv::accumulate<double>(xf.begin(), xf.end(), widen).variance; });
+        bench.run("vstat;int16;float (converting load)", [&]() { m += uv::accumulate<float>(xs.begin(), xs.end()).variance; });
+        bench.run("vstat;int16;double (converting load)", [&]() { m += uv::accumulate<double>(xs.begin(), xs.end()).variance; });
+        bench.run("vstat;int16;double (gather)", [&]() { m += uv::accumulate<double>(xs.begin(), xs.end(), widen).variance; });
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("skip nan benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+
+        nb::Bench bench;
+        bench.unit("element");
+        double m{0.0};
+
+        auto constexpr n{ 1'000'000 };
+        for (auto fraction : { 0.0, 0.01, 0.1 }) {
+            auto x = util::generate<float>(rng, n);
+            std::bernoulli_distribution hole(fraction);
+            std::replace_if(x.begin(), x.end(), [&](auto) { return hole(rng); }, std::numeric_limits<float>::quiet_NaN());
+            auto const suffix = ";" + std::to_string(fraction);
+            bench.batch(n);
+
+            bench.run("vstat;skip nan" + suffix, [&]() {
+                m += uv::accumulate<float>(skip_nan, x.begin(), x.end()).variance;
+            });
+            bench.run("vstat;filter + accumulate" + suffix, [&]() {
+                std::vector<float> y;
+                std::copy_if(x.begin(), x.end(), std::back_inserter(y), [](auto v) { return !std::isnan(v); });
+                m += uv::accumulate<float>(y.begin(), y.end()).variance;
+            });
+            bench.run("vstat;accumulate (no nan handling)" + suffix, [&]() {
+                m += uv::accumulate<float>(x.begin(), x.end()).variance;
+            });
+        }
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("moments benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+
+        nb::Bench bench;
+        bench.unit("element");
+        double m{0.0};
+
+        auto constexpr n{ 1'000'000 };
+        auto xf = util::generate<float>(rng, n);
+        auto xd = util::generate<double>(rng, n);
+        bench.batch(n);
+
+        auto two_pass = [](auto const& x) {
+            double mean{0};
+            for (auto v : x) { mean += v; }
+            mean /= static_cast<double>(x.size());
+            double m2{0};
+            double m3{0};
+            double m4{0};
+            for (auto v : x) {
+                double const d = v - mean;
+                double const d2 = d * d;
+                m2 += d2;
+                m3 += d2 * d;
+                m4 += d2 * d2;
+            }
+            return m3 / std::pow(m2, 1.5) + m4 / (m2 * m2);
+        };
+
+        bench.run("vstat;float;variance", [&]() { m += uv::accumulate<float>(xf.begin(), xf.end()).variance; });
+        bench.run("vstat;float;moments", [&]() { m += uv::accumulate_moments<float>(xf.begin(), xf.end()).kurtosis; });
+        bench.run("two-pass;float;moments", [&]() { m += two_pass(xf); });
+        bench.run("vstat;double;variance", [&]() { m += uv::accumulate<double>(xd.begin(), xd.end()).variance; });
+        bench.run("vstat;double;moments", [&]() { m += uv::accumulate_moments<double>(xd.begin(), xd.end()).kurtosis; });
+        bench.run("two-pass;double;moments", [&]() { m += two_pass(xd); });
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("extrema benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+
+        nb::Bench bench;
+        bench.unit("element");
+        double m{0.0};
+
+        auto constexpr n{ 1'000'000 };
+        auto x = util::generate<float>(rng, n);
+        bench.batch(n);
+
+        bench.run("vstat;accumulate", [&]() { m += uv::accumulate<float>(x.begin(), x.end()).variance; });
+        bench.run("vstat;accumulate (with extrema)", [&]() {
+            auto const s = uv::accumulate<float>(with_extrema, x.begin(), x.end());
+            m += s.variance + s.max;
+        });
+        bench.run("vstat;accumulate + minmax_element", [&]() {
+            auto const [lo, hi] = std::minmax_element(x.begin(), x.end());
+            m += uv::accumulate<float>(x.begin(), x.end()).variance + *hi;
+        });
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("quantile sketch benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+
+        nb::Bench bench;
+        bench.unit("element");
+        double m{0.0};
+
+        for (auto n : { count_medium, count_large }) {
+            auto x = util::generate<double>(rng, n);
+            auto const suffix = ";" + std::to_string(n);
+            bench.batch(n);
+
+            bench.run("vstat;sketch insertion" + suffix, [&]() {
+                quantile_sketch<double> sketch;
+                for (auto i = 0; i + eve::wide<double>::size() <= n; i += eve::wide<double>::size()) {
+                    sketch(eve::wide<double>{x.data() + i});
+                }
+                m += sketch.quantile(0.99);
+            });
+            bench.run("vstat;accumulate + sketch" + suffix, [&]() {
+                quantile_sketch<double> sketch;
+                m += uv::accumulate<double>(sketch, x.begin(), x.end()).variance;
+                m += sketch.quantile(0.99);
+            });
+            bench.run("std::nth_element (p50, p95, p99)" + suffix, [&]() {
+                std::vector<double> y(x);
+                for (auto q : { 0.5, 0.95, 0.99 }) {
+                    auto const it = y.begin() + static_cast<std::ptrdiff_t>(q * (n - 1));
+                    std::nth_element(y.begin(), it, y.end());
+                    m += *it;
+                }
+            });
+        }
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("histogram benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+
+        nb::Bench bench;
+        bench.unit("element");
+        double m{0.0};
+        auto const bins = histogram_bins::uniform(0, 1, 64);
+
+        for (auto n : { count_medium, count_large }) {
+            auto x = util::generate<double>(rng, n, 0.0, 1.0);
+            auto const suffix = ";" + std::to_string(n);
+            bench.batch(n);
+
+            bench.run("vstat;histogram" + suffix, [&]() {
+                histogram_accumulator<double> hist(bins);
+                for (auto i = 0; i + eve::wide<double>::size() <= n; i += eve::wide<double>::size()) {
+                    hist(eve::wide<double>{x.data() + i});
+                }
+                m += static_cast<double>(hist.counts()[bins.count / 2]);
+            });
+            bench.run("vstat;accumulate + histogram" + suffix, [&]() {
+                histogram_accumulator<double> hist(bins);
+                m += uv::accumulate<double>(hist, x.begin(), x.end()).variance;
+                m += static_cast<double>(hist.counts()[bins.count / 2]);
+            });
+            bench.run("scalar binning" + suffix, [&]() {
+                std::vector<std::uint64_t> counts(bins.count, 0);
+                auto const scale = static_cast<double>(bins.count) / (bins.max - bins.min);
+                for (auto v : x) {
+                    auto const b = std::clamp(std::floor((v - bins.min) * scale), 0.0, static_cast<double>(bins.count - 1));
+                    ++counts[static_cast<std::size_t>(b)];
+                }
+                m += static_cast<double>(counts[bins.count / 2]);
+            });
+        }
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("ewma benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+
+        nb::Bench bench;
+        bench.unit("element");
+        double m{0.0};
+        auto constexpr alpha{0.05};
+
+        for (auto n : { count_medium, count_large }) {
+            auto x = util::generate<double>(rng, n);
+            std::vector<double> mean(n);
+            std::vector<double> variance(n);
+            auto const suffix = ";" + std::to_string(n);
+            bench.batch(n);
+
+            bench.run("vstat;ewma" + suffix, [&]() {
+                ewma_accumulator<double> acc(alpha);
+                uv::update(acc, x.begin(), x.end());
+                m += acc.variance();
+            });
+            bench.run("vstat;ewma series" + suffix, [&]() {
+                ewma_accumulator<double> acc(alpha);
+                uv::update(acc, x.begin(), x.end(), mean.begin(), variance.begin());
+                m += variance.back();
+            });
+            bench.run("scalar recurrence" + suffix, [&]() {
+                double mu{x[0]};
+                double var{0};
+                for (auto v : x) {
+                    auto const d = v - mu;
+                    mu += alpha * d;
+                    var = (1 - alpha) * (var + alpha * d * d);
+                }
+                m += var;
+            });
+        }
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("rolling benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+
+        nb::Bench bench;
+        bench.unit("element");
+        double m{0.0};
+
+        auto x = util::generate<double>(rng, count_large);
+        auto y = util::generate<double>(rng, count_large);
+        std::vector<double> a(count_large);
+        std::vector<double> b(count_large);
+        bench.batch(count_large);
+
+        for (auto window : { 10, 1000 }) {
+            auto const suffix = ";" + std::to_string(window);
+            bench.run("vstat;rolling variance" + suffix, [&]() {
+                uv::rolling<double>(x.begin(), x.end(), window, a.begin(), b.begin());
+                m += b.back();
+            });
+            bench.run("vstat;rolling correlation" + suffix, [&]() {
+                bv::rolling<double>(x.begin(), x.end(), y.begin(), window, a.begin(), b.begin());
+                m += b.back();
+            });
+            bench.run("vstat;accumulate per window" + suffix, [&]() {
+                for (auto i = window; i <= count_large; ++i) {
+                    b[i - 1] = uv::accumulate<double>(x.begin() + (i - window), x.begin() + i).variance;
+                }
+                m += b.back();
+            });
+        }
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("grouped benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+
+        nb::Bench bench;
+        bench.unit("element");
+        double m{0.0};
+
+        auto const n{ count_large * 10 };
+        auto x = util::generate<double>(rng, n);
+        bench.batch(n);
+
+        for (std::size_t groups : { 10, 100'000 }) {
+            std::uniform_int_distribution<std::int64_t> dist(0, static_cast<std::int64_t>(groups) - 1);
+            std::vector<std::int64_t> keys(n);
+            std::ranges::generate(keys, [&]() { return dist(rng); });
+            auto sorted = keys;
+            std::ranges::sort(sorted);
+            auto const suffix = ";" + std::to_string(groups);
+
+            bench.run("vstat;grouped unsorted" + suffix, [&]() {
+                m += gr::accumulate<double>(x.begin(), x.end(), keys.begin(), groups).sum_xx.front();
+            });
+            bench.run("vstat;grouped sorted" + suffix, [&]() {
+                m += gr::accumulate<double>(x.begin(), x.end(), sorted.begin(), groups).sum_xx.front();
+            });
+            bench.run("vstat;grouped unsorted parallel" + suffix, [&]() {
+                m += gr::accumulate<double>(parallel_policy{}, x.begin(), x.end(), keys.begin(), groups).sum_xx.front();
+            });
+            bench.run("scalar two-pass" + suffix, [&]() {
+                std::vector<double> count(groups);
+                std::vector<double> sum(groups);
+                std::vector<double> ssr(groups);
+                for (auto i = 0; i < n; ++i) { count[keys[i]] += 1; sum[keys[i]] += x[i]; }
+                for (auto i = 0; i < n; ++i) { auto const d = x[i] - sum[keys[i]] / count[keys[i]]; ssr[keys[i]] += d * d; }
+                m += ssr.front();
+            });
+        }
+        nb::doNotOptimizeAway(m);
+    }
+
+    TEST_CASE("benchmarks" * dt::test_suite("[performance]")) {
+        std::random_device rng{};
+
+        nb::Bench bench;
+        for (auto s = 1000; s <= 1'024'000; s *= 2) {
+            // mean & weighted mean
+            auto xd = util::generate<double>(rng, s);
+            auto yd = util::generate<double>(rng, s);
+            auto wd = util::generate<double>(rng, s);
+
+            auto xf = util::generate<float>(rng, s);
+            auto yf = util::generate<float>(rng, s);
+            auto wf = util::generate<float>(rng, s);
 
             double m{0.0};
 
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright 2019-2024 Heal Research
+
+// Prints the statistics of the columns of a CSV file, computed in a single pass.
+//
+// usage: vstat_csv [--delimiter C] [--no-header] [--float] [--block-size N] [--columns LIST] [--pairs LIST] [FILE]
+//
+// The file is read from stdin if FILE is missing or "-". LIST is a comma-separated list of column names (or
+// zero-based indices with --no-header), the pairs are written as "a:b". Without --columns and --pairs, the
+// statistics of every column are printed. The values are parsed and accumulated as doubles, or as floats with
+// --float. The number of missing values (empty fields and fields that are not numbers) is printed as "skipped".
+
+#include <concepts>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "vstat/csv.hpp"
+
+namespace {
+struct options {
+    vstat::csv_options csv;
+    bool single_precision{ false };
+    std::vector<std::string> columns;
+    std::vector<std::pair<std::string, std::string>> pairs;
+    std::string file{ "-" };
+};
+
+auto split(std::string_view list, char delimiter) -> std::vector<std::string>
+{
+    std::vector<std::string> items;
+    for (auto pos = list.find(delimiter); pos != std::string_view::npos; pos = list.find(delimiter)) {
+        items.emplace_back(list.substr(0, pos));
+        list.remove_prefix(pos + 1);
+    }
+    items.emplace_back(list);
+    return items;
+}
+
+auto parse(int argc, char** argv) -> options
+{
+    options opt;
+    auto usage = [&]() {
+        std::cerr << "usage: " << argv[0] << " [--delimiter C] [--no-header] [--float] [--block-size N] [--columns LIST] [--pairs LIST] [FILE]\n";
+        std::exit(EXIT_FAILURE); // NOLINT
+    };
+    for (auto i = 1; i < argc; ++i) {
+        std::string_view const arg{ argv[i] }; // NOLINT
+        if (arg == "--no-header") {
+            opt.csv.header = false;
+            continue;
+        }
+        if (arg == "--float") {
+            opt.single_precision = true;
+            continue;
+        }
+        if (!arg.starts_with("--") || arg == "-") {
+            opt.file = arg;
+            continue;
+        }
+        if (i + 1 == argc) {
+            usage();
+        }
+        std::string const value{ argv[++i] }; // NOLINT
+        if (arg == "--delimiter" && value.size() == 1) {
+            opt.csv.delimiter = value.front();
+        } else if (arg == "--delimiter" && value == "\\t") {
+            opt.csv.delimiter = '\t';
+        } else if (arg == "--block-size") {
+            opt.csv.block_size = std::stoul(value);
+        } else if (arg == "--columns") {
+            opt.columns = split(value, ',');
+        } else if (arg == "--pairs") {
+            for (auto const& pair : split(value, ',')) {
+                auto const items = split(pair, ':');
+                if (items.size() != 2) {
+                    usage();
+                }
+                opt.pairs.emplace_back(items[0], items[1]);
+            }
+        } else {
+            usage();
+        }
+    }
+    return opt;
+}
+
+template<std::floating_point T>
+auto accumulate(std::istream& in, options const& opt) -> vstat::csv_statistics
+{
+    if (opt.columns.empty() && opt.pairs.empty()) {
+        return vstat::csv::accumulate<T>(in, opt.csv);
+    }
+    if (opt.csv.header) {
+        return vstat::csv::accumulate<T>(in, opt.columns, opt.pairs, opt.csv);
+    }
+    std::vector<std::size_t> columns;
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    for (auto const& c : opt.columns) {
+        columns.push_back(std::stoul(c));
+    }
+    for (auto const& [a, b] : opt.pairs) {
+        pairs.emplace_back(std::stoul(a), std::stoul(b));
+    }
+    return vstat::csv::accumulate<T>(in, columns, pairs, opt.csv);
+}
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    auto const opt = parse(argc, argv);
+    try {
+        std::ifstream file;
+        if (opt.file != "-") {
+            file.open(opt.file, std::ios::binary);
+            if (!file) {
+                std::cerr << "cannot open " << opt.file << "\n";
+                return EXIT_FAILURE;
+            }
+        }
+        auto& in = opt.file == "-" ? std::cin : file;
+        auto const result = opt.single_precision ? accumulate<float>(in, opt) : accumulate<double>(in, opt);
+
+        // the names of the selected columns, in selection order
+        std::vector<std::string> names = opt.columns;
+        if (opt.columns.empty() && opt.pairs.empty()) {
+            for (std::size_t i = 0; i < result.univariate.size(); ++i) {
+                names.push_back(opt.csv.header ? result.names[i] : std::to_string(i));
+            }
+        }
+
+        std::cout << "rows:           \t" << result.rows << "\n";
+        for (std::size_t i = 0; i < result.univariate.size(); ++i) {
+            std::cout << "\n== " << names[i] << "\n" << result.univariate[i]
+                      << "skipped:        \t" << result.univariate[i].skipped << "\n";
+        }
+        for (std::size_t i = 0; i < result.bivariate.size(); ++i) {
+            std::cout << "\n== " << opt.pairs[i].first << " : " << opt.pairs[i].second << "\n" << result.bivariate[i]
+                      << "skipped:            \t" << result.bivariate[i].skipped << "\n";
+        }
+    } catch (std::exception const& e) {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}